@@ -0,0 +1,41 @@
+/*
+ * Binary allocation trace format
+ *
+ * Written by the trace_shim.c interposition library and read by
+ * trace_replay.c. A trace is an AllocTraceHeader followed by fixed-size
+ * AllocTraceRecord entries until end of file, in the order the calls
+ * completed. Object ids are the addresses returned in the traced process;
+ * the replay tool maps them onto dense slots, so an id may be reused once
+ * its previous object has been freed.
+ */
+
+#ifndef ALLOC_TRACE_H
+#define ALLOC_TRACE_H
+
+#include <stdint.h>
+
+#define ALLOC_TRACE_MAGIC   "SMATRACE"
+#define ALLOC_TRACE_VERSION 1
+
+// Record operations (realloc is recorded as a free followed by an alloc)
+#define ALLOC_TRACE_OP_ALLOC 1
+#define ALLOC_TRACE_OP_FREE  2
+
+typedef struct {
+    char magic[8];         // ALLOC_TRACE_MAGIC, not NUL-terminated
+    uint32_t version;      // ALLOC_TRACE_VERSION
+    uint32_t record_size;  // sizeof(AllocTraceRecord), guards against layout drift
+} AllocTraceHeader;
+
+typedef struct {
+    uint64_t id;             // Object address in the traced process
+    uint64_t timestamp_ns;   // Monotonic time since the trace started
+    uint32_t size;           // Requested bytes (0 for frees)
+    uint8_t op;              // ALLOC_TRACE_OP_*
+    uint8_t alignment_log2;  // Requested alignment as a power of two (0 for frees)
+    uint16_t thread;         // Dense per-process thread index, in order of first call
+} AllocTraceRecord;
+
+_Static_assert(sizeof(AllocTraceRecord) == 24, "trace records must stay 24 bytes");
+
+#endif
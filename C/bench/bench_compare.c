@@ -0,0 +1,834 @@
+/*
+ * Comparative allocator benchmark suite
+ *
+ * Runs the allocators in src/ and the C library's malloc through the same
+ * workloads, plus jemalloc, mimalloc and tcmalloc when their shared
+ * libraries can be loaded. They are opened with dlopen() and called through
+ * their own symbols, so none of them is a build dependency and the process
+ * malloc stays the C library's.
+ *
+ *   single  - one thread allocating batches of fixed-size objects and
+ *             releasing each batch the way the allocator releases memory
+ *             (free, rewind to a marker, or reset)
+ *   mixed   - one thread keeping a table of live objects of random sizes
+ *             and replacing a random one per operation (allocators that
+ *             free individual objects)
+ *   threads - every thread running the single workload against one shared
+ *             instance or its own per-thread front end
+ *
+ * Every object is written once so lazily mapped memory is paid for. Results
+ * print as a table and, with --json / --csv, as records tagged with the
+ * CPU, kernel, compiler and flags so dashboards can track them across runs.
+ */
+
+#define _GNU_SOURCE  // Required for dlopen, pthread barriers and clock_gettime
+
+#include <dlfcn.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/utsname.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef __GLIBC__
+#include <gnu/libc-version.h>
+#endif
+#include "../src/simple_memory_allocator.h"
+#include "../src/pool_allocator.h"
+#include "../src/freelist_allocator.h"
+#include "../src/size_class_allocator.h"
+#include "../src/concurrent_memory_allocator.h"
+#include "../src/thread_cache_allocator.h"
+#include "../src/concurrent_pool_allocator.h"
+#include "../src/owned_pool_allocator.h"
+
+// Compiler flags recorded in the results (the Makefile passes the real ones)
+#ifndef BENCH_CFLAGS
+#define BENCH_CFLAGS "unknown"
+#endif
+
+#define BATCH          1024     // Live objects per batch in the single and threads workloads
+#define OBJECT_SIZE    64
+#define MIXED_SLOTS    4096     // Live objects in the mixed workload
+#define MIXED_MIN_SIZE 16
+#define MIXED_MAX_SIZE 512
+#define MAX_THREADS    64
+#define MAX_RESULTS    128
+#define MAX_HEAPS      4
+#define ARENA_THREAD_BYTES ((size_t)64 * 1024 * 1024)  // Cap per thread for the alloc-only arena runs
+
+typedef struct {
+    const char *workload;
+    const char *allocator;  // Static names or heaps[].name, both outlive the results
+    int threads;
+    size_t size;     // Object size, 0 for mixed sizes
+    size_t ops;      // Allocations, each paired with a release
+    double seconds;
+} BenchResult;
+
+static BenchResult results[MAX_RESULTS];
+static size_t result_count;
+
+static void *volatile sink;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Record one result and print its table row
+static void record(const char *workload, const char *allocator, int threads, size_t size, size_t ops,
+                   double seconds) {
+    if (result_count == MAX_RESULTS) {
+        return;
+    }
+    BenchResult *r = &results[result_count++];
+    r->workload = workload;
+    r->allocator = allocator;
+    r->threads = threads;
+    r->size = size;
+    r->ops = ops;
+    r->seconds = seconds;
+    printf("  %-30s %8d %14.2fM %10.2f\n", allocator, threads, (double)ops / seconds / 1e6,
+           seconds * 1e9 / (double)ops);
+}
+
+static void print_header(const char *title) {
+    printf("\n▸ %s\n", title);
+    printf("  %-30s %8s %15s %10s\n", "Allocator", "Threads", "Ops/s", "ns/op");
+    printf("  ─────────────────────────────────────────────────────────────────\n");
+}
+
+// ─── malloc-compatible heaps ────────────────────────────────────────────────
+
+typedef struct {
+    char name[32];
+    void *(*malloc_fn)(size_t);
+    void (*free_fn)(void *);
+    void *handle;  // dlopen() handle, NULL for the C library
+} Heap;
+
+typedef struct {
+    const char *name;
+    const char *libraries[3];
+    const char *malloc_symbol;
+    const char *free_symbol;
+} ExternalHeap;
+
+// Prefixed entry points where the library has them; jemalloc only exports
+// the standard names, which dlsym() resolves inside the library itself
+static const ExternalHeap external_heaps[] = {
+    {"jemalloc", {"libjemalloc.so.2", "libjemalloc.so", NULL}, "malloc", "free"},
+    {"mimalloc", {"libmimalloc.so.2", "libmimalloc.so", NULL}, "mi_malloc", "mi_free"},
+    {"tcmalloc", {"libtcmalloc_minimal.so.4", "libtcmalloc.so.4", NULL}, "tc_malloc", "tc_free"},
+};
+
+#define EXTERNAL_HEAP_COUNT (sizeof(external_heaps) / sizeof(external_heaps[0]))
+
+static Heap heaps[MAX_HEAPS];
+static size_t heap_count;
+static char missing_heaps[128];
+
+// The C library's malloc, then every external allocator that loads
+static void load_heaps(void) {
+    snprintf(heaps[0].name, sizeof(heaps[0].name), "malloc (libc)");
+    heaps[0].malloc_fn = malloc;
+    heaps[0].free_fn = free;
+    heaps[0].handle = NULL;
+    heap_count = 1;
+
+    for (size_t i = 0; i < EXTERNAL_HEAP_COUNT; i++) {
+        const ExternalHeap *ext = &external_heaps[i];
+        void *handle = NULL;
+        for (size_t j = 0; handle == NULL && ext->libraries[j] != NULL; j++) {
+            handle = dlopen(ext->libraries[j], RTLD_NOW | RTLD_LOCAL);
+        }
+        void *malloc_fn = handle != NULL ? dlsym(handle, ext->malloc_symbol) : NULL;
+        void *free_fn = handle != NULL ? dlsym(handle, ext->free_symbol) : NULL;
+        if (malloc_fn == NULL || free_fn == NULL) {
+            if (handle != NULL) {
+                dlclose(handle);
+            }
+            size_t len = strlen(missing_heaps);
+            snprintf(missing_heaps + len, sizeof(missing_heaps) - len, "%s%s", len != 0 ? ", " : "", ext->name);
+            continue;
+        }
+
+        Heap *heap = &heaps[heap_count++];
+        snprintf(heap->name, sizeof(heap->name), "%s", ext->name);
+        // POSIX guarantees function pointers survive the round trip through void *
+        memcpy(&heap->malloc_fn, &malloc_fn, sizeof(malloc_fn));
+        memcpy(&heap->free_fn, &free_fn, sizeof(free_fn));
+        heap->handle = handle;
+    }
+}
+
+static void unload_heaps(void) {
+    for (size_t i = 0; i < heap_count; i++) {
+        if (heaps[i].handle != NULL) {
+            dlclose(heaps[i].handle);
+        }
+    }
+}
+
+// ─── single: batches of fixed-size objects ──────────────────────────────────
+
+static double single_heap(const Heap *heap, size_t rounds) {
+    void *ptrs[BATCH];
+    double start = now_seconds();
+    for (size_t r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < BATCH; i++) {
+            ptrs[i] = heap->malloc_fn(OBJECT_SIZE);
+            *(volatile char *)ptrs[i] = (char)i;
+        }
+        for (size_t i = 0; i < BATCH; i++) {
+            heap->free_fn(ptrs[i]);
+        }
+    }
+    return now_seconds() - start;
+}
+
+static double single_bump(size_t rounds) {
+    SimpleMemoryAllocator arena;
+    simple_memory_allocator_init(&arena);
+    simple_memory_allocator_create(&arena, BATCH * OBJECT_SIZE);
+    double start = now_seconds();
+    for (size_t r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < BATCH; i++) {
+            char *ptr = simple_memory_allocator_alloc(&arena, OBJECT_SIZE);
+            *(volatile char *)ptr = (char)i;
+        }
+        simple_memory_allocator_reset(&arena);
+    }
+    double elapsed = now_seconds() - start;
+    simple_memory_allocator_destroy(&arena);
+    return elapsed;
+}
+
+// Stack discipline: a marker per batch, rewound when the batch ends
+static double single_stack(size_t rounds) {
+    SimpleMemoryAllocator arena;
+    simple_memory_allocator_init(&arena);
+    simple_memory_allocator_create(&arena, 2 * BATCH * OBJECT_SIZE);
+    sink = simple_memory_allocator_alloc(&arena, OBJECT_SIZE);  // Long-lived frame below the markers
+    double start = now_seconds();
+    for (size_t r = 0; r < rounds; r++) {
+        SimpleMemoryMarker marker = simple_memory_allocator_get_marker(&arena);
+        for (size_t i = 0; i < BATCH; i++) {
+            char *ptr = simple_memory_allocator_alloc(&arena, OBJECT_SIZE);
+            *(volatile char *)ptr = (char)i;
+        }
+        simple_memory_allocator_free_to_marker(&arena, marker);
+    }
+    double elapsed = now_seconds() - start;
+    simple_memory_allocator_destroy(&arena);
+    return elapsed;
+}
+
+static double single_pool(size_t rounds) {
+    PoolAllocator pool;
+    pool_allocator_init(&pool);
+    pool_allocator_create(&pool, OBJECT_SIZE, BATCH);
+    void *ptrs[BATCH];
+    double start = now_seconds();
+    for (size_t r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < BATCH; i++) {
+            ptrs[i] = pool_allocator_alloc(&pool);
+            *(volatile char *)ptrs[i] = (char)i;
+        }
+        for (size_t i = 0; i < BATCH; i++) {
+            pool_allocator_free(&pool, ptrs[i]);
+        }
+    }
+    double elapsed = now_seconds() - start;
+    pool_allocator_destroy(&pool);
+    return elapsed;
+}
+
+static double single_freelist(size_t rounds) {
+    size_t bytes = 4 * BATCH * OBJECT_SIZE;
+    void *memory = malloc(bytes);
+    FreeListAllocator list;
+    freelist_init(&list, memory, bytes);
+    void *ptrs[BATCH];
+    double start = now_seconds();
+    for (size_t r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < BATCH; i++) {
+            ptrs[i] = freelist_alloc(&list, OBJECT_SIZE);
+            *(volatile char *)ptrs[i] = (char)i;
+        }
+        for (size_t i = 0; i < BATCH; i++) {
+            freelist_free(&list, ptrs[i]);
+        }
+    }
+    double elapsed = now_seconds() - start;
+    free(memory);
+    return elapsed;
+}
+
+static double single_size_class(size_t rounds) {
+    SizeClassAllocator classes;
+    size_class_allocator_init(&classes);
+    size_class_allocator_create(&classes, 2 * BATCH * OBJECT_SIZE, BATCH * OBJECT_SIZE);
+    void *ptrs[BATCH];
+    double start = now_seconds();
+    for (size_t r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < BATCH; i++) {
+            ptrs[i] = size_class_allocator_alloc(&classes, OBJECT_SIZE);
+            *(volatile char *)ptrs[i] = (char)i;
+        }
+        for (size_t i = 0; i < BATCH; i++) {
+            size_class_allocator_free(&classes, ptrs[i]);
+        }
+    }
+    double elapsed = now_seconds() - start;
+    size_class_allocator_destroy(&classes);
+    return elapsed;
+}
+
+static double single_concurrent_arena(size_t rounds) {
+    ConcurrentMemoryAllocator arena;
+    concurrent_memory_allocator_init(&arena);
+    concurrent_memory_allocator_create(&arena, BATCH * OBJECT_SIZE);
+    double start = now_seconds();
+    for (size_t r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < BATCH; i++) {
+            char *ptr = concurrent_memory_allocator_alloc(&arena, OBJECT_SIZE);
+            *(volatile char *)ptr = (char)i;
+        }
+        concurrent_memory_allocator_reset(&arena);
+    }
+    double elapsed = now_seconds() - start;
+    concurrent_memory_allocator_destroy(&arena);
+    return elapsed;
+}
+
+static double single_concurrent_pool(size_t rounds) {
+    ConcurrentPoolAllocator pool;
+    concurrent_pool_allocator_init(&pool);
+    concurrent_pool_allocator_create(&pool, OBJECT_SIZE, BATCH);
+    void *ptrs[BATCH];
+    double start = now_seconds();
+    for (size_t r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < BATCH; i++) {
+            ptrs[i] = concurrent_pool_allocator_alloc(&pool);
+            *(volatile char *)ptrs[i] = (char)i;
+        }
+        for (size_t i = 0; i < BATCH; i++) {
+            concurrent_pool_allocator_free(&pool, ptrs[i]);
+        }
+    }
+    double elapsed = now_seconds() - start;
+    concurrent_pool_allocator_destroy(&pool);
+    return elapsed;
+}
+
+static void run_single(size_t ops) {
+    size_t rounds = ops / BATCH;
+    ops = rounds * BATCH;
+    print_header("single: batches of 64-byte objects, one thread");
+    for (size_t i = 0; i < heap_count; i++) {
+        record("single", heaps[i].name, 1, OBJECT_SIZE, ops, single_heap(&heaps[i], rounds));
+    }
+    record("single", "bump (reset)", 1, OBJECT_SIZE, ops, single_bump(rounds));
+    record("single", "stack (marker rewind)", 1, OBJECT_SIZE, ops, single_stack(rounds));
+    record("single", "pool", 1, OBJECT_SIZE, ops, single_pool(rounds));
+    record("single", "free-list", 1, OBJECT_SIZE, ops, single_freelist(rounds));
+    record("single", "size-class", 1, OBJECT_SIZE, ops, single_size_class(rounds));
+    record("single", "concurrent arena (reset)", 1, OBJECT_SIZE, ops, single_concurrent_arena(rounds));
+    record("single", "lock-free pool", 1, OBJECT_SIZE, ops, single_concurrent_pool(rounds));
+}
+
+// ─── mixed: random sizes and lifetimes ──────────────────────────────────────
+
+static inline uint64_t xorshift(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return *state = x;
+}
+
+// Same operation sequence for every allocator: slot to replace and new size
+#define MIXED_NEXT(rng, slot, size)                                                            \
+    do {                                                                                       \
+        uint64_t bits = xorshift(rng);                                                         \
+        (slot) = (size_t)(bits % MIXED_SLOTS);                                                 \
+        (size) = MIXED_MIN_SIZE + (size_t)((bits >> 32) % (MIXED_MAX_SIZE - MIXED_MIN_SIZE + 1)); \
+    } while (0)
+
+static double mixed_heap(const Heap *heap, size_t ops) {
+    static void *slots[MIXED_SLOTS];
+    memset(slots, 0, sizeof(slots));
+    uint64_t rng = 0x9E3779B97F4A7C15ull;
+    double start = now_seconds();
+    for (size_t i = 0; i < ops; i++) {
+        size_t slot, size;
+        MIXED_NEXT(&rng, slot, size);
+        heap->free_fn(slots[slot]);
+        slots[slot] = heap->malloc_fn(size);
+        *(volatile char *)slots[slot] = (char)i;
+    }
+    double elapsed = now_seconds() - start;
+    for (size_t i = 0; i < MIXED_SLOTS; i++) {
+        heap->free_fn(slots[i]);
+    }
+    return elapsed;
+}
+
+// Worst case every slot holds MIXED_MAX_SIZE bytes plus per-block overhead
+#define MIXED_HEAP_BYTES ((size_t)MIXED_SLOTS * (MIXED_MAX_SIZE + 64) * 2)
+
+static double mixed_freelist(size_t ops) {
+    static void *slots[MIXED_SLOTS];
+    memset(slots, 0, sizeof(slots));
+    void *memory = malloc(MIXED_HEAP_BYTES);
+    FreeListAllocator list;
+    freelist_init(&list, memory, MIXED_HEAP_BYTES);
+    uint64_t rng = 0x9E3779B97F4A7C15ull;
+    double start = now_seconds();
+    for (size_t i = 0; i < ops; i++) {
+        size_t slot, size;
+        MIXED_NEXT(&rng, slot, size);
+        if (slots[slot] != NULL) {
+            freelist_free(&list, slots[slot]);
+        }
+        slots[slot] = freelist_alloc(&list, size);
+        *(volatile char *)slots[slot] = (char)i;
+    }
+    double elapsed = now_seconds() - start;
+    free(memory);
+    return elapsed;
+}
+
+static double mixed_size_class(size_t ops) {
+    static void *slots[MIXED_SLOTS];
+    memset(slots, 0, sizeof(slots));
+    SizeClassAllocator classes;
+    size_class_allocator_init(&classes);
+    size_class_allocator_create(&classes, (size_t)MIXED_SLOTS * MIXED_MAX_SIZE * 2, MIXED_HEAP_BYTES);
+    uint64_t rng = 0x9E3779B97F4A7C15ull;
+    double start = now_seconds();
+    for (size_t i = 0; i < ops; i++) {
+        size_t slot, size;
+        MIXED_NEXT(&rng, slot, size);
+        size_class_allocator_free(&classes, slots[slot]);
+        slots[slot] = size_class_allocator_alloc(&classes, size);
+        *(volatile char *)slots[slot] = (char)i;
+    }
+    double elapsed = now_seconds() - start;
+    size_class_allocator_destroy(&classes);
+    return elapsed;
+}
+
+// Fixed blocks sized for the largest request
+static double mixed_pool(size_t ops) {
+    static void *slots[MIXED_SLOTS];
+    memset(slots, 0, sizeof(slots));
+    PoolAllocator pool;
+    pool_allocator_init(&pool);
+    pool_allocator_create(&pool, MIXED_MAX_SIZE, MIXED_SLOTS);
+    uint64_t rng = 0x9E3779B97F4A7C15ull;
+    double start = now_seconds();
+    for (size_t i = 0; i < ops; i++) {
+        size_t slot, size;
+        MIXED_NEXT(&rng, slot, size);
+        (void)size;
+        pool_allocator_free(&pool, slots[slot]);
+        slots[slot] = pool_allocator_alloc(&pool);
+        *(volatile char *)slots[slot] = (char)i;
+    }
+    double elapsed = now_seconds() - start;
+    pool_allocator_destroy(&pool);
+    return elapsed;
+}
+
+static void run_mixed(size_t ops) {
+    print_header("mixed: 4096 live objects of 16-512 bytes, random replacement");
+    for (size_t i = 0; i < heap_count; i++) {
+        record("mixed", heaps[i].name, 1, 0, ops, mixed_heap(&heaps[i], ops));
+    }
+    record("mixed", "pool (512-byte blocks)", 1, 0, ops, mixed_pool(ops));
+    record("mixed", "free-list", 1, 0, ops, mixed_freelist(ops));
+    record("mixed", "size-class", 1, 0, ops, mixed_size_class(ops));
+}
+
+// ─── threads: the single workload on every thread ───────────────────────────
+
+typedef enum {
+    THREAD_HEAP,              // Shared malloc-compatible heap
+    THREAD_CONCURRENT_ARENA,  // Shared arena, allocation only (no release until the run ends)
+    THREAD_CACHE,             // Per-thread cache over a shared arena, allocation only
+    THREAD_LOCK_FREE_POOL,    // Shared pool, every alloc and free on the Treiber stack
+    THREAD_MAGAZINE_POOL,     // Shared pool behind per-thread magazines
+    THREAD_OWNED_POOL         // One owned pool per thread
+} ThreadMode;
+
+typedef struct {
+    ThreadMode mode;
+    const Heap *heap;
+    ConcurrentMemoryAllocator *arena;
+    ConcurrentPoolAllocator *pool;
+    size_t rounds;
+    pthread_barrier_t *start;
+    double begin;  // Set by the worker once released
+    double end;
+} ThreadWork;
+
+static void *thread_worker(void *arg) {
+    ThreadWork *work = arg;
+    void *ptrs[BATCH];
+    ThreadCacheAllocator cache;
+    ConcurrentPoolMagazine magazine;
+    OwnedPoolAllocator owned;
+
+    // Every front end is set up so the switch below never reads an unset one
+    thread_cache_allocator_init(&cache, work->arena, 0);
+    concurrent_pool_magazine_init(&magazine, work->pool, 0);
+    owned_pool_allocator_init(&owned);
+    if (work->mode == THREAD_OWNED_POOL) {
+        owned_pool_allocator_create(&owned, OBJECT_SIZE, BATCH);
+    }
+    pthread_barrier_wait(work->start);
+    work->begin = now_seconds();
+
+    for (size_t r = 0; r < work->rounds; r++) {
+        for (size_t i = 0; i < BATCH; i++) {
+            switch (work->mode) {
+            case THREAD_HEAP:
+                ptrs[i] = work->heap->malloc_fn(OBJECT_SIZE);
+                break;
+            case THREAD_CONCURRENT_ARENA:
+                ptrs[i] = concurrent_memory_allocator_alloc(work->arena, OBJECT_SIZE);
+                break;
+            case THREAD_CACHE:
+                ptrs[i] = thread_cache_allocator_alloc(&cache, OBJECT_SIZE);
+                break;
+            case THREAD_LOCK_FREE_POOL:
+                ptrs[i] = concurrent_pool_allocator_alloc(work->pool);
+                break;
+            case THREAD_MAGAZINE_POOL:
+                ptrs[i] = concurrent_pool_magazine_alloc(&magazine);
+                break;
+            case THREAD_OWNED_POOL:
+                ptrs[i] = owned_pool_allocator_alloc(&owned);
+                break;
+            }
+            *(volatile char *)ptrs[i] = (char)i;
+        }
+        for (size_t i = 0; i < BATCH; i++) {
+            switch (work->mode) {
+            case THREAD_HEAP:
+                work->heap->free_fn(ptrs[i]);
+                break;
+            case THREAD_LOCK_FREE_POOL:
+                concurrent_pool_allocator_free(work->pool, ptrs[i]);
+                break;
+            case THREAD_MAGAZINE_POOL:
+                concurrent_pool_magazine_free(&magazine, ptrs[i]);
+                break;
+            case THREAD_OWNED_POOL:
+                owned_pool_allocator_free(&owned, ptrs[i]);
+                break;
+            default:
+                break;  // Arenas release everything at the end of the run
+            }
+        }
+    }
+
+    if (work->mode == THREAD_MAGAZINE_POOL) {
+        concurrent_pool_magazine_flush(&magazine);
+    } else if (work->mode == THREAD_OWNED_POOL) {
+        owned_pool_allocator_destroy(&owned);
+    }
+    work->end = now_seconds();
+    return NULL;
+}
+
+// Wall time from the first thread starting until the last one finishes.
+// The workers take the timestamps themselves: on few CPUs the main thread
+// may not run again until they are done
+static double run_thread_mode(ThreadMode mode, const Heap *heap, int threads, size_t rounds) {
+    ConcurrentMemoryAllocator arena;
+    ConcurrentPoolAllocator pool;
+    concurrent_memory_allocator_init(&arena);
+    concurrent_pool_allocator_init(&pool);
+    if (mode == THREAD_CONCURRENT_ARENA || mode == THREAD_CACHE) {
+        // Room for every allocation plus one partly used cache chunk per thread
+        size_t bytes = (size_t)threads * (rounds * BATCH * OBJECT_SIZE + THREAD_CACHE_ALLOCATOR_DEFAULT_CHUNK_SIZE);
+        SimpleMemoryAllocatorOptions options = {0};
+        options.backing = SIMPLE_MEMORY_BACKING_MMAP;
+        if (concurrent_memory_allocator_create_with_options(&arena, bytes, &options) != 0) {
+            return -1.0;
+        }
+    } else if (mode == THREAD_LOCK_FREE_POOL || mode == THREAD_MAGAZINE_POOL) {
+        // Magazines may park a full magazine per thread on top of a batch
+        size_t blocks = (size_t)threads * (BATCH + CONCURRENT_POOL_MAGAZINE_MAX);
+        if (concurrent_pool_allocator_create(&pool, OBJECT_SIZE, blocks) != 0) {
+            return -1.0;
+        }
+    }
+
+    pthread_barrier_t start;
+    pthread_barrier_init(&start, NULL, (unsigned)threads + 1);
+    pthread_t tids[MAX_THREADS];
+    ThreadWork work[MAX_THREADS];
+    for (int t = 0; t < threads; t++) {
+        work[t] = (ThreadWork){mode, heap, &arena, &pool, rounds, &start, 0, 0};
+        pthread_create(&tids[t], NULL, thread_worker, &work[t]);
+    }
+    pthread_barrier_wait(&start);
+    for (int t = 0; t < threads; t++) {
+        pthread_join(tids[t], NULL);
+    }
+    double begin = work[0].begin;
+    double end = work[0].end;
+    for (int t = 1; t < threads; t++) {
+        begin = work[t].begin < begin ? work[t].begin : begin;
+        end = work[t].end > end ? work[t].end : end;
+    }
+    double elapsed = end - begin;
+
+    pthread_barrier_destroy(&start);
+    concurrent_memory_allocator_destroy(&arena);
+    concurrent_pool_allocator_destroy(&pool);
+    return elapsed;
+}
+
+static void run_threads(size_t ops, int threads) {
+    size_t rounds = ops / BATCH;
+    size_t total = rounds * BATCH * (size_t)threads;
+    char title[96];
+    snprintf(title, sizeof(title), "threads: batches of 64-byte objects, %d threads", threads);
+    print_header(title);
+
+    static const struct {
+        ThreadMode mode;
+        const char *name;
+    } modes[] = {
+        {THREAD_CONCURRENT_ARENA, "concurrent arena (alloc only)"},
+        {THREAD_CACHE, "thread cache (alloc only)"},
+        {THREAD_LOCK_FREE_POOL, "lock-free pool"},
+        {THREAD_MAGAZINE_POOL, "lock-free pool + magazines"},
+        {THREAD_OWNED_POOL, "owned pool per thread"},
+    };
+
+    for (size_t i = 0; i < heap_count; i++) {
+        record("threads", heaps[i].name, threads, OBJECT_SIZE, total,
+               run_thread_mode(THREAD_HEAP, &heaps[i], threads, rounds));
+    }
+    for (size_t i = 0; i < sizeof(modes) / sizeof(modes[0]); i++) {
+        // Arenas keep everything until the run ends, so bound what they touch
+        size_t mode_rounds = rounds;
+        if (modes[i].mode == THREAD_CONCURRENT_ARENA || modes[i].mode == THREAD_CACHE) {
+            size_t cap = ARENA_THREAD_BYTES / (BATCH * OBJECT_SIZE);
+            mode_rounds = rounds < cap ? rounds : cap;
+        }
+        double seconds = run_thread_mode(modes[i].mode, NULL, threads, mode_rounds);
+        if (seconds < 0) {
+            printf("  %-30s %8d %15s\n", modes[i].name, threads, "unavailable");
+            continue;
+        }
+        record("threads", modes[i].name, threads, OBJECT_SIZE, mode_rounds * BATCH * (size_t)threads, seconds);
+    }
+}
+
+// ─── environment and machine-readable output ────────────────────────────────
+
+typedef struct {
+    char cpu[128];
+    long cpus;
+    char kernel[256];
+    char libc[32];
+    char timestamp[32];
+} BenchEnvironment;
+
+static void read_environment(BenchEnvironment *env) {
+    memset(env, 0, sizeof(*env));
+    snprintf(env->cpu, sizeof(env->cpu), "unknown");
+    FILE *f = fopen("/proc/cpuinfo", "r");
+    if (f != NULL) {
+        char line[256];
+        while (fgets(line, sizeof(line), f) != NULL) {
+            char *colon = strchr(line, ':');
+            if (colon != NULL && strncmp(line, "model name", 10) == 0) {
+                colon += colon[1] == ' ' ? 2 : 1;
+                colon[strcspn(colon, "\n")] = '\0';
+                snprintf(env->cpu, sizeof(env->cpu), "%s", colon);
+                break;
+            }
+        }
+        fclose(f);
+    }
+    env->cpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+    struct utsname name;
+    if (uname(&name) == 0) {
+        snprintf(env->kernel, sizeof(env->kernel), "%s %s %s", name.sysname, name.release, name.machine);
+    }
+#ifdef __GLIBC__
+    snprintf(env->libc, sizeof(env->libc), "glibc %s", gnu_get_libc_version());
+#else
+    snprintf(env->libc, sizeof(env->libc), "unknown");
+#endif
+    time_t t = time(NULL);
+    struct tm utc;
+    gmtime_r(&t, &utc);
+    strftime(env->timestamp, sizeof(env->timestamp), "%Y-%m-%dT%H:%M:%SZ", &utc);
+}
+
+// Write s as a JSON string literal
+static void json_string(FILE *out, const char *s) {
+    fputc('"', out);
+    for (; *s != '\0'; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\') {
+            fprintf(out, "\\%c", c);
+        } else if (c < 0x20) {
+            fprintf(out, "\\u%04x", c);
+        } else {
+            fputc(c, out);
+        }
+    }
+    fputc('"', out);
+}
+
+// Write s as a CSV field (quoted, embedded quotes doubled)
+static void csv_field(FILE *out, const char *s) {
+    fputc('"', out);
+    for (; *s != '\0'; s++) {
+        if (*s == '"') {
+            fputc('"', out);
+        }
+        fputc(*s, out);
+    }
+    fputc('"', out);
+}
+
+static int write_json(const char *path, const BenchEnvironment *env) {
+    FILE *out = fopen(path, "w");
+    if (out == NULL) {
+        return -1;
+    }
+    fprintf(out, "{\n  \"environment\": {\n    \"cpu\": ");
+    json_string(out, env->cpu);
+    fprintf(out, ",\n    \"cpus\": %ld,\n    \"kernel\": ", env->cpus);
+    json_string(out, env->kernel);
+    fprintf(out, ",\n    \"libc\": ");
+    json_string(out, env->libc);
+    fprintf(out, ",\n    \"compiler\": ");
+    json_string(out, __VERSION__);
+    fprintf(out, ",\n    \"flags\": ");
+    json_string(out, BENCH_CFLAGS);
+    fprintf(out, ",\n    \"timestamp\": ");
+    json_string(out, env->timestamp);
+    fprintf(out, ",\n    \"unavailable\": ");
+    json_string(out, missing_heaps);
+    fprintf(out, "\n  },\n  \"results\": [");
+    for (size_t i = 0; i < result_count; i++) {
+        const BenchResult *r = &results[i];
+        fprintf(out, "%s\n    {\"workload\": ", i != 0 ? "," : "");
+        json_string(out, r->workload);
+        fprintf(out, ", \"allocator\": ");
+        json_string(out, r->allocator);
+        fprintf(out, ", \"threads\": %d, \"size\": %zu, \"ops\": %zu, \"seconds\": %.6f, \"ops_per_sec\": %.0f, "
+                     "\"ns_per_op\": %.3f}",
+                r->threads, r->size, r->ops, r->seconds, (double)r->ops / r->seconds,
+                r->seconds * 1e9 / (double)r->ops);
+    }
+    fprintf(out, "\n  ]\n}\n");
+    return fclose(out) == 0 ? 0 : -1;
+}
+
+// One row per result; environment columns repeat so every row stands alone
+static int write_csv(const char *path, const BenchEnvironment *env) {
+    FILE *out = fopen(path, "w");
+    if (out == NULL) {
+        return -1;
+    }
+    fprintf(out, "workload,allocator,threads,size,ops,seconds,ops_per_sec,ns_per_op,cpu,kernel,compiler,flags,"
+                 "timestamp\n");
+    for (size_t i = 0; i < result_count; i++) {
+        const BenchResult *r = &results[i];
+        fprintf(out, "%s,", r->workload);
+        csv_field(out, r->allocator);
+        fprintf(out, ",%d,%zu,%zu,%.6f,%.0f,%.3f,", r->threads, r->size, r->ops, r->seconds,
+                (double)r->ops / r->seconds, r->seconds * 1e9 / (double)r->ops);
+        csv_field(out, env->cpu);
+        fputc(',', out);
+        csv_field(out, env->kernel);
+        fputc(',', out);
+        csv_field(out, __VERSION__);
+        fputc(',', out);
+        csv_field(out, BENCH_CFLAGS);
+        fprintf(out, ",%s\n", env->timestamp);
+    }
+    return fclose(out) == 0 ? 0 : -1;
+}
+
+int main(int argc, char **argv) {
+    const char *json_path = NULL;
+    const char *csv_path = NULL;
+    size_t ops = 2000000;
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    int threads = online < 2 ? 2 : online > 8 ? 8 : (int)online;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+            csv_path = argv[++i];
+        } else if (strcmp(argv[i], "--ops") == 0 && i + 1 < argc) {
+            ops = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "Usage: %s [--json FILE] [--csv FILE] [--ops N] [--threads N]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (ops < BATCH || threads < 1 || threads > MAX_THREADS) {
+        fprintf(stderr, "--ops must be at least %d and --threads between 1 and %d\n", BATCH, MAX_THREADS);
+        return 1;
+    }
+
+    BenchEnvironment env;
+    read_environment(&env);
+    load_heaps();
+
+    printf("\n");
+    printf("╔════════════════════════════════════════════════════════════╗\n");
+    printf("║          Comparative Allocator Benchmark                   ║\n");
+    printf("╚════════════════════════════════════════════════════════════╝\n\n");
+    printf("  %-10s %s (%ld CPUs)\n", "CPU", env.cpu, env.cpus);
+    printf("  %-10s %s, %s\n", "System", env.kernel, env.libc);
+    printf("  %-10s %s\n", "Compiler", __VERSION__);
+    if (missing_heaps[0] != '\0') {
+        printf("  %-10s %s (libraries not found)\n", "Skipped", missing_heaps);
+    }
+
+    run_single(ops);
+    run_mixed(ops);
+    run_threads(ops, threads);
+
+    int status = 0;
+    if (json_path != NULL && write_json(json_path, &env) != 0) {
+        fprintf(stderr, "Could not write %s\n", json_path);
+        status = 1;
+    }
+    if (csv_path != NULL && write_csv(csv_path, &env) != 0) {
+        fprintf(stderr, "Could not write %s\n", csv_path);
+        status = 1;
+    }
+
+    printf("\n────────────────────────────────────────────────────────────\n");
+    printf("Benchmark complete.%s%s%s%s\n", json_path != NULL ? " JSON: " : "", json_path != NULL ? json_path : "",
+           csv_path != NULL ? " CSV: " : "", csv_path != NULL ? csv_path : "");
+    printf("────────────────────────────────────────────────────────────\n\n");
+
+    unload_heaps();
+    return status;
+}
@@ -0,0 +1,51 @@
+/*
+ * Call vs inline bump allocation (see bench_inline_fast.h)
+ */
+
+#define _POSIX_C_SOURCE 200809L  // Required for clock_gettime
+
+#include <time.h>
+#include "../src/simple_memory_allocator.h"
+#include "bench_inline_fast.h"
+
+static void *volatile sink;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Allocations per second of `iterations` allocs, resetting whenever the pool fills
+static double run(size_t alloc_size, size_t pool_size, size_t iterations, int inline_path) {
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    if (simple_memory_allocator_create(&alloc, pool_size) != 0) {
+        return 0;
+    }
+
+    size_t allocs_per_pool = pool_size / ((alloc_size + 7) & ~((size_t)7));
+    size_t total_allocs = 0;
+
+    double start = now_ns();
+    while (total_allocs < iterations) {
+        for (size_t i = 0; i < allocs_per_pool && total_allocs < iterations; i++) {
+            sink = inline_path ? simple_memory_allocator_alloc_fast(&alloc, alloc_size)
+                               : simple_memory_allocator_alloc(&alloc, alloc_size);
+            total_allocs++;
+        }
+        simple_memory_allocator_reset(&alloc);
+    }
+    double elapsed = now_ns() - start;
+
+    simple_memory_allocator_destroy(&alloc);
+    return (double)total_allocs / (elapsed / 1e9);
+}
+
+double bench_inline_fast_call(size_t alloc_size, size_t pool_size, size_t iterations) {
+    return run(alloc_size, pool_size, iterations, 0);
+}
+
+double bench_inline_fast_inline(size_t alloc_size, size_t pool_size, size_t iterations) {
+    return run(alloc_size, pool_size, iterations, 1);
+}
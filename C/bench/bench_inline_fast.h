@@ -0,0 +1,21 @@
+/*
+ * Call vs inline bump allocation, built without link-time optimization
+ *
+ * The Makefile compiles bench_inline_fast.c with -fno-lto, so the calls it
+ * makes to simple_memory_allocator_alloc() stay real calls into another
+ * translation unit, as they are for consumers that do not build with LTO.
+ * simple_memory_allocator_alloc_fast() is inlined from the header either way.
+ */
+
+#ifndef BENCH_INLINE_FAST_H
+#define BENCH_INLINE_FAST_H
+
+#include <stddef.h>
+
+// Allocations per second through the out-of-line alloc()
+double bench_inline_fast_call(size_t alloc_size, size_t pool_size, size_t iterations);
+
+// Allocations per second through the header-inlined alloc_fast()
+double bench_inline_fast_inline(size_t alloc_size, size_t pool_size, size_t iterations);
+
+#endif
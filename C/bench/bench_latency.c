@@ -0,0 +1,188 @@
+/*
+ * Per-operation latency sampling for the benchmark suite
+ */
+
+#define _GNU_SOURCE  // Required for sched_setaffinity and syscall
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sched.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include "bench_latency.h"
+
+#define LATENCY_BAR_WIDTH 40
+#define LATENCY_ROWS      65  // Bit lengths 0..64 of a bucket's upper bound
+
+static uint64_t bucket_upper_bound(size_t index) {
+    if (index < LATENCY_SUB_COUNT) {
+        return index;
+    }
+    unsigned shift = (unsigned)(index / LATENCY_SUB_COUNT) - 1;
+    uint64_t sub = index % LATENCY_SUB_COUNT;
+    uint64_t lower = (LATENCY_SUB_COUNT + sub) << shift;
+    return lower + ((uint64_t)1 << shift) - 1;
+}
+
+void latency_histogram_reset(LatencyHistogram *h) {
+    memset(h, 0, sizeof(*h));
+    h->min = UINT64_MAX;
+}
+
+uint64_t latency_histogram_percentile(const LatencyHistogram *h, double p) {
+    if (h->count == 0) {
+        return 0;
+    }
+
+    uint64_t rank = (uint64_t)(p * (double)(h->count - 1)) + 1;
+    uint64_t seen = 0;
+
+    for (size_t i = 0; i < LATENCY_BUCKETS; i++) {
+        seen += h->buckets[i];
+        if (seen >= rank) {
+            uint64_t bound = bucket_upper_bound(i);
+            return bound < h->max ? bound : h->max;
+        }
+    }
+    return h->max;
+}
+
+void latency_histogram_print(const LatencyHistogram *h) {
+    uint64_t rows[LATENCY_ROWS] = {0};
+    uint64_t peak = 0;
+
+    // Collapse the sub-buckets into one row per power of two
+    for (size_t i = 0; i < LATENCY_BUCKETS; i++) {
+        if (h->buckets[i] != 0) {
+            uint64_t bound = bucket_upper_bound(i);
+            unsigned row = bound == 0 ? 0 : 64u - (unsigned)__builtin_clzll(bound);
+            rows[row] += h->buckets[i];
+        }
+    }
+    for (size_t row = 0; row < LATENCY_ROWS; row++) {
+        if (rows[row] > peak) {
+            peak = rows[row];
+        }
+    }
+
+    for (size_t row = 0; row < LATENCY_ROWS; row++) {
+        if (rows[row] == 0) {
+            continue;
+        }
+        char bar[LATENCY_BAR_WIDTH + 1];
+        size_t width = (size_t)((double)rows[row] / (double)peak * LATENCY_BAR_WIDTH);
+        if (width == 0) {
+            width = 1;
+        }
+        memset(bar, '#', width);
+        bar[width] = '\0';
+
+        // The top row's bound 2^64 does not fit in a uint64_t, so it prints as <= UINT64_MAX
+        double percent = 100.0 * (double)rows[row] / (double)h->count;
+        if (row == LATENCY_ROWS - 1) {
+            printf("    <= %-9llu %10.4f%%  %s\n", (unsigned long long)UINT64_MAX, percent, bar);
+        } else {
+            printf("    < %-10llu %10.4f%%  %s\n", (unsigned long long)1 << row, percent, bar);
+        }
+    }
+}
+
+uint64_t latency_timer_overhead(void) {
+    LatencyHistogram h;
+    latency_histogram_reset(&h);
+
+    for (int i = 0; i < 10000; i++) {
+        uint64_t start = latency_start();
+        uint64_t stop = latency_stop();
+        latency_histogram_record(&h, stop - start);
+    }
+    return latency_histogram_percentile(&h, 0.5);
+}
+
+double latency_ticks_per_ns(void) {
+#if LATENCY_HAVE_TSC
+    struct timespec start_ts, stop_ts;
+    struct timespec pause = {0, 20 * 1000 * 1000};
+
+    clock_gettime(CLOCK_MONOTONIC, &start_ts);
+    uint64_t start = latency_start();
+    nanosleep(&pause, NULL);
+    uint64_t stop = latency_stop();
+    clock_gettime(CLOCK_MONOTONIC, &stop_ts);
+
+    double elapsed_ns = (double)(stop_ts.tv_sec - start_ts.tv_sec) * 1e9 +
+                        (double)(stop_ts.tv_nsec - start_ts.tv_nsec);
+    return (double)(stop - start) / elapsed_ns;
+#else
+    return 1.0;
+#endif
+}
+
+int latency_pin_cpu(int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0 ? 0 : -1;
+}
+
+static int perf_open_event(uint32_t type, uint64_t config) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_hv = 1;
+    attr.exclude_kernel = type == PERF_TYPE_SOFTWARE ? 0 : 1;
+
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+int latency_perf_open(LatencyPerfCounters *counters) {
+    counters->fds[LATENCY_PERF_CACHE_MISSES] = perf_open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    counters->fds[LATENCY_PERF_DTLB_MISSES] = perf_open_event(
+        PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+    counters->fds[LATENCY_PERF_PAGE_FAULTS] = perf_open_event(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS);
+
+    int opened = 0;
+    for (int i = 0; i < LATENCY_PERF_COUNT; i++) {
+        counters->values[i] = -1;
+        opened += counters->fds[i] >= 0;
+    }
+    return opened;
+}
+
+void latency_perf_start(LatencyPerfCounters *counters) {
+    for (int i = 0; i < LATENCY_PERF_COUNT; i++) {
+        if (counters->fds[i] >= 0) {
+            ioctl(counters->fds[i], PERF_EVENT_IOC_RESET, 0);
+            ioctl(counters->fds[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+}
+
+void latency_perf_stop(LatencyPerfCounters *counters) {
+    for (int i = 0; i < LATENCY_PERF_COUNT; i++) {
+        uint64_t value;
+        counters->values[i] = -1;
+        if (counters->fds[i] >= 0) {
+            ioctl(counters->fds[i], PERF_EVENT_IOC_DISABLE, 0);
+            if (read(counters->fds[i], &value, sizeof(value)) == (ssize_t)sizeof(value)) {
+                counters->values[i] = (int64_t)value;
+            }
+        }
+    }
+}
+
+void latency_perf_close(LatencyPerfCounters *counters) {
+    for (int i = 0; i < LATENCY_PERF_COUNT; i++) {
+        if (counters->fds[i] >= 0) {
+            close(counters->fds[i]);
+            counters->fds[i] = -1;
+        }
+    }
+}
@@ -0,0 +1,125 @@
+/*
+ * Per-operation latency sampling for the benchmark suite
+ *
+ * Times single calls with serialized rdtsc/rdtscp (clock_gettime nanoseconds
+ * on other architectures), accumulates them in a log-linear histogram and
+ * optionally reads hardware/software counters around a whole run through
+ * perf_event_open.
+ */
+
+#ifndef BENCH_LATENCY_H
+#define BENCH_LATENCY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define LATENCY_HAVE_TSC 1
+#else
+#include <time.h>
+#define LATENCY_HAVE_TSC 0
+#endif
+
+// Histogram buckets: 16 linear sub-buckets per power of two from 16 upward
+#define LATENCY_SUB_LOG2  4
+#define LATENCY_SUB_COUNT (1u << LATENCY_SUB_LOG2)
+#define LATENCY_BUCKETS   (64 * LATENCY_SUB_COUNT)
+
+typedef struct {
+    uint64_t buckets[LATENCY_BUCKETS];
+    uint64_t count;
+    uint64_t sum;
+    uint64_t min;
+    uint64_t max;
+} LatencyHistogram;
+
+// Counters sampled around a run (values are totals; -1 = unavailable)
+#define LATENCY_PERF_CACHE_MISSES 0
+#define LATENCY_PERF_DTLB_MISSES  1
+#define LATENCY_PERF_PAGE_FAULTS  2
+#define LATENCY_PERF_COUNT        3
+
+typedef struct {
+    int fds[LATENCY_PERF_COUNT];
+    int64_t values[LATENCY_PERF_COUNT];
+} LatencyPerfCounters;
+
+// Timestamp before the measured operation (serialized against earlier work)
+static inline uint64_t latency_start(void) {
+#if LATENCY_HAVE_TSC
+    _mm_lfence();
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+// Timestamp after the measured operation (waits for it to retire)
+static inline uint64_t latency_stop(void) {
+#if LATENCY_HAVE_TSC
+    unsigned aux;
+    uint64_t t = __rdtscp(&aux);
+    _mm_lfence();
+    return t;
+#else
+    return latency_start();
+#endif
+}
+
+static inline size_t latency_bucket(uint64_t value) {
+    if (value < LATENCY_SUB_COUNT) {
+        return (size_t)value;
+    }
+    unsigned msb = 63u - (unsigned)__builtin_clzll(value);
+    size_t sub = (size_t)(value >> (msb - LATENCY_SUB_LOG2)) & (LATENCY_SUB_COUNT - 1);
+    return (msb - LATENCY_SUB_LOG2 + 1) * LATENCY_SUB_COUNT + sub;
+}
+
+// Record one sample (ticks = cycles with a TSC, nanoseconds otherwise)
+static inline void latency_histogram_record(LatencyHistogram *h, uint64_t ticks) {
+    h->buckets[latency_bucket(ticks)]++;
+    h->count++;
+    h->sum += ticks;
+    if (ticks < h->min) {
+        h->min = ticks;
+    }
+    if (ticks > h->max) {
+        h->max = ticks;
+    }
+}
+
+// Clear all samples
+void latency_histogram_reset(LatencyHistogram *h);
+
+// Upper bound of the bucket holding the p-th sample (0 <= p <= 1), clamped to max
+uint64_t latency_histogram_percentile(const LatencyHistogram *h, double p);
+
+// Print one row per non-empty power of two with a proportional bar
+void latency_histogram_print(const LatencyHistogram *h);
+
+// Median cost of an empty start/stop pair, subtracted from samples by callers
+uint64_t latency_timer_overhead(void);
+
+// Ticks per nanosecond, calibrated against CLOCK_MONOTONIC (1.0 without a TSC)
+double latency_ticks_per_ns(void);
+
+// Pin the calling thread to one CPU (returns 0 on success, -1 on failure)
+int latency_pin_cpu(int cpu);
+
+// Open cache-miss, dTLB-miss and page-fault counters for the calling thread
+// (counters the kernel refuses stay unavailable; returns number opened)
+int latency_perf_open(LatencyPerfCounters *counters);
+
+// Reset and enable all open counters
+void latency_perf_start(LatencyPerfCounters *counters);
+
+// Disable all open counters and read their totals into values[]
+void latency_perf_stop(LatencyPerfCounters *counters);
+
+// Close all open counters
+void latency_perf_close(LatencyPerfCounters *counters);
+
+#endif
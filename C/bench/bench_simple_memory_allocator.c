@@ -4,18 +4,38 @@
  * Measures allocation throughput and compares against malloc.
  */
 
-#define _POSIX_C_SOURCE 199309L  // Required for clock_gettime
+#define _POSIX_C_SOURCE 200809L  // Required for clock_gettime and pthread barriers
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <string.h>
 #include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/resource.h>
 #include "../src/simple_memory_allocator.h"
+#include "../src/concurrent_memory_allocator.h"
+#include "../src/thread_cache_allocator.h"
+#include "../src/pool_allocator.h"
+#include "../src/size_class_allocator.h"
+#include "../src/freelist_allocator.h"
+#include "../src/numa_arena_group.h"
+#include "../src/concurrent_pool_allocator.h"
+#include "../src/owned_pool_allocator.h"
+#include "../src/arena_snapshot.h"
+#include "tutorial_allocators.h"
+#include "bench_latency.h"
+#include "bench_inline_fast.h"
 
 // Benchmark configuration
 #define ITERATIONS      1000000
 #define WARMUP_ITERS    10000
 #define POOL_SIZE       (64 * 1024 * 1024)  // 64MB pool
+#define MAX_THREADS     64
+#define LATENCY_OPS     1000000
+#define LATENCY_SLOTS   1024
 
 // High-resolution timer
 typedef struct {
@@ -74,6 +94,62 @@ static double bench_bump_alloc(size_t alloc_size, size_t iterations) {
     return bench_ops_per_sec(&timer, total_allocs);
 }
 
+// Benchmark aligned bump allocation throughput
+static double bench_aligned_alloc(size_t alloc_size, size_t alignment, size_t iterations) {
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    simple_memory_allocator_create(&alloc, POOL_SIZE);
+
+    BenchTimer timer;
+    size_t total_allocs = 0;
+
+    bench_start(&timer);
+
+    while (total_allocs < iterations) {
+        void *ptr = simple_memory_allocator_alloc_aligned(&alloc, alloc_size, alignment);
+        if (ptr == NULL) {
+            simple_memory_allocator_reset(&alloc);
+            continue;
+        }
+        sink = ptr;
+        total_allocs++;
+    }
+
+    bench_end(&timer);
+
+    simple_memory_allocator_destroy(&alloc);
+    return bench_ops_per_sec(&timer, total_allocs);
+}
+
+// Benchmark aligned_alloc() for the same size/alignment
+static double bench_aligned_malloc(size_t alloc_size, size_t alignment, size_t iterations) {
+    void **ptrs = malloc(iterations * sizeof(void *));
+    if (!ptrs) return 0;
+
+    // aligned_alloc requires size to be a multiple of the alignment
+    size_t rounded = (alloc_size + alignment - 1) & ~(alignment - 1);
+
+    BenchTimer timer;
+
+    bench_start(&timer);
+
+    for (size_t i = 0; i < iterations; i++) {
+        ptrs[i] = aligned_alloc(alignment, rounded);
+        sink = ptrs[i];
+    }
+
+    bench_end(&timer);
+
+    double ops = bench_ops_per_sec(&timer, iterations);
+
+    for (size_t i = 0; i < iterations; i++) {
+        free(ptrs[i]);
+    }
+    free(ptrs);
+
+    return ops;
+}
+
 // Benchmark malloc allocation throughput
 static double bench_malloc_alloc(size_t alloc_size, size_t iterations) {
     // Pre-allocate array to store pointers for freeing
@@ -138,6 +214,261 @@ static void bench_reset_vs_recreate(void) {
     printf("  %-30s %12.1fx faster\n", "Speedup", recreate_ns / reset_ns);
 }
 
+#define CHURN_LIVE        256
+#define CHURN_ARENA_SIZE  (16 * 1024)
+
+// Replace the oldest of CHURN_LIVE per-connection arenas, `iterations` times
+static void churn_arenas(SimpleMemoryAllocator *live, const SimpleMemoryAllocatorOptions *options,
+                         size_t iterations) {
+    for (size_t i = 0; i < iterations; i++) {
+        SimpleMemoryAllocator *arena = &live[i % CHURN_LIVE];
+        simple_memory_allocator_destroy(arena);
+        simple_memory_allocator_create_with_options(arena, CHURN_ARENA_SIZE - 64, options);
+        for (int j = 0; j < 8; j++) {
+            sink = simple_memory_allocator_alloc(arena, 64);
+        }
+    }
+}
+
+// Benchmark per-connection arenas: malloc-backed versus children of a pool
+// (churned, oldest first) and of a parent arena (nested, newest first)
+static void bench_child_arenas(void) {
+    size_t iterations = 1000000;
+    static SimpleMemoryAllocator live[CHURN_LIVE];
+    BenchTimer timer;
+
+    SimpleMemoryAllocatorOptions malloc_opts = {0};
+    PoolAllocator pool;
+    pool_allocator_init(&pool);
+    pool_allocator_create(&pool, CHURN_ARENA_SIZE, CHURN_LIVE);
+    SimpleMemoryAllocatorOptions pool_opts = {0};
+    pool_opts.backing = SIMPLE_MEMORY_BACKING_PARENT_POOL;
+    pool_opts.parent = &pool;
+
+    printf("\n  Per-Connection Arenas (%d live, %d KB each, 8 allocs per arena)\n", CHURN_LIVE,
+           CHURN_ARENA_SIZE / 1024);
+    printf("  %-30s %12s\n", "Backing", "ns/arena");
+
+    const SimpleMemoryAllocatorOptions *churned[] = {&malloc_opts, &pool_opts};
+    const char *names[] = {"malloc (churned)", "child of pool (churned)"};
+    for (int k = 0; k < 2; k++) {
+        for (size_t i = 0; i < CHURN_LIVE; i++) {
+            simple_memory_allocator_init(&live[i]);
+        }
+        churn_arenas(live, churned[k], CHURN_LIVE);  // Warm up
+        bench_start(&timer);
+        churn_arenas(live, churned[k], iterations);
+        bench_end(&timer);
+        for (size_t i = 0; i < CHURN_LIVE; i++) {
+            simple_memory_allocator_destroy(&live[i]);
+        }
+        printf("  %-30s %12.1f\n", names[k], bench_elapsed_ns(&timer) / iterations);
+    }
+    pool_allocator_destroy(&pool);
+
+    // Nested scopes hand their block straight back to the parent
+    SimpleMemoryAllocator parent, child;
+    simple_memory_allocator_init(&parent);
+    simple_memory_allocator_init(&child);
+    simple_memory_allocator_create(&parent, 1024 * 1024);
+    SimpleMemoryAllocatorOptions child_opts = {0};
+    child_opts.backing = SIMPLE_MEMORY_BACKING_PARENT_ARENA;
+    child_opts.parent = &parent;
+    bench_start(&timer);
+    for (size_t i = 0; i < iterations; i++) {
+        simple_memory_allocator_create_with_options(&child, CHURN_ARENA_SIZE - 64, &child_opts);
+        for (int j = 0; j < 8; j++) {
+            sink = simple_memory_allocator_alloc(&child, 64);
+        }
+        simple_memory_allocator_destroy(&child);
+    }
+    bench_end(&timer);
+    printf("  %-30s %12.1f\n", "child of arena (nested)", bench_elapsed_ns(&timer) / iterations);
+    simple_memory_allocator_destroy(&parent);
+}
+
+// Minor page faults taken by the process so far
+static long minor_faults(void) {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_minflt;
+}
+
+// Resident set size of the process in MB (from /proc/self/statm)
+static double resident_mb(void) {
+    long pages = 0;
+    FILE *f = fopen("/proc/self/statm", "r");
+    if (f != NULL) {
+        if (fscanf(f, "%*d %ld", &pages) != 1) {
+            pages = 0;
+        }
+        fclose(f);
+    }
+    return (double)pages * (double)sysconf(_SC_PAGESIZE) / (1024.0 * 1024.0);
+}
+
+// One cycle: touch `bytes` of the arena, then reset it one way or the other
+static void decommit_cycles(SimpleMemoryAllocator *alloc, size_t bytes, size_t cycles, int decommit) {
+    for (size_t i = 0; i < cycles; i++) {
+        memset(simple_memory_allocator_alloc(alloc, bytes), (int)i, bytes);
+        if (decommit) {
+            simple_memory_allocator_reset_decommit(alloc, NULL);
+        } else {
+            simple_memory_allocator_reset(alloc);
+        }
+    }
+}
+
+// Benchmark reset_decommit(): steady cycles must stay fault-free, and a
+// one-off spike must not leave the whole pool resident
+static void bench_reset_decommit(void) {
+    SimpleMemoryAllocatorOptions opts = {0};
+    opts.backing = SIMPLE_MEMORY_BACKING_MMAP;
+    size_t steady = 256 * 1024;
+    size_t cycles = 10000;
+    BenchTimer timer;
+
+    printf("\n  Reset with Decommit (%d MB mmap pool, %zu KB steady cycles)\n", POOL_SIZE / (1024 * 1024),
+           steady / 1024);
+    printf("  %-30s %12s %12s %14s\n", "Reset", "ns/cycle", "faults", "RSS after spike");
+
+    for (int decommit = 0; decommit <= 1; decommit++) {
+        SimpleMemoryAllocator alloc;
+        simple_memory_allocator_init(&alloc);
+        simple_memory_allocator_create_with_options(&alloc, POOL_SIZE, &opts);
+        decommit_cycles(&alloc, steady, 16, decommit);
+
+        long faults = minor_faults();
+        bench_start(&timer);
+        decommit_cycles(&alloc, steady, cycles, decommit);
+        bench_end(&timer);
+        faults = minor_faults() - faults;
+
+        // One outsized cycle, then steady demand again
+        double before = resident_mb();
+        decommit_cycles(&alloc, POOL_SIZE, 1, decommit);
+        decommit_cycles(&alloc, steady, 32, decommit);
+        double retained = resident_mb() - before;
+
+        printf("  %-30s %12.1f %12ld %11.1f MB\n", decommit ? "reset_decommit()" : "reset()",
+               bench_elapsed_ns(&timer) / cycles, faults, retained);
+        simple_memory_allocator_destroy(&alloc);
+    }
+}
+
+#define SNAPSHOT_KEYS 500000
+
+// Lookup structure for the snapshot bench: open addressing over relative pointers
+typedef struct {
+    ArenaRelPtr key;  // NUL-terminated string in the arena
+    uint64_t value;
+} SnapshotEntry;
+
+typedef struct {
+    size_t mask;
+    ArenaRelPtr slots;  // SnapshotEntry[mask + 1]
+} SnapshotTable;
+
+static uint64_t snapshot_hash(const char *key) {
+    uint64_t h = 1469598103934665603ull;
+    for (; *key != '\0'; key++) {
+        h = (h ^ (unsigned char)*key) * 1099511628211ull;
+    }
+    return h;
+}
+
+// Build the table the slow way: format, hash and insert every key
+static SnapshotTable *snapshot_build(SimpleMemoryAllocator *arena) {
+    SnapshotTable *table = simple_memory_allocator_alloc(arena, sizeof(*table));
+    size_t capacity = 1;
+    while (capacity < SNAPSHOT_KEYS * 2) {
+        capacity <<= 1;
+    }
+    table->mask = capacity - 1;
+    SnapshotEntry *slots = simple_memory_allocator_alloc_aligned(arena, capacity * sizeof(SnapshotEntry), 64);
+    memset(slots, 0, capacity * sizeof(SnapshotEntry));
+    arena_relptr_set(&table->slots, slots);
+
+    char key[32];
+    for (size_t i = 0; i < SNAPSHOT_KEYS; i++) {
+        int len = snprintf(key, sizeof(key), "key-%zu", i * 7919);
+        char *copy = simple_memory_allocator_alloc(arena, (size_t)len + 1);
+        memcpy(copy, key, (size_t)len + 1);
+        size_t slot = snapshot_hash(copy) & table->mask;
+        while (slots[slot].key != 0) {
+            slot = (slot + 1) & table->mask;
+        }
+        arena_relptr_set(&slots[slot].key, copy);
+        slots[slot].value = i;
+    }
+    return table;
+}
+
+// Sum the values of every key (forces every lookup to complete)
+static uint64_t snapshot_lookups(const SnapshotTable *table) {
+    const SnapshotEntry *slots = arena_relptr_get(&table->slots);
+    uint64_t sum = 0;
+    char key[32];
+    for (size_t i = 0; i < SNAPSHOT_KEYS; i++) {
+        snprintf(key, sizeof(key), "key-%zu", i * 7919);
+        size_t slot = snapshot_hash(key) & table->mask;
+        while (strcmp(arena_relptr_get(&slots[slot].key), key) != 0) {
+            slot = (slot + 1) & table->mask;
+        }
+        sum += slots[slot].value;
+    }
+    return sum;
+}
+
+// Worker startup: rebuild the lookup table vs map a snapshot of it
+static void bench_snapshot_startup(void) {
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/bench_arena_snapshot_%ld.snap", (long)getpid());
+    BenchTimer timer;
+
+    SimpleMemoryAllocator arena;
+    simple_memory_allocator_init(&arena);
+    simple_memory_allocator_create(&arena, POOL_SIZE);
+
+    bench_start(&timer);
+    SnapshotTable *table = snapshot_build(&arena);
+    bench_end(&timer);
+    double build_ms = bench_elapsed_ns(&timer) / 1e6;
+    size_t bytes = arena.used;
+
+    uint64_t expected = snapshot_lookups(table);
+    if (arena_snapshot_write(&arena, table, path) != 0) {
+        printf("  (snapshot write to %s failed)\n", path);
+        simple_memory_allocator_destroy(&arena);
+        return;
+    }
+    simple_memory_allocator_destroy(&arena);
+
+    // The file is in the page cache, as it would be for every worker after the first
+    ArenaSnapshot snap;
+    arena_snapshot_init(&snap);
+    bench_start(&timer);
+    int opened = arena_snapshot_open(&snap, path);
+    bench_end(&timer);
+    double map_ms = bench_elapsed_ns(&timer) / 1e6;
+
+    if (opened == 0) {
+        bench_start(&timer);
+        uint64_t sum = snapshot_lookups(arena_snapshot_root(&snap));
+        bench_end(&timer);
+        double lookup_ms = bench_elapsed_ns(&timer) / 1e6;
+
+        printf("\n  Snapshot Startup (%d keys, %.1f MB table)\n", SNAPSHOT_KEYS, bytes / (1024.0 * 1024.0));
+        printf("  %-30s %12s\n", "Startup", "ms");
+        printf("  %-30s %12.2f\n", "Rebuild in arena", build_ms);
+        printf("  %-30s %12.3f\n", "Map snapshot", map_ms);
+        printf("  %-30s %12.2f%s\n", "All lookups on the map", lookup_ms, sum == expected ? "" : "  (MISMATCH)");
+        printf("  %-30s %11.0fx\n", "Startup speedup", build_ms / map_ms);
+        arena_snapshot_close(&snap);
+    }
+    unlink(path);
+}
+
 // Benchmark fill pattern (how long to fill entire pool)
 static void bench_fill_pattern(size_t alloc_size) {
     SimpleMemoryAllocator alloc;
@@ -170,6 +501,142 @@ static void bench_fill_pattern(size_t alloc_size) {
     simple_memory_allocator_destroy(&alloc);
 }
 
+// Benchmark pool creation and fill throughput for one backing
+// The first pass pays page faults unless the pool was pre-faulted
+static void bench_backing_fill(const char *name, const SimpleMemoryAllocatorOptions *options) {
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+
+    size_t alloc_size = 4096;
+    size_t allocs_per_pool = POOL_SIZE / alloc_size;
+    size_t steady_iterations = 10;
+    BenchTimer timer;
+
+    bench_start(&timer);
+    int result = simple_memory_allocator_create_with_options(&alloc, POOL_SIZE, options);
+    bench_end(&timer);
+    if (result != 0) {
+        printf("  %-26s %12s\n", name, "unavailable");
+        return;
+    }
+    double create_ms = bench_elapsed_ns(&timer) / 1e6;
+
+    bench_start(&timer);
+    for (size_t i = 0; i < allocs_per_pool; i++) {
+        void *ptr = simple_memory_allocator_alloc(&alloc, alloc_size);
+        memset(ptr, (int)i, alloc_size);
+        sink = ptr;
+    }
+    bench_end(&timer);
+    simple_memory_allocator_reset(&alloc);
+    double first_s = bench_elapsed_ns(&timer) / 1e9;
+
+    bench_start(&timer);
+    for (size_t iter = 0; iter < steady_iterations; iter++) {
+        for (size_t i = 0; i < allocs_per_pool; i++) {
+            void *ptr = simple_memory_allocator_alloc(&alloc, alloc_size);
+            memset(ptr, (int)i, alloc_size);
+            sink = ptr;
+        }
+        simple_memory_allocator_reset(&alloc);
+    }
+    bench_end(&timer);
+    double steady_s = bench_elapsed_ns(&timer) / 1e9;
+
+    double pool_gb = (double)POOL_SIZE / (1024.0 * 1024.0 * 1024.0);
+    printf("  %-26s %9.2f ms %9.2f GB/s %9.2f GB/s\n", name, create_ms,
+           pool_gb / first_s, pool_gb * steady_iterations / steady_s);
+
+    simple_memory_allocator_destroy(&alloc);
+}
+
+// Compare fill throughput across pool backings
+static void bench_backings(void) {
+    SimpleMemoryAllocatorOptions malloc_opts = {0};
+
+    SimpleMemoryAllocatorOptions mmap_opts = {0};
+    mmap_opts.backing = SIMPLE_MEMORY_BACKING_MMAP;
+
+    SimpleMemoryAllocatorOptions populate_opts = mmap_opts;
+    populate_opts.map_flags = SIMPLE_MEMORY_MAP_POPULATE;
+
+    SimpleMemoryAllocatorOptions thp_opts = mmap_opts;
+    thp_opts.map_flags = SIMPLE_MEMORY_MAP_TRANSPARENT_HUGE_PAGES | SIMPLE_MEMORY_MAP_POPULATE;
+
+    SimpleMemoryAllocatorOptions hugetlb_opts = mmap_opts;
+    hugetlb_opts.map_flags = SIMPLE_MEMORY_MAP_HUGETLB | SIMPLE_MEMORY_MAP_POPULATE;
+
+    printf("\n  Pool Backing (%d MB pool, 4096-byte allocs + memset)\n", POOL_SIZE / (1024 * 1024));
+    printf("  %-26s %12s %14s %14s\n", "Backing", "Create", "First fill", "Steady fill");
+    printf("  ─────────────────────────────────────────────────────────────────────\n");
+    bench_backing_fill("malloc", &malloc_opts);
+    bench_backing_fill("mmap", &mmap_opts);
+    bench_backing_fill("mmap + populate", &populate_opts);
+    bench_backing_fill("mmap + THP + populate", &thp_opts);
+    bench_backing_fill("mmap + hugetlb + populate", &hugetlb_opts);
+}
+
+// One pass over the pool: alloc + memset, or calloc
+static void zeroed_fill(SimpleMemoryAllocator *alloc, size_t alloc_size, size_t count, int use_calloc) {
+    for (size_t i = 0; i < count; i++) {
+        if (use_calloc) {
+            sink = simple_memory_allocator_calloc(alloc, 1, alloc_size);
+        } else {
+            void *ptr = simple_memory_allocator_alloc(alloc, alloc_size);
+            memset(ptr, 0, alloc_size);
+            sink = ptr;
+        }
+    }
+}
+
+// Benchmark calloc() against alloc + memset on fresh and recycled mmap pools
+// Fresh pools skip zeroing entirely (their pages fault in on the caller's
+// first write instead); recycled ones past the streaming threshold are
+// cleared with non-temporal stores
+static void bench_zeroed_alloc(size_t alloc_size) {
+    SimpleMemoryAllocatorOptions opts = {0};
+    opts.backing = SIMPLE_MEMORY_BACKING_MMAP;
+    size_t count = POOL_SIZE / alloc_size;
+    size_t fresh_iterations = 4;
+    size_t steady_iterations = 10;
+    double pool_gb = (double)POOL_SIZE / (1024.0 * 1024.0 * 1024.0);
+    BenchTimer timer;
+
+    printf("\n  Zeroed Allocation (%d MB mmap pool, %zu KB allocs)\n", POOL_SIZE / (1024 * 1024), alloc_size / 1024);
+    printf("  %-30s %14s %14s\n", "Method", "Fresh pool", "Recycled");
+
+    for (int use_calloc = 0; use_calloc <= 1; use_calloc++) {
+        SimpleMemoryAllocator alloc;
+        simple_memory_allocator_init(&alloc);
+
+        // Fresh: a new pool per pass, creation and page faults included
+        bench_start(&timer);
+        for (size_t iter = 0; iter < fresh_iterations; iter++) {
+            simple_memory_allocator_create_with_options(&alloc, POOL_SIZE, &opts);
+            zeroed_fill(&alloc, alloc_size, count, use_calloc);
+            simple_memory_allocator_destroy(&alloc);
+        }
+        bench_end(&timer);
+        double fresh_s = bench_elapsed_ns(&timer) / 1e9;
+
+        // Recycled: the same pool, dirtied and reset every pass
+        simple_memory_allocator_create_with_options(&alloc, POOL_SIZE, &opts);
+        zeroed_fill(&alloc, alloc_size, count, 0);
+        simple_memory_allocator_reset(&alloc);
+        bench_start(&timer);
+        for (size_t iter = 0; iter < steady_iterations; iter++) {
+            zeroed_fill(&alloc, alloc_size, count, use_calloc);
+            simple_memory_allocator_reset(&alloc);
+        }
+        bench_end(&timer);
+        double steady_s = bench_elapsed_ns(&timer) / 1e9;
+        simple_memory_allocator_destroy(&alloc);
+
+        printf("  %-30s %9.2f GB/s %9.2f GB/s\n", use_calloc ? "calloc()" : "alloc() + memset()",
+               pool_gb * fresh_iterations / fresh_s, pool_gb * steady_iterations / steady_s);
+    }
+}
+
 // Format large numbers with commas
 static void format_number(double n, char *buf, size_t buf_size) {
     if (n >= 1e9) {
@@ -183,66 +650,1254 @@ static void format_number(double n, char *buf, size_t buf_size) {
     }
 }
 
-// Warmup to stabilize CPU frequency and fill caches
-static void warmup(void) {
+// Allocate `iterations` objects in groups of `batch`, one alloc() per object
+// (batched = 0) or one alloc_batch() per group; fills the same pointer array
+static double bench_bump_batch(size_t alloc_size, size_t batch, int batched, size_t iterations) {
     SimpleMemoryAllocator alloc;
     simple_memory_allocator_init(&alloc);
-    simple_memory_allocator_create(&alloc, 1024 * 1024);
+    simple_memory_allocator_create(&alloc, POOL_SIZE);
 
-    for (size_t i = 0; i < WARMUP_ITERS; i++) {
-        sink = simple_memory_allocator_alloc(&alloc, 64);
-        if ((i % 1000) == 0) {
+    void **out = malloc(batch * sizeof(void *));
+    if (!out) return 0;
+
+    BenchTimer timer;
+    size_t total_allocs = 0;
+
+    bench_start(&timer);
+
+    while (total_allocs < iterations) {
+        size_t got;
+        if (batched) {
+            got = simple_memory_allocator_alloc_batch(&alloc, alloc_size, batch, out);
+        } else {
+            for (got = 0; got < batch; got++) {
+                out[got] = simple_memory_allocator_alloc(&alloc, alloc_size);
+                if (out[got] == NULL) break;
+            }
+        }
+        if (got < batch) {
             simple_memory_allocator_reset(&alloc);
+            continue;
         }
+        sink = out[batch - 1];
+        total_allocs += batch;
     }
 
+    bench_end(&timer);
+
+    free(out);
     simple_memory_allocator_destroy(&alloc);
+    return bench_ops_per_sec(&timer, total_allocs);
+}
 
-    // Warmup malloc too
-    for (size_t i = 0; i < WARMUP_ITERS; i++) {
-        void *p = malloc(64);
-        sink = p;
-        free(p);
+// Same comparison for the pool: pop `batch` blocks one by one or at once, then free them
+static double bench_pool_batch(size_t block_size, size_t batch, int batched, size_t iterations) {
+    PoolAllocator pool;
+    pool_allocator_init(&pool);
+    pool_allocator_create(&pool, block_size, batch);
+
+    void **out = malloc(batch * sizeof(void *));
+    if (!out) return 0;
+
+    // Thread every block onto the free list so both variants pop recycled blocks
+    pool_allocator_alloc_batch(&pool, batch, out);
+    for (size_t i = 0; i < batch; i++) {
+        pool_allocator_free(&pool, out[i]);
     }
-}
 
-int main(void) {
-    printf("\n");
-    printf("╔════════════════════════════════════════════════════════════╗\n");
-    printf("║          Simple Memory Allocator Benchmark                 ║\n");
-    printf("╚════════════════════════════════════════════════════════════╝\n");
+    BenchTimer timer;
+    size_t total_allocs = 0;
 
-    printf("\nWarming up...\n");
-    warmup();
+    bench_start(&timer);
 
-    // Allocation sizes to benchmark
-    size_t sizes[] = {8, 16, 32, 64, 128, 256, 512, 1024, 4096};
-    size_t num_sizes = sizeof(sizes) / sizeof(sizes[0]);
+    while (total_allocs < iterations) {
+        if (batched) {
+            pool_allocator_alloc_batch(&pool, batch, out);
+        } else {
+            for (size_t i = 0; i < batch; i++) {
+                out[i] = pool_allocator_alloc(&pool);
+            }
+        }
+        sink = out[batch - 1];
+        for (size_t i = 0; i < batch; i++) {
+            pool_allocator_free(&pool, out[i]);
+        }
+        total_allocs += batch;
+    }
 
-    printf("\n▸ Allocation Throughput (%d iterations)\n", ITERATIONS);
-    printf("  %-8s %14s %14s %10s\n", "Size", "Bump/s", "malloc/s", "Speedup");
+    bench_end(&timer);
+
+    free(out);
+    pool_allocator_destroy(&pool);
+    return bench_ops_per_sec(&timer, total_allocs);
+}
+
+static void bench_batches(void) {
+    size_t batches[] = {8, 64, 512};
+
+    printf("  %-14s %14s %14s %10s\n", "Batch", "Single/s", "Batched/s", "Speedup");
     printf("  ─────────────────────────────────────────────────────\n");
 
-    for (size_t i = 0; i < num_sizes; i++) {
-        size_t size = sizes[i];
+    for (size_t i = 0; i < sizeof(batches) / sizeof(batches[0]); i++) {
+        size_t batch = batches[i];
+        char label[32], single_str[32], batched_str[32];
 
-        double bump_ops = bench_bump_alloc(size, ITERATIONS);
-        double malloc_ops = bench_malloc_alloc(size, ITERATIONS);
-        double speedup = bump_ops / malloc_ops;
+        double single = bench_bump_batch(32, batch, 0, ITERATIONS);
+        double batched = bench_bump_batch(32, batch, 1, ITERATIONS);
+        format_number(single, single_str, sizeof(single_str));
+        format_number(batched, batched_str, sizeof(batched_str));
+        snprintf(label, sizeof(label), "bump x%zu", batch);
+        printf("  %-14s %14s %14s %9.1fx\n", label, single_str, batched_str, batched / single);
 
-        char bump_str[32], malloc_str[32];
-        format_number(bump_ops, bump_str, sizeof(bump_str));
-        format_number(malloc_ops, malloc_str, sizeof(malloc_str));
+        single = bench_pool_batch(32, batch, 0, ITERATIONS);
+        batched = bench_pool_batch(32, batch, 1, ITERATIONS);
+        format_number(single, single_str, sizeof(single_str));
+        format_number(batched, batched_str, sizeof(batched_str));
+        snprintf(label, sizeof(label), "pool x%zu", batch);
+        printf("  %-14s %14s %14s %9.1fx\n", label, single_str, batched_str, batched / single);
+    }
+}
 
-        printf("  %-8zu %14s %14s %9.1fx\n", size, bump_str, malloc_str, speedup);
+// Shared state for the multithreaded benchmarks
+typedef struct {
+    ConcurrentMemoryAllocator concurrent;
+    SimpleMemoryAllocator locked;
+    pthread_mutex_t lock;
+    pthread_barrier_t barrier;
+    size_t allocs_per_thread;
+    size_t alloc_size;
+} ThreadBench;
+
+static void *concurrent_alloc_thread(void *arg) {
+    ThreadBench *bench = arg;
+    pthread_barrier_wait(&bench->barrier);
+    for (size_t i = 0; i < bench->allocs_per_thread; i++) {
+        sink = concurrent_memory_allocator_alloc(&bench->concurrent, bench->alloc_size);
+    }
+    return NULL;
+}
+
+static void *cached_alloc_thread(void *arg) {
+    ThreadBench *bench = arg;
+    ThreadCacheAllocator cache;
+    thread_cache_allocator_init(&cache, &bench->concurrent, 0);
+    pthread_barrier_wait(&bench->barrier);
+    for (size_t i = 0; i < bench->allocs_per_thread; i++) {
+        sink = thread_cache_allocator_alloc(&cache, bench->alloc_size);
+    }
+    return NULL;
+}
+
+static void *locked_alloc_thread(void *arg) {
+    ThreadBench *bench = arg;
+    pthread_barrier_wait(&bench->barrier);
+    for (size_t i = 0; i < bench->allocs_per_thread; i++) {
+        pthread_mutex_lock(&bench->lock);
+        sink = simple_memory_allocator_alloc(&bench->locked, bench->alloc_size);
+        pthread_mutex_unlock(&bench->lock);
+    }
+    return NULL;
+}
+
+// Run `thread_count` threads and return aggregate ops/s
+static double run_threads(ThreadBench *bench, size_t thread_count, void *(*fn)(void *)) {
+    pthread_t threads[MAX_THREADS];
+    BenchTimer timer;
+
+    pthread_barrier_init(&bench->barrier, NULL, (unsigned)thread_count + 1);
+    for (size_t t = 0; t < thread_count; t++) {
+        pthread_create(&threads[t], NULL, fn, bench);
+    }
+
+    pthread_barrier_wait(&bench->barrier);
+    bench_start(&timer);
+    for (size_t t = 0; t < thread_count; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    bench_end(&timer);
+    pthread_barrier_destroy(&bench->barrier);
+
+    return bench_ops_per_sec(&timer, bench->allocs_per_thread * thread_count);
+}
+
+// Multithreaded scaling: thread caches vs lock-free bump vs mutex-wrapped bump
+// Total work is fixed so the pool never needs a reset mid-run
+static void bench_thread_scaling(size_t alloc_size) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t max_threads = cpus > 0 ? (size_t)cpus : 1;
+    if (max_threads > MAX_THREADS) {
+        max_threads = MAX_THREADS;
     }
 
+    ThreadBench bench;
+    concurrent_memory_allocator_init(&bench.concurrent);
+    simple_memory_allocator_init(&bench.locked);
+    concurrent_memory_allocator_create(&bench.concurrent, POOL_SIZE);
+    simple_memory_allocator_create(&bench.locked, POOL_SIZE);
+    pthread_mutex_init(&bench.lock, NULL);
+    bench.alloc_size = alloc_size;
+
+    printf("\n▸ Thread Scaling (%zu-byte allocs, %d total per run)\n", alloc_size, ITERATIONS);
+    printf("  %-8s %14s %14s %14s %10s\n", "Threads", "Cached/s", "Atomic/s", "Mutex/s", "Speedup");
+    printf("  ────────────────────────────────────────────────────────────────────\n");
+
+    for (size_t threads = 1;; threads *= 2) {
+        if (threads > max_threads) {
+            threads = max_threads;
+        }
+        bench.allocs_per_thread = ITERATIONS / threads;
+
+        double cached_ops = run_threads(&bench, threads, cached_alloc_thread);
+        concurrent_memory_allocator_reset(&bench.concurrent);
+        double atomic_ops = run_threads(&bench, threads, concurrent_alloc_thread);
+        concurrent_memory_allocator_reset(&bench.concurrent);
+        double mutex_ops = run_threads(&bench, threads, locked_alloc_thread);
+        simple_memory_allocator_reset(&bench.locked);
+
+        char cached_str[32], atomic_str[32], mutex_str[32];
+        format_number(cached_ops, cached_str, sizeof(cached_str));
+        format_number(atomic_ops, atomic_str, sizeof(atomic_str));
+        format_number(mutex_ops, mutex_str, sizeof(mutex_str));
+
+        // Speedup of the best lock-free path over the mutex
+        double best_ops = cached_ops > atomic_ops ? cached_ops : atomic_ops;
+        printf("  %-8zu %14s %14s %14s %9.1fx\n", threads, cached_str, atomic_str, mutex_str, best_ops / mutex_ops);
+
+        if (threads == max_threads) {
+            break;
+        }
+    }
+
+    pthread_mutex_destroy(&bench.lock);
+    simple_memory_allocator_destroy(&bench.locked);
+    concurrent_memory_allocator_destroy(&bench.concurrent);
+}
+
+#define NUMA_BENCH_BYTES  (32 * 1024 * 1024)
+#define NUMA_BENCH_PASSES 8
+
+typedef struct {
+    NumaArenaGroup *group;
+    int cpu_node;
+    int mem_node;
+    double read_gbps;
+    double write_gbps;
+} NumaBench;
+
+// Pin to the first CPU of cpu_node and stream over a buffer from mem_node
+static void *numa_bandwidth_thread(void *arg) {
+    NumaBench *bench = arg;
+    bench->read_gbps = 0.0;
+    bench->write_gbps = 0.0;
+
+    int cpu = numa_arena_group_node_cpu(bench->cpu_node);
+    if (cpu < 0 || latency_pin_cpu(cpu) != 0) {
+        return NULL;
+    }
+
+    uint64_t *buf = numa_arena_group_alloc_on(bench->group, bench->mem_node, NUMA_BENCH_BYTES);
+    if (buf == NULL) {
+        return NULL;
+    }
+    size_t words = NUMA_BENCH_BYTES / sizeof(uint64_t);
+    memset(buf, 1, NUMA_BENCH_BYTES);  // Fault in (placement is fixed by the node binding)
+
+    BenchTimer timer;
+    double gb = (double)NUMA_BENCH_BYTES * NUMA_BENCH_PASSES / (1024.0 * 1024.0 * 1024.0);
+
+    bench_start(&timer);
+    for (int pass = 0; pass < NUMA_BENCH_PASSES; pass++) {
+        memset(buf, pass, NUMA_BENCH_BYTES);
+    }
+    bench_end(&timer);
+    bench->write_gbps = gb / (bench_elapsed_ns(&timer) / 1e9);
+
+    uint64_t sum = 0;
+    bench_start(&timer);
+    for (int pass = 0; pass < NUMA_BENCH_PASSES; pass++) {
+        __asm__ volatile("" : : "r"(buf) : "memory");  // Forget the memset contents
+        for (size_t i = 0; i < words; i++) {
+            sum += buf[i];
+        }
+    }
+    bench_end(&timer);
+    bench->read_gbps = gb / (bench_elapsed_ns(&timer) / 1e9);
+    sink = (void *)(uintptr_t)sum;
+
+    return NULL;
+}
+
+// Access bandwidth from every node's CPUs to every node's arena
+static void bench_numa_bandwidth(void) {
+    NumaArenaGroup group;
+    numa_arena_group_init(&group);
+    if (numa_arena_group_create(&group, NUMA_BENCH_BYTES + 4096, NULL) != 0) {
+        printf("  NUMA arena group unavailable\n");
+        return;
+    }
+
+    printf("\n  Node Bandwidth (%d MB buffer, %d passes, %d node%s)\n", NUMA_BENCH_BYTES / (1024 * 1024),
+           NUMA_BENCH_PASSES, group.node_count, group.node_count == 1 ? "" : "s");
+    printf("  %-10s %-10s %-8s %12s %12s\n", "CPU node", "Mem node", "Access", "Read GB/s", "Write GB/s");
+
+    for (int cpu_node = 0; cpu_node < NUMA_ARENA_GROUP_MAX_NODES; cpu_node++) {
+        if (!group.online[cpu_node]) {
+            continue;
+        }
+        for (int mem_node = 0; mem_node < NUMA_ARENA_GROUP_MAX_NODES; mem_node++) {
+            if (!group.online[mem_node]) {
+                continue;
+            }
+            NumaBench bench = {&group, cpu_node, mem_node, 0.0, 0.0};
+            pthread_t thread;
+            pthread_create(&thread, NULL, numa_bandwidth_thread, &bench);
+            pthread_join(thread, NULL);
+            numa_arena_group_reset(&group);
+
+            printf("  %-10d %-10d %-8s %12.2f %12.2f\n", cpu_node, mem_node,
+                   cpu_node == mem_node ? "local" : "remote", bench.read_gbps, bench.write_gbps);
+        }
+    }
+    if (group.node_count == 1) {
+        printf("  (single node: no remote pairs to measure)\n");
+    }
+
+    numa_arena_group_destroy(&group);
+}
+
+#define SHARED_POOL_HELD 64
+
+typedef struct {
+    PoolAllocator locked;
+    pthread_mutex_t lock;
+    ConcurrentPoolAllocator lock_free;
+    pthread_barrier_t barrier;
+    size_t rounds;
+    int mode;  // 0 = mutex pool, 1 = Treiber free list, 2 = magazines
+} SharedPoolBench;
+
+// Each round takes SHARED_POOL_HELD blocks, then returns them
+static void *shared_pool_thread(void *arg) {
+    SharedPoolBench *bench = arg;
+    ConcurrentPoolMagazine mag;
+    concurrent_pool_magazine_init(&mag, &bench->lock_free, 0);
+    void *held[SHARED_POOL_HELD];
+
+    pthread_barrier_wait(&bench->barrier);
+    for (size_t round = 0; round < bench->rounds; round++) {
+        for (int i = 0; i < SHARED_POOL_HELD; i++) {
+            if (bench->mode == 0) {
+                pthread_mutex_lock(&bench->lock);
+                held[i] = pool_allocator_alloc(&bench->locked);
+                pthread_mutex_unlock(&bench->lock);
+            } else if (bench->mode == 1) {
+                held[i] = concurrent_pool_allocator_alloc(&bench->lock_free);
+            } else {
+                held[i] = concurrent_pool_magazine_alloc(&mag);
+            }
+        }
+        for (int i = 0; i < SHARED_POOL_HELD; i++) {
+            if (bench->mode == 0) {
+                pthread_mutex_lock(&bench->lock);
+                pool_allocator_free(&bench->locked, held[i]);
+                pthread_mutex_unlock(&bench->lock);
+            } else if (bench->mode == 1) {
+                concurrent_pool_allocator_free(&bench->lock_free, held[i]);
+            } else {
+                concurrent_pool_magazine_free(&mag, held[i]);
+            }
+        }
+    }
+    concurrent_pool_magazine_flush(&mag);
+    return NULL;
+}
+
+// Run one mode on `thread_count` threads and return alloc+free pairs per second
+static double run_shared_pool(SharedPoolBench *bench, size_t thread_count, int mode) {
+    pthread_t threads[MAX_THREADS];
+    BenchTimer timer;
+
+    bench->mode = mode;
+    pthread_barrier_init(&bench->barrier, NULL, (unsigned)thread_count + 1);
+    for (size_t t = 0; t < thread_count; t++) {
+        pthread_create(&threads[t], NULL, shared_pool_thread, bench);
+    }
+    pthread_barrier_wait(&bench->barrier);
+    bench_start(&timer);
+    for (size_t t = 0; t < thread_count; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    bench_end(&timer);
+    pthread_barrier_destroy(&bench->barrier);
+
+    return bench_ops_per_sec(&timer, bench->rounds * SHARED_POOL_HELD * thread_count);
+}
+
+// One pool shared by all threads: mutex vs lock-free stack vs magazines
+static void bench_shared_pool(size_t block_size) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t max_threads = cpus > 0 ? (size_t)cpus : 1;
+    if (max_threads > MAX_THREADS) {
+        max_threads = MAX_THREADS;
+    }
+
+    // Magazines can park up to a full magazine per thread on top of what is held
+    size_t blocks = MAX_THREADS * (SHARED_POOL_HELD + CONCURRENT_POOL_MAGAZINE_MAX);
+    SharedPoolBench bench;
+    pool_allocator_init(&bench.locked);
+    pool_allocator_create(&bench.locked, block_size, blocks);
+    pthread_mutex_init(&bench.lock, NULL);
+    concurrent_pool_allocator_init(&bench.lock_free);
+    concurrent_pool_allocator_create(&bench.lock_free, block_size, blocks);
+
+    printf("\n  Shared Pool (%zu-byte blocks, %d held per thread, alloc+free pairs/s)\n", block_size,
+           SHARED_POOL_HELD);
+    printf("  %-8s %14s %14s %14s %10s\n", "Threads", "Mutex/s", "Lock-free/s", "Magazine/s", "Speedup");
+
+    for (size_t threads = 1;; threads *= 2) {
+        if (threads > max_threads) {
+            threads = max_threads;
+        }
+        bench.rounds = ITERATIONS / SHARED_POOL_HELD / threads;
+
+        double mutex_ops = run_shared_pool(&bench, threads, 0);
+        double lock_free_ops = run_shared_pool(&bench, threads, 1);
+        double magazine_ops = run_shared_pool(&bench, threads, 2);
+
+        char mutex_str[32], lock_free_str[32], magazine_str[32];
+        format_number(mutex_ops, mutex_str, sizeof(mutex_str));
+        format_number(lock_free_ops, lock_free_str, sizeof(lock_free_str));
+        format_number(magazine_ops, magazine_str, sizeof(magazine_str));
+        printf("  %-8zu %14s %14s %14s %9.1fx\n", threads, mutex_str, lock_free_str, magazine_str,
+               magazine_ops / mutex_ops);
+
+        if (threads == max_threads) {
+            break;
+        }
+    }
+
+    concurrent_pool_allocator_destroy(&bench.lock_free);
+    pthread_mutex_destroy(&bench.lock);
+    pool_allocator_destroy(&bench.locked);
+}
+
+#define HANDOFF_RING 256
+
+// Single-producer single-consumer ring carrying blocks to one consumer
+typedef struct {
+    void *slots[HANDOFF_RING];
+    _Alignas(64) _Atomic size_t head;  // Advanced by the consumer
+    _Alignas(64) _Atomic size_t tail;  // Advanced by the producer
+} HandoffRing;
+
+typedef struct {
+    PoolAllocator locked;
+    pthread_mutex_t lock;
+    ConcurrentPoolAllocator lock_free;
+    OwnedPoolAllocator owned;
+    HandoffRing rings[MAX_THREADS];
+    size_t consumers;
+    size_t messages;
+    int mode;  // 0 = mutex pool, 1 = Treiber free list, 2 = owned pool with remote frees
+} HandoffBench;
+
+typedef struct {
+    HandoffBench *bench;
+    HandoffRing *ring;
+} HandoffConsumer;
+
+static void handoff_push(HandoffRing *ring, void *ptr) {
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    while (tail - atomic_load_explicit(&ring->head, memory_order_acquire) == HANDOFF_RING) {
+        sched_yield();
+    }
+    ring->slots[tail % HANDOFF_RING] = ptr;
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+}
+
+static void *handoff_pop(HandoffRing *ring) {
+    size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    while (atomic_load_explicit(&ring->tail, memory_order_acquire) == head) {
+        sched_yield();
+    }
+    void *ptr = ring->slots[head % HANDOFF_RING];
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+    return ptr;
+}
+
+// Producer: allocates every message and deals them round-robin, then sends NULL to stop
+static void *handoff_producer(void *arg) {
+    HandoffBench *bench = arg;
+    owned_pool_allocator_set_owner(&bench->owned, pthread_self());
+
+    for (size_t i = 0; i < bench->messages; i++) {
+        void *block;
+        for (;;) {
+            if (bench->mode == 0) {
+                pthread_mutex_lock(&bench->lock);
+                block = pool_allocator_alloc(&bench->locked);
+                pthread_mutex_unlock(&bench->lock);
+            } else if (bench->mode == 1) {
+                block = concurrent_pool_allocator_alloc(&bench->lock_free);
+            } else {
+                block = owned_pool_allocator_alloc(&bench->owned);
+            }
+            if (block != NULL) {
+                break;
+            }
+            sched_yield();  // Every block is in flight; wait for consumers to free some
+        }
+        *(size_t *)block = i;
+        handoff_push(&bench->rings[i % bench->consumers], block);
+    }
+    for (size_t c = 0; c < bench->consumers; c++) {
+        handoff_push(&bench->rings[c], NULL);
+    }
+    return NULL;
+}
+
+// Consumer: frees every block it receives, from a thread that does not own the pool
+static void *handoff_consumer(void *arg) {
+    HandoffConsumer *consumer = arg;
+    HandoffBench *bench = consumer->bench;
+    void *block;
+
+    while ((block = handoff_pop(consumer->ring)) != NULL) {
+        sink = block;
+        if (bench->mode == 0) {
+            pthread_mutex_lock(&bench->lock);
+            pool_allocator_free(&bench->locked, block);
+            pthread_mutex_unlock(&bench->lock);
+        } else if (bench->mode == 1) {
+            concurrent_pool_allocator_free(&bench->lock_free, block);
+        } else {
+            owned_pool_allocator_free_remote(&bench->owned, block);
+        }
+    }
+    return NULL;
+}
+
+// Run one mode with a producer and `consumers` consumers, return messages per second
+static double run_handoff(HandoffBench *bench, size_t consumers, int mode) {
+    pthread_t producer;
+    pthread_t threads[MAX_THREADS];
+    HandoffConsumer args[MAX_THREADS];
+    BenchTimer timer;
+
+    bench->mode = mode;
+    bench->consumers = consumers;
+    for (size_t c = 0; c < consumers; c++) {
+        atomic_store(&bench->rings[c].head, 0);
+        atomic_store(&bench->rings[c].tail, 0);
+        args[c] = (HandoffConsumer){bench, &bench->rings[c]};
+    }
+
+    bench_start(&timer);
+    for (size_t c = 0; c < consumers; c++) {
+        pthread_create(&threads[c], NULL, handoff_consumer, &args[c]);
+    }
+    pthread_create(&producer, NULL, handoff_producer, bench);
+    pthread_join(producer, NULL);
+    for (size_t c = 0; c < consumers; c++) {
+        pthread_join(threads[c], NULL);
+    }
+    bench_end(&timer);
+
+    return bench_ops_per_sec(&timer, bench->messages);
+}
+
+// Producer/consumer: blocks allocated on one thread and freed on others
+static void bench_handoff(size_t block_size) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t max_consumers = cpus > 1 ? (size_t)cpus - 1 : 1;
+    if (max_consumers > MAX_THREADS) {
+        max_consumers = MAX_THREADS;
+    }
+
+    // Spare capacity beyond one ring, so the owned pool has to prefer queued
+    // remote frees over fresh blocks; with more consumers the producer can
+    // still run the pool empty and exercise that path
+    size_t blocks = HANDOFF_RING * 4;
+    HandoffBench *bench = malloc(sizeof(*bench));
+    if (bench == NULL) {
+        return;
+    }
+    pool_allocator_init(&bench->locked);
+    pool_allocator_create(&bench->locked, block_size, blocks);
+    pthread_mutex_init(&bench->lock, NULL);
+    concurrent_pool_allocator_init(&bench->lock_free);
+    concurrent_pool_allocator_create(&bench->lock_free, block_size, blocks);
+    owned_pool_allocator_init(&bench->owned);
+    owned_pool_allocator_create(&bench->owned, block_size, blocks);
+    bench->messages = ITERATIONS;
+
+    printf("\n  Producer/Consumer (%zu-byte blocks, 1 producer, frees on consumers, msgs/s)\n", block_size);
+    printf("  %-10s %14s %14s %14s %10s\n", "Consumers", "Mutex/s", "Lock-free/s", "Owned/s", "Speedup");
+
+    for (size_t consumers = 1;; consumers *= 2) {
+        if (consumers > max_consumers) {
+            consumers = max_consumers;
+        }
+
+        double mutex_ops = run_handoff(bench, consumers, 0);
+        double lock_free_ops = run_handoff(bench, consumers, 1);
+        double owned_ops = run_handoff(bench, consumers, 2);
+
+        char mutex_str[32], lock_free_str[32], owned_str[32];
+        format_number(mutex_ops, mutex_str, sizeof(mutex_str));
+        format_number(lock_free_ops, lock_free_str, sizeof(lock_free_str));
+        format_number(owned_ops, owned_str, sizeof(owned_str));
+        printf("  %-10zu %14s %14s %14s %9.1fx\n", consumers, mutex_str, lock_free_str, owned_str,
+               owned_ops / mutex_ops);
+
+        if (consumers == max_consumers) {
+            break;
+        }
+    }
+
+    owned_pool_allocator_destroy(&bench->owned);
+    concurrent_pool_allocator_destroy(&bench->lock_free);
+    pthread_mutex_destroy(&bench->lock);
+    pool_allocator_destroy(&bench->locked);
+    free(bench);
+}
+
+// Pool startup: lazy production pool vs eagerly threaded tutorial pool
+// Both time creation plus the first allocation on fresh memory
+static void bench_pool_startup(size_t block_size, size_t block_count) {
+    BenchTimer timer;
+
+    bench_start(&timer);
+    PoolAllocator pool;
+    pool_allocator_init(&pool);
+    pool_allocator_create(&pool, block_size, block_count);
+    sink = pool_allocator_alloc(&pool);
+    bench_end(&timer);
+    double lazy_ms = bench_elapsed_ns(&timer) / 1e6;
+    pool_allocator_destroy(&pool);
+
+    bench_start(&timer);
+    void *memory = malloc(block_size * block_count);
+    void *tutorial = tutorial_pool_create(memory, block_size, block_count);
+    sink = tutorial_pool_alloc(tutorial);
+    bench_end(&timer);
+    double eager_ms = bench_elapsed_ns(&timer) / 1e6;
+    tutorial_pool_destroy(tutorial);
+    free(memory);
+
+    printf("\n  Pool Startup (%zu blocks of %zu bytes)\n", block_count, block_size);
+    printf("  %-30s %12.3f ms\n", "Lazy (pool_allocator)", lazy_ms);
+    printf("  %-30s %12.3f ms\n", "Eager (tutorial pool_init)", eager_ms);
+    printf("  %-30s %12.1fx faster\n", "Speedup", eager_ms / lazy_ms);
+}
+
+// Pool alloc/free throughput vs malloc/free
+static void bench_pool_alloc_free(size_t block_size, size_t iterations) {
+    size_t live = 1024;
+    void **ptrs = malloc(live * sizeof(void *));
+    if (!ptrs) return;
+
+    PoolAllocator pool;
+    pool_allocator_init(&pool);
+    pool_allocator_create(&pool, block_size, live);
+
+    BenchTimer timer;
+
+    bench_start(&timer);
+    for (size_t i = 0; i < iterations; i += live) {
+        for (size_t j = 0; j < live; j++) {
+            ptrs[j] = pool_allocator_alloc(&pool);
+        }
+        for (size_t j = 0; j < live; j++) {
+            pool_allocator_free(&pool, ptrs[j]);
+        }
+    }
+    bench_end(&timer);
+    double pool_ops = bench_ops_per_sec(&timer, iterations);
+    pool_allocator_destroy(&pool);
+
+    bench_start(&timer);
+    for (size_t i = 0; i < iterations; i += live) {
+        for (size_t j = 0; j < live; j++) {
+            ptrs[j] = malloc(block_size);
+            sink = ptrs[j];
+        }
+        for (size_t j = 0; j < live; j++) {
+            free(ptrs[j]);
+        }
+    }
+    bench_end(&timer);
+    double malloc_ops = bench_ops_per_sec(&timer, iterations);
+    free(ptrs);
+
+    char pool_str[32], malloc_str[32];
+    format_number(pool_ops, pool_str, sizeof(pool_str));
+    format_number(malloc_ops, malloc_str, sizeof(malloc_str));
+
+    printf("\n  Pool Alloc+Free (%zu-byte blocks, %zu live)\n", block_size, live);
+    printf("  %-30s %12s ops/s\n", "pool_allocator", pool_str);
+    printf("  %-30s %12s ops/s\n", "malloc/free", malloc_str);
+    printf("  %-30s %12.1fx faster\n", "Speedup", pool_ops / malloc_ops);
+}
+
+// Deterministic xorshift PRNG so every allocator sees the same workload
+static inline uint64_t bench_rand(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+// Mixed workload: 95% small sizes (8..2048), 5% large (2K..16K)
+static size_t mixed_size(uint64_t *state) {
+    uint64_t r = bench_rand(state);
+    if (r % 100 < 95) {
+        return 8 + (size_t)((r >> 8) % 2041);
+    }
+    return 2049 + (size_t)((r >> 8) % (14 * 1024));
+}
+
+typedef struct {
+    const char *name;
+    void *(*alloc)(void *ctx, size_t size);
+    void (*free)(void *ctx, void *ptr);
+    void *ctx;
+    double (*fragmentation)(void *ctx);  // Optional, sampled before teardown
+    double last_fragmentation;
+} MixedAllocator;
+
+static void *mixed_size_class_alloc(void *ctx, size_t size) { return size_class_allocator_alloc(ctx, size); }
+static void mixed_size_class_free(void *ctx, void *ptr) { size_class_allocator_free(ctx, ptr); }
+static void *mixed_first_fit_alloc(void *ctx, size_t size) { return tutorial_freelist_alloc(ctx, size); }
+static void mixed_first_fit_free(void *ctx, void *ptr) { tutorial_freelist_free(ctx, ptr); }
+static void *mixed_tlsf_alloc(void *ctx, size_t size) { return freelist_alloc(ctx, size); }
+static void mixed_tlsf_free(void *ctx, void *ptr) { freelist_free(ctx, ptr); }
+static double mixed_tlsf_fragmentation(void *ctx) { return freelist_fragmentation(ctx); }
+static void *mixed_malloc_alloc(void *ctx, size_t size) { (void)ctx; return malloc(size); }
+static void mixed_malloc_free(void *ctx, void *ptr) { (void)ctx; free(ptr); }
+
+// Random alloc/free churn over a fixed number of live slots
+// Returns ops/s, counting each alloc and each free as one op
+static double run_mixed(MixedAllocator *allocator, size_t slots, size_t steps) {
+    void **live = calloc(slots, sizeof(void *));
+    if (!live) return 0;
+
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+    size_t ops = 0;
+    BenchTimer timer;
+
+    bench_start(&timer);
+    for (size_t i = 0; i < steps; i++) {
+        size_t slot = (size_t)(bench_rand(&state) % slots);
+        if (live[slot] != NULL) {
+            allocator->free(allocator->ctx, live[slot]);
+            ops++;
+        }
+        live[slot] = allocator->alloc(allocator->ctx, mixed_size(&state));
+        sink = live[slot];
+        ops++;
+    }
+    bench_end(&timer);
+
+    if (allocator->fragmentation != NULL) {
+        allocator->last_fragmentation = allocator->fragmentation(allocator->ctx);
+    }
+
+    for (size_t i = 0; i < slots; i++) {
+        if (live[i] != NULL) {
+            allocator->free(allocator->ctx, live[i]);
+        }
+    }
+    free(live);
+
+    return bench_ops_per_sec(&timer, ops);
+}
+
+// Size classes, binned good-fit and first-fit free lists, and malloc on the
+// same mixed trace; free lists also report fragmentation at the end
+static void bench_mixed_sizes(void) {
+    size_t slots = 4096;
+    size_t steps = ITERATIONS;
+    size_t heap_size = 64 * 1024 * 1024;
+
+    SizeClassAllocator size_class;
+    size_class_allocator_init(&size_class);
+    size_class_allocator_create(&size_class, 4 * 1024 * 1024, heap_size);
+
+    void *tlsf_memory = malloc(heap_size);
+    FreeListAllocator tlsf;
+    freelist_init(&tlsf, tlsf_memory, heap_size);
+
+    void *first_fit_memory = malloc(heap_size);
+    void *first_fit = tutorial_freelist_create(first_fit_memory, heap_size);
+
+    MixedAllocator allocators[] = {
+        {"Size classes", mixed_size_class_alloc, mixed_size_class_free, &size_class, NULL, 0},
+        {"Binned free list (TLSF)", mixed_tlsf_alloc, mixed_tlsf_free, &tlsf, mixed_tlsf_fragmentation, 0},
+        {"First-fit free list", mixed_first_fit_alloc, mixed_first_fit_free, first_fit,
+         tutorial_freelist_fragmentation, 0},
+        {"malloc/free", mixed_malloc_alloc, mixed_malloc_free, NULL, NULL, 0},
+    };
+
+    printf("\n  Mixed Sizes (%zu live slots, %zu steps, 95%% <= 2 KB)\n", slots, steps);
+    printf("  %-30s %12s %14s\n", "Allocator", "ops/s", "Fragmentation");
+    for (size_t i = 0; i < sizeof(allocators) / sizeof(allocators[0]); i++) {
+        char ops_str[32];
+        format_number(run_mixed(&allocators[i], slots, steps), ops_str, sizeof(ops_str));
+        if (allocators[i].fragmentation != NULL) {
+            printf("  %-30s %12s %13.1f%%\n", allocators[i].name, ops_str, allocators[i].last_fragmentation * 100.0);
+        } else {
+            printf("  %-30s %12s %14s\n", allocators[i].name, ops_str, "-");
+        }
+    }
+
+    tutorial_freelist_destroy(first_fit);
+    free(first_fit_memory);
+    free(tlsf_memory);
+    size_class_allocator_destroy(&size_class);
+}
+
+// Fill a heap with `count` random-size blocks, then time freeing them in
+// random order. Returns frees per second.
+static double run_random_free(void *(*alloc)(void *, size_t), void (*release)(void *, void *),
+                              void *ctx, size_t count) {
+    void **ptrs = malloc(count * sizeof(void *));
+    if (!ptrs) return 0;
+
+    uint64_t state = 0x2545F4914F6CDD1Dull;
+    for (size_t i = 0; i < count; i++) {
+        ptrs[i] = alloc(ctx, 16 + (size_t)(bench_rand(&state) % 497));
+    }
+
+    // Fisher-Yates shuffle
+    for (size_t i = count - 1; i > 0; i--) {
+        size_t j = (size_t)(bench_rand(&state) % (i + 1));
+        void *tmp = ptrs[i];
+        ptrs[i] = ptrs[j];
+        ptrs[j] = tmp;
+    }
+
+    BenchTimer timer;
+    bench_start(&timer);
+    for (size_t i = 0; i < count; i++) {
+        release(ctx, ptrs[i]);
+    }
+    bench_end(&timer);
+
+    free(ptrs);
+    return bench_ops_per_sec(&timer, count);
+}
+
+static void *boundary_tag_alloc(void *ctx, size_t size) { return freelist_alloc(ctx, size); }
+static void boundary_tag_free(void *ctx, void *ptr) { freelist_free(ctx, ptr); }
+
+// Random-order free: O(1) boundary-tag coalescing vs address-ordered insert
+static void bench_random_free(size_t count) {
+    size_t heap_size = count * 1024;
+    void *memory = malloc(heap_size);
+    if (!memory) return;
+
+    FreeListAllocator boundary_tag;
+    freelist_init(&boundary_tag, memory, heap_size);
+    double tag_ops = run_random_free(boundary_tag_alloc, boundary_tag_free, &boundary_tag, count);
+
+    void *first_fit = tutorial_freelist_create(memory, heap_size);
+    double sorted_ops = run_random_free(mixed_first_fit_alloc, mixed_first_fit_free, first_fit, count);
+    tutorial_freelist_destroy(first_fit);
+    free(memory);
+
+    char tag_str[32], sorted_str[32];
+    format_number(tag_ops, tag_str, sizeof(tag_str));
+    format_number(sorted_ops, sorted_str, sizeof(sorted_str));
+
+    printf("\n  Random-Order Free (%zu blocks, 16..512 bytes)\n", count);
+    printf("  %-30s %12s frees/s\n", "Binned boundary tags (TLSF)", tag_str);
+    printf("  %-30s %12s frees/s\n", "Address-ordered (tutorial)", sorted_str);
+    printf("  %-30s %12.1fx faster\n", "Speedup", tag_ops / sorted_ops);
+}
+
+// Build `arrays` dynamic arrays of `elements` ints with capacity doubling,
+// growing via realloc (in_place) or alloc+memcpy; returns arrays/s and the
+// arena footprint through *footprint
+static double run_append_growth(int in_place, size_t arrays, size_t elements, size_t *footprint) {
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    simple_memory_allocator_create(&alloc, POOL_SIZE);
+
+    BenchTimer timer;
+    bench_start(&timer);
+
+    for (size_t a = 0; a < arrays; a++) {
+        size_t capacity = 4;
+        int *data = simple_memory_allocator_alloc(&alloc, capacity * sizeof(int));
+        for (size_t i = 0; i < elements; i++) {
+            if (i == capacity) {
+                int *grown;
+                if (in_place) {
+                    grown = simple_memory_allocator_realloc(&alloc, data, capacity * sizeof(int),
+                                                            capacity * 2 * sizeof(int));
+                } else {
+                    grown = simple_memory_allocator_alloc(&alloc, capacity * 2 * sizeof(int));
+                    memcpy(grown, data, capacity * sizeof(int));
+                }
+                data = grown;
+                capacity *= 2;
+            }
+            data[i] = (int)i;
+        }
+        sink = data;
+    }
+
+    bench_end(&timer);
+
+    *footprint = alloc.used;
+    simple_memory_allocator_destroy(&alloc);
+    return bench_ops_per_sec(&timer, arrays);
+}
+
+// In-place growth of the last allocation vs alloc+copy for append-heavy builders
+static void bench_append_growth(size_t elements) {
+    size_t arrays = 10000;
+    size_t copy_bytes, in_place_bytes;
+    double copy_ops = run_append_growth(0, arrays, elements, &copy_bytes);
+    double in_place_ops = run_append_growth(1, arrays, elements, &in_place_bytes);
+
+    char copy_str[32], in_place_str[32];
+    format_number(copy_ops, copy_str, sizeof(copy_str));
+    format_number(in_place_ops, in_place_str, sizeof(in_place_str));
+
+    printf("\n  Append Growth (%zu arrays of %zu ints, capacity doubling)\n", arrays, elements);
+    printf("  %-30s %12s arrays/s %10.2f MB\n", "alloc + memcpy", copy_str, copy_bytes / (1024.0 * 1024.0));
+    printf("  %-30s %12s arrays/s %10.2f MB\n", "realloc (in place)", in_place_str,
+           in_place_bytes / (1024.0 * 1024.0));
+}
+
+// ============================================================================
+// Latency mode (--latency): per-call cycle histograms
+// ============================================================================
+
+typedef struct {
+    int histograms;                 // Print the distribution under each row
+    int perf;                       // Read perf_event counters around each run
+    LatencyPerfCounters counters;
+    uint64_t overhead;              // Empty start/stop pair, subtracted from samples
+    double ticks_per_ns;
+} LatencyConfig;
+
+static void *latency_arena_alloc(void *ctx, size_t size) { return simple_memory_allocator_alloc(ctx, size); }
+static void *latency_cache_alloc(void *ctx, size_t size) { return thread_cache_allocator_alloc(ctx, size); }
+static void *latency_pool_alloc(void *ctx, size_t size) { (void)size; return pool_allocator_alloc(ctx); }
+static void latency_pool_free(void *ctx, void *ptr) { pool_allocator_free(ctx, ptr); }
+
+static inline void latency_sample(LatencyHistogram *h, uint64_t start, uint64_t stop, uint64_t overhead) {
+    uint64_t ticks = stop - start;
+    latency_histogram_record(h, ticks > overhead ? ticks - overhead : 0);
+}
+
+static void print_latency_row(const LatencyConfig *config, const char *name, const char *op,
+                              const LatencyHistogram *h) {
+    char label[64];
+    snprintf(label, sizeof(label), "%s %s", name, op);
+    printf("  %-32s %7llu %7llu %7llu %9llu %8.1f\n", label,
+           (unsigned long long)latency_histogram_percentile(h, 0.50),
+           (unsigned long long)latency_histogram_percentile(h, 0.99),
+           (unsigned long long)latency_histogram_percentile(h, 0.999),
+           (unsigned long long)h->max,
+           h->count != 0 ? (double)h->sum / (double)h->count / config->ticks_per_ns : 0.0);
+    if (config->histograms) {
+        latency_histogram_print(h);
+    }
+}
+
+// Time every alloc (and free) over a ring of live slots; fixed_size = 0 for mixed sizes
+static void run_latency(LatencyConfig *config, const MixedAllocator *allocator, size_t fixed_size) {
+    void **live = calloc(LATENCY_SLOTS, sizeof(void *));
+    LatencyHistogram *alloc_h = malloc(sizeof(LatencyHistogram));
+    LatencyHistogram *free_h = malloc(sizeof(LatencyHistogram));
+    if (!live || !alloc_h || !free_h) {
+        free(live);
+        free(alloc_h);
+        free(free_h);
+        return;
+    }
+
+    latency_histogram_reset(alloc_h);
+    latency_histogram_reset(free_h);
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+
+    if (config->perf) {
+        latency_perf_start(&config->counters);
+    }
+
+    for (size_t i = 0; i < LATENCY_OPS; i++) {
+        size_t slot = i % LATENCY_SLOTS;
+        size_t size = fixed_size != 0 ? fixed_size : mixed_size(&state);
+
+        if (live[slot] != NULL && allocator->free != NULL) {
+            uint64_t start = latency_start();
+            allocator->free(allocator->ctx, live[slot]);
+            uint64_t stop = latency_stop();
+            latency_sample(free_h, start, stop, config->overhead);
+        }
+
+        uint64_t start = latency_start();
+        live[slot] = allocator->alloc(allocator->ctx, size);
+        uint64_t stop = latency_stop();
+        latency_sample(alloc_h, start, stop, config->overhead);
+    }
+
+    if (config->perf) {
+        latency_perf_stop(&config->counters);
+    }
+
+    print_latency_row(config, allocator->name, "alloc", alloc_h);
+    if (allocator->free != NULL) {
+        print_latency_row(config, allocator->name, "free", free_h);
+    }
+
+    if (config->perf) {
+        const int64_t *v = config->counters.values;
+        char cache[16] = "n/a", dtlb[16] = "n/a", faults[16] = "n/a";
+        size_t ops = alloc_h->count + free_h->count;
+        if (v[LATENCY_PERF_CACHE_MISSES] >= 0) {
+            snprintf(cache, sizeof(cache), "%.3f", (double)v[LATENCY_PERF_CACHE_MISSES] / (double)ops);
+        }
+        if (v[LATENCY_PERF_DTLB_MISSES] >= 0) {
+            snprintf(dtlb, sizeof(dtlb), "%.3f", (double)v[LATENCY_PERF_DTLB_MISSES] / (double)ops);
+        }
+        if (v[LATENCY_PERF_PAGE_FAULTS] >= 0) {
+            snprintf(faults, sizeof(faults), "%.3f", (double)v[LATENCY_PERF_PAGE_FAULTS] * 1000.0 / (double)ops);
+        }
+        printf("    per op: cache-misses %s  dTLB-misses %s  page-faults/1K %s\n", cache, dtlb, faults);
+    }
+
+    if (allocator->free != NULL) {
+        for (size_t i = 0; i < LATENCY_SLOTS; i++) {
+            if (live[i] != NULL) {
+                allocator->free(allocator->ctx, live[i]);
+            }
+        }
+    }
+    free(live);
+    free(alloc_h);
+    free(free_h);
+}
+
+static void bench_latency(LatencyConfig *config) {
+    config->overhead = latency_timer_overhead();
+    config->ticks_per_ns = latency_ticks_per_ns();
+
+    printf("\n▸ Per-Operation Latency (%d ops, %s, timer overhead %llu subtracted)\n", LATENCY_OPS,
+           LATENCY_HAVE_TSC ? "cycles" : "ns", (unsigned long long)config->overhead);
+    printf("  %-32s %7s %7s %7s %9s %8s\n", "Allocator", "p50", "p99", "p99.9", "max", "mean ns");
+    printf("  ─────────────────────────────────────────────────────────────────────────\n");
+
+    // Growable arena from a small first block, so chaining spikes show up
+    SimpleMemoryAllocator arena;
+    SimpleMemoryAllocatorOptions options = {.growable = 1};
+    simple_memory_allocator_init(&arena);
+    simple_memory_allocator_create_with_options(&arena, 64 * 1024, &options);
+    MixedAllocator arena_case = {"Bump 64B (growable)", latency_arena_alloc, NULL, &arena, NULL, 0};
+    run_latency(config, &arena_case, 64);
+    simple_memory_allocator_destroy(&arena);
+
+    ConcurrentMemoryAllocator shared;
+    ThreadCacheAllocator cache;
+    concurrent_memory_allocator_init(&shared);
+    concurrent_memory_allocator_create(&shared, 2 * LATENCY_OPS * 64);
+    thread_cache_allocator_init(&cache, &shared, 0);
+    MixedAllocator cache_case = {"Thread cache 64B", latency_cache_alloc, NULL, &cache, NULL, 0};
+    run_latency(config, &cache_case, 64);
+    concurrent_memory_allocator_destroy(&shared);
+
+    PoolAllocator pool;
+    pool_allocator_init(&pool);
+    pool_allocator_create(&pool, 64, LATENCY_SLOTS);
+    MixedAllocator pool_case = {"Pool 64B", latency_pool_alloc, latency_pool_free, &pool, NULL, 0};
+    run_latency(config, &pool_case, 64);
+    pool_allocator_destroy(&pool);
+
+    MixedAllocator malloc_small = {"malloc 64B", mixed_malloc_alloc, mixed_malloc_free, NULL, NULL, 0};
+    run_latency(config, &malloc_small, 64);
+
+    SizeClassAllocator size_class;
+    size_class_allocator_init(&size_class);
+    size_class_allocator_create(&size_class, 16 * 1024 * 1024, 16 * 1024 * 1024);
+    MixedAllocator size_class_case = {"Size classes mixed", mixed_size_class_alloc, mixed_size_class_free,
+                                      &size_class, NULL, 0};
+    run_latency(config, &size_class_case, 0);
+    size_class_allocator_destroy(&size_class);
+
+    size_t heap_size = 16 * 1024 * 1024;
+    void *tlsf_memory = malloc(heap_size);
+    FreeListAllocator tlsf;
+    freelist_init(&tlsf, tlsf_memory, heap_size);
+    MixedAllocator tlsf_case = {"TLSF mixed", mixed_tlsf_alloc, mixed_tlsf_free, &tlsf, NULL, 0};
+    run_latency(config, &tlsf_case, 0);
+    free(tlsf_memory);
+
+    MixedAllocator malloc_mixed = {"malloc mixed", mixed_malloc_alloc, mixed_malloc_free, NULL, NULL, 0};
+    run_latency(config, &malloc_mixed, 0);
+}
+
+// Warmup to stabilize CPU frequency and fill caches
+static void warmup(void) {
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    simple_memory_allocator_create(&alloc, 1024 * 1024);
+
+    for (size_t i = 0; i < WARMUP_ITERS; i++) {
+        sink = simple_memory_allocator_alloc(&alloc, 64);
+        if ((i % 1000) == 0) {
+            simple_memory_allocator_reset(&alloc);
+        }
+    }
+
+    simple_memory_allocator_destroy(&alloc);
+
+    // Warmup malloc too
+    for (size_t i = 0; i < WARMUP_ITERS; i++) {
+        void *p = malloc(64);
+        sink = p;
+        free(p);
+    }
+}
+
+// Usage: bench [--latency [--histogram] [--perf] [--cpu N]]
+int main(int argc, char **argv) {
+    LatencyConfig latency = {0};
+    int latency_mode = 0;
+    int cpu = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--latency") == 0) {
+            latency_mode = 1;
+        } else if (strcmp(argv[i], "--histogram") == 0) {
+            latency.histograms = 1;
+        } else if (strcmp(argv[i], "--perf") == 0) {
+            latency.perf = 1;
+        } else if (strcmp(argv[i], "--cpu") == 0 && i + 1 < argc) {
+            cpu = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "Usage: %s [--latency [--histogram] [--perf] [--cpu N]]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    printf("\n");
+    printf("╔════════════════════════════════════════════════════════════╗\n");
+    printf("║          Simple Memory Allocator Benchmark                 ║\n");
+    printf("╚════════════════════════════════════════════════════════════╝\n");
+
+    if (latency_mode) {
+        if (latency_pin_cpu(cpu) != 0) {
+            printf("\nWarning: could not pin to CPU %d, samples may include migrations\n", cpu);
+        } else {
+            printf("\nPinned to CPU %d\n", cpu);
+        }
+        if (latency.perf && latency_perf_open(&latency.counters) == 0) {
+            printf("Warning: perf_event_open unavailable (check kernel.perf_event_paranoid)\n");
+        }
+
+        printf("\nWarming up...\n");
+        warmup();
+        bench_latency(&latency);
+
+        if (latency.perf) {
+            latency_perf_close(&latency.counters);
+        }
+        printf("\n────────────────────────────────────────────────────────────\n");
+        printf("Benchmark complete.\n");
+        printf("────────────────────────────────────────────────────────────\n\n");
+        return 0;
+    }
+
+    printf("\nWarming up...\n");
+    warmup();
+
+    // Allocation sizes to benchmark
+    size_t sizes[] = {8, 16, 32, 64, 128, 256, 512, 1024, 4096};
+    size_t num_sizes = sizeof(sizes) / sizeof(sizes[0]);
+
+    printf("\n▸ Allocation Throughput (%d iterations)\n", ITERATIONS);
+    printf("  %-8s %14s %14s %10s\n", "Size", "Bump/s", "malloc/s", "Speedup");
+    printf("  ─────────────────────────────────────────────────────\n");
+
+    for (size_t i = 0; i < num_sizes; i++) {
+        size_t size = sizes[i];
+
+        double bump_ops = bench_bump_alloc(size, ITERATIONS);
+        double malloc_ops = bench_malloc_alloc(size, ITERATIONS);
+        double speedup = bump_ops / malloc_ops;
+
+        char bump_str[32], malloc_str[32];
+        format_number(bump_ops, bump_str, sizeof(bump_str));
+        format_number(malloc_ops, malloc_str, sizeof(malloc_str));
+
+        printf("  %-8zu %14s %14s %9.1fx\n", size, bump_str, malloc_str, speedup);
+    }
+
+    // Measured in a TU built without -flto, where alloc() is a real call
+    double call_ops = bench_inline_fast_call(64, POOL_SIZE, ITERATIONS);
+    double inline_ops = bench_inline_fast_inline(64, POOL_SIZE, ITERATIONS);
+    char call_str[32], inline_str[32];
+    format_number(call_ops, call_str, sizeof(call_str));
+    format_number(inline_ops, inline_str, sizeof(inline_str));
+    printf("\n  %-26s %14s\n", "alloc() 64B (no LTO)", call_str);
+    printf("  %-26s %14s %9.1fx\n", "alloc_fast() 64B (inline)", inline_str, inline_ops / call_ops);
+
+    size_t alignments[] = {8, 32, 64, 256};
+    size_t num_alignments = sizeof(alignments) / sizeof(alignments[0]);
+
+    printf("\n▸ Aligned Allocation (64-byte allocs, %d iterations)\n", ITERATIONS);
+    printf("  %-8s %14s %14s %10s\n", "Align", "Bump/s", "aligned/s", "Speedup");
+    printf("  ─────────────────────────────────────────────────────\n");
+
+    for (size_t i = 0; i < num_alignments; i++) {
+        size_t alignment = alignments[i];
+
+        double bump_ops = bench_aligned_alloc(64, alignment, ITERATIONS);
+        double malloc_ops = bench_aligned_malloc(64, alignment, ITERATIONS);
+        double speedup = bump_ops / malloc_ops;
+
+        char bump_str[32], malloc_str[32];
+        format_number(bump_ops, bump_str, sizeof(bump_str));
+        format_number(malloc_ops, malloc_str, sizeof(malloc_str));
+
+        printf("  %-8zu %14s %14s %9.1fx\n", alignment, bump_str, malloc_str, speedup);
+    }
+
+    printf("\n▸ Batch Allocation (32-byte objects, %d iterations)\n", ITERATIONS);
+    bench_batches();
+
+    bench_thread_scaling(16);
+
+    printf("\n▸ NUMA Locality\n");
+    bench_numa_bandwidth();
+
+    printf("\n▸ Pool Allocator\n");
+    bench_pool_startup(64, 4 * 1024 * 1024);
+    bench_pool_alloc_free(64, ITERATIONS);
+    bench_shared_pool(64);
+    bench_handoff(64);
+    bench_mixed_sizes();
+    bench_random_free(20000);
+
     printf("\n▸ Reset vs Recreate\n");
     bench_reset_vs_recreate();
+    bench_child_arenas();
+    bench_reset_decommit();
+    bench_snapshot_startup();
+    bench_append_growth(256);
 
     printf("\n▸ Memory Throughput\n");
     bench_fill_pattern(64);
     bench_fill_pattern(1024);
+    bench_backings();
+    bench_zeroed_alloc(4 * 1024);
+    bench_zeroed_alloc(4 * 1024 * 1024);
 
     printf("\n────────────────────────────────────────────────────────────\n");
     printf("Benchmark complete.\n");
@@ -0,0 +1,848 @@
+/*
+ * Allocation trace replay harness
+ *
+ * Replays a binary trace (see alloc_trace.h) against each allocator and
+ * reports throughput, per-operation latency percentiles and peak RSS.
+ *
+ *   trace_replay                       Replay a built-in synthetic trace
+ *   trace_replay FILE                  Replay a trace recorded by trace_shim.c
+ *   trace_replay --generate FILE [N]   Write a synthetic trace of N allocations
+ *
+ * Records are replayed on one thread in recorded order. Every allocator runs
+ * in its own forked child so peak RSS is measured per allocator: one child
+ * times the whole trace for throughput, a second times each call and touches
+ * every page it is handed so the resident footprint matches a real workload.
+ */
+
+#define _POSIX_C_SOURCE 200809L  // Required for clock_gettime and fork
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include "../src/simple_memory_allocator.h"
+#include "../src/pool_allocator.h"
+#include "../src/freelist_allocator.h"
+#include "alloc_trace.h"
+#include "tutorial_allocators.h"
+
+#define SYNTHETIC_ALLOCS   1000000
+#define SYNTHETIC_LIVE     4096
+#define ARENA_INITIAL_SIZE (1024 * 1024)
+#define PAGE_SIZE_GUESS    4096
+
+// Trace compiled to dense slots so replay does no id lookups
+typedef struct {
+    uint32_t slot;
+    uint32_t size;
+    uint8_t op;
+    uint8_t alignment_log2;
+} ReplayOp;
+
+typedef struct {
+    ReplayOp *ops;
+    size_t op_count;
+    size_t slot_count;         // Peak number of simultaneously live objects
+    size_t alloc_count;
+    size_t free_count;
+    size_t dropped_frees;      // Frees of objects allocated before tracing started
+    size_t reused_live;        // Allocations of an address still live in the trace (out-of-order capture)
+    size_t thread_count;
+    size_t peak_live_bytes;
+    size_t total_bytes;        // Sum of all requested sizes
+    size_t max_size;
+    size_t max_alignment;
+    double mean_lifetime_ops;  // Records between alloc and matching free
+} ReplayTrace;
+
+// Live object in a slot: raw is what the allocator returned, ptr is what the trace sees
+typedef struct {
+    void *raw;
+    void *ptr;
+    uint32_t size;
+} ReplaySlot;
+
+typedef struct {
+    const char *name;
+    void *(*create)(const ReplayTrace *trace);
+    void *(*alloc)(void *ctx, size_t size, size_t alignment);
+    void (*free)(void *ctx, void *ptr, size_t size);
+    void (*destroy)(void *ctx);
+    size_t native_alignment;  // alloc() honors alignments up to this; larger ones are padded
+} ReplayAllocator;
+
+typedef struct {
+    int ok;
+    double ops_per_sec;
+    uint32_t p50_ns;
+    uint32_t p99_ns;
+    uint32_t p999_ns;
+    uint32_t max_ns;
+    long peak_rss_kb;
+    size_t failed;
+} ReplayResult;
+
+static inline uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static inline size_t align_up(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+static void format_number(double n, char *buf, size_t buf_size) {
+    if (n >= 1e9) {
+        snprintf(buf, buf_size, "%.2fB", n / 1e9);
+    } else if (n >= 1e6) {
+        snprintf(buf, buf_size, "%.2fM", n / 1e6);
+    } else if (n >= 1e3) {
+        snprintf(buf, buf_size, "%.2fK", n / 1e3);
+    } else {
+        snprintf(buf, buf_size, "%.0f", n);
+    }
+}
+
+// ============================================================================
+// Trace input
+// ============================================================================
+
+typedef struct {
+    AllocTraceRecord *records;
+    size_t count;
+    size_t capacity;
+} RecordArray;
+
+static int records_push(RecordArray *array, const AllocTraceRecord *record) {
+    if (array->count == array->capacity) {
+        size_t capacity = array->capacity != 0 ? array->capacity * 2 : 65536;
+        AllocTraceRecord *records = realloc(array->records, capacity * sizeof(AllocTraceRecord));
+        if (records == NULL) {
+            return -1;
+        }
+        array->records = records;
+        array->capacity = capacity;
+    }
+    array->records[array->count++] = *record;
+    return 0;
+}
+
+static int load_trace(const char *path, RecordArray *out) {
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        perror(path);
+        return -1;
+    }
+
+    AllocTraceHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 ||
+        memcmp(header.magic, ALLOC_TRACE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != ALLOC_TRACE_VERSION || header.record_size != sizeof(AllocTraceRecord)) {
+        fprintf(stderr, "%s: not a version %d allocation trace\n", path, ALLOC_TRACE_VERSION);
+        fclose(file);
+        return -1;
+    }
+
+    AllocTraceRecord chunk[4096];
+    size_t read;
+    while ((read = fread(chunk, sizeof(AllocTraceRecord), 4096, file)) > 0) {
+        for (size_t i = 0; i < read; i++) {
+            if (records_push(out, &chunk[i]) != 0) {
+                fclose(file);
+                return -1;
+            }
+        }
+    }
+
+    fclose(file);
+    return 0;
+}
+
+// Deterministic xorshift PRNG so every run sees the same synthetic trace
+static inline uint64_t trace_rand(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+// Service-shaped workload: 95% small sizes (8..2048), 5% large (2K..16K),
+// mostly short-lived scratch freed near-LIFO with a long-lived random tail
+static int generate_trace(RecordArray *out, size_t allocs) {
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+    uint64_t *live = malloc(SYNTHETIC_LIVE * sizeof(uint64_t));
+    size_t live_count = 0;
+    uint64_t next_id = 1;
+    uint64_t timestamp = 0;
+    size_t made = 0;
+
+    if (live == NULL) {
+        return -1;
+    }
+
+    while (made < allocs || live_count > 0) {
+        uint64_t r = trace_rand(&state);
+        int do_alloc = made < allocs && (live_count == 0 || (live_count < SYNTHETIC_LIVE && r % 100 < 52));
+        AllocTraceRecord record;
+        memset(&record, 0, sizeof(record));
+        record.timestamp_ns = timestamp;
+        record.thread = (uint16_t)((timestamp / 4096) % 4);
+        timestamp += 50;
+
+        if (do_alloc) {
+            uint64_t s = trace_rand(&state);
+            record.op = ALLOC_TRACE_OP_ALLOC;
+            record.id = next_id++;
+            record.size = (uint32_t)(s % 100 < 95 ? 8 + (s >> 8) % 2041 : 2049 + (s >> 8) % (14 * 1024));
+            record.alignment_log2 = (s >> 40) % 100 < 2 ? 6 : 4;
+            live[live_count++] = record.id;
+            made++;
+        } else {
+            // 70% free one of the 8 most recent objects, 30% any live object
+            size_t window = live_count < 8 ? live_count : 8;
+            size_t index = (r >> 8) % 100 < 70 ? live_count - 1 - (size_t)((r >> 16) % window)
+                                               : (size_t)((r >> 16) % live_count);
+            record.op = ALLOC_TRACE_OP_FREE;
+            record.id = live[index];
+            live[index] = live[--live_count];
+        }
+
+        if (records_push(out, &record) != 0) {
+            free(live);
+            return -1;
+        }
+    }
+
+    free(live);
+    return 0;
+}
+
+static int write_trace(const char *path, const RecordArray *records) {
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) {
+        perror(path);
+        return -1;
+    }
+
+    AllocTraceHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, ALLOC_TRACE_MAGIC, sizeof(header.magic));
+    header.version = ALLOC_TRACE_VERSION;
+    header.record_size = sizeof(AllocTraceRecord);
+
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+             fwrite(records->records, sizeof(AllocTraceRecord), records->count, file) == records->count;
+    return fclose(file) == 0 && ok ? 0 : -1;
+}
+
+// ============================================================================
+// Trace compilation: object ids -> dense slots
+// ============================================================================
+
+// Open-addressing map from live object id to slot, deleted by backward shift
+typedef struct {
+    uint64_t *ids;  // 0 = empty
+    uint32_t *slots;
+    uint64_t *born;  // Record index of the allocation, for lifetimes
+    size_t mask;
+    size_t count;
+} LiveMap;
+
+static inline size_t live_hash(uint64_t id, size_t mask) {
+    return (size_t)((id * 0x9E3779B97F4A7C15ull) >> 17) & mask;
+}
+
+static int live_map_init(LiveMap *map, size_t capacity) {
+    map->ids = calloc(capacity, sizeof(uint64_t));
+    map->slots = malloc(capacity * sizeof(uint32_t));
+    map->born = malloc(capacity * sizeof(uint64_t));
+    map->mask = capacity - 1;
+    map->count = 0;
+    return map->ids != NULL && map->slots != NULL && map->born != NULL ? 0 : -1;
+}
+
+static void live_map_destroy(LiveMap *map) {
+    free(map->ids);
+    free(map->slots);
+    free(map->born);
+}
+
+static size_t live_map_find(const LiveMap *map, uint64_t id) {
+    size_t i = live_hash(id, map->mask);
+    while (map->ids[i] != 0 && map->ids[i] != id) {
+        i = (i + 1) & map->mask;
+    }
+    return i;
+}
+
+static int live_map_insert(LiveMap *map, uint64_t id, uint32_t slot, uint64_t born);
+
+static int live_map_grow(LiveMap *map) {
+    LiveMap bigger;
+    if (live_map_init(&bigger, (map->mask + 1) * 2) != 0) {
+        live_map_destroy(&bigger);
+        return -1;
+    }
+    for (size_t i = 0; i <= map->mask; i++) {
+        if (map->ids[i] != 0) {
+            live_map_insert(&bigger, map->ids[i], map->slots[i], map->born[i]);
+        }
+    }
+    live_map_destroy(map);
+    *map = bigger;
+    return 0;
+}
+
+static int live_map_insert(LiveMap *map, uint64_t id, uint32_t slot, uint64_t born) {
+    if ((map->count + 1) * 2 > map->mask + 1 && live_map_grow(map) != 0) {
+        return -1;
+    }
+    size_t i = live_map_find(map, id);
+    if (map->ids[i] == 0) {
+        map->count++;
+    }
+    map->ids[i] = id;
+    map->slots[i] = slot;
+    map->born[i] = born;
+    return 0;
+}
+
+static void live_map_remove(LiveMap *map, size_t i) {
+    map->ids[i] = 0;
+    map->count--;
+
+    // Backward-shift the rest of the cluster so lookups never need tombstones
+    size_t j = i;
+    for (;;) {
+        j = (j + 1) & map->mask;
+        if (map->ids[j] == 0) {
+            return;
+        }
+        size_t home = live_hash(map->ids[j], map->mask);
+        if (((j - home) & map->mask) >= ((j - i) & map->mask)) {
+            map->ids[i] = map->ids[j];
+            map->slots[i] = map->slots[j];
+            map->born[i] = map->born[j];
+            map->ids[j] = 0;
+            i = j;
+        }
+    }
+}
+
+static int compile_trace(const RecordArray *records, ReplayTrace *trace) {
+    memset(trace, 0, sizeof(*trace));
+    trace->ops = malloc(records->count * sizeof(ReplayOp) + 1);
+    uint32_t *free_slots = malloc(records->count * sizeof(uint32_t) + 1);
+    uint32_t *slot_sizes = malloc(records->count * sizeof(uint32_t) + 1);
+    size_t free_slot_count = 0;
+    size_t live_bytes = 0;
+    double lifetime_sum = 0;
+    unsigned thread_max = 0;
+    LiveMap map;
+
+    if (trace->ops == NULL || free_slots == NULL || slot_sizes == NULL || live_map_init(&map, 1024) != 0) {
+        free(free_slots);
+        free(slot_sizes);
+        return -1;
+    }
+
+    for (size_t i = 0; i < records->count; i++) {
+        const AllocTraceRecord *record = &records->records[i];
+        size_t pos = live_map_find(&map, record->id);
+        ReplayOp *op = &trace->ops[trace->op_count];
+
+        if (record->thread > thread_max) {
+            thread_max = record->thread;
+        }
+
+        if (record->op == ALLOC_TRACE_OP_ALLOC) {
+            if (map.ids[pos] != 0) {
+                // The shim never records an address twice without a free in
+                // between, so this trace is out of order; count it and retire
+                // the old object so replay can continue
+                trace->reused_live++;
+                size_t slot = map.slots[pos];
+                live_bytes -= slot_sizes[slot];
+                free_slots[free_slot_count++] = (uint32_t)slot;
+                live_map_remove(&map, pos);
+            }
+
+            uint32_t slot = free_slot_count != 0 ? free_slots[--free_slot_count] : (uint32_t)trace->slot_count++;
+            if (live_map_insert(&map, record->id, slot, i) != 0) {
+                break;
+            }
+            op->slot = slot;
+            op->size = record->size;
+            op->op = ALLOC_TRACE_OP_ALLOC;
+            op->alignment_log2 = record->alignment_log2;
+            trace->op_count++;
+
+            slot_sizes[slot] = record->size;
+            live_bytes += record->size;
+            trace->alloc_count++;
+            trace->total_bytes += record->size;
+            if (live_bytes > trace->peak_live_bytes) {
+                trace->peak_live_bytes = live_bytes;
+            }
+            if (record->size > trace->max_size) {
+                trace->max_size = record->size;
+            }
+            if (((size_t)1 << record->alignment_log2) > trace->max_alignment) {
+                trace->max_alignment = (size_t)1 << record->alignment_log2;
+            }
+        } else if (record->op == ALLOC_TRACE_OP_FREE) {
+            if (map.ids[pos] == 0) {
+                trace->dropped_frees++;
+                continue;
+            }
+            uint32_t slot = map.slots[pos];
+            lifetime_sum += (double)(i - map.born[pos]);
+            live_map_remove(&map, pos);
+
+            op->slot = slot;
+            op->size = slot_sizes[slot];
+            op->op = ALLOC_TRACE_OP_FREE;
+            op->alignment_log2 = 0;
+            trace->op_count++;
+
+            live_bytes -= slot_sizes[slot];
+            free_slots[free_slot_count++] = slot;
+            trace->free_count++;
+        }
+    }
+
+    trace->thread_count = records->count != 0 ? (size_t)thread_max + 1 : 0;
+    trace->mean_lifetime_ops = trace->free_count != 0 ? lifetime_sum / (double)trace->free_count : 0;
+
+    live_map_destroy(&map);
+    free(free_slots);
+    free(slot_sizes);
+    return 0;
+}
+
+// ============================================================================
+// Allocator adapters
+// ============================================================================
+
+// Padding a slot needs when its alignment exceeds what the allocator provides
+static inline size_t alignment_padding(size_t alignment, size_t native) {
+    return alignment > native ? alignment - 1 : 0;
+}
+
+static void *arena_create(const ReplayTrace *trace) {
+    (void)trace;
+    SimpleMemoryAllocator *arena = malloc(sizeof(SimpleMemoryAllocator));
+    SimpleMemoryAllocatorOptions options = {.growable = 1};
+
+    if (arena == NULL) {
+        return NULL;
+    }
+    simple_memory_allocator_init(arena);
+    if (simple_memory_allocator_create_with_options(arena, ARENA_INITIAL_SIZE, &options) != 0) {
+        free(arena);
+        return NULL;
+    }
+    return arena;
+}
+
+static void *arena_alloc(void *ctx, size_t size, size_t alignment) {
+    return simple_memory_allocator_alloc_aligned(ctx, size, alignment);
+}
+
+static void arena_free(void *ctx, void *ptr, size_t size) {
+    (void)ctx;
+    (void)ptr;
+    (void)size;
+}
+
+static void arena_destroy(void *ctx) {
+    simple_memory_allocator_destroy(ctx);
+    free(ctx);
+}
+
+// Fixed-size pool: every slot is sized for the largest request in the trace
+typedef struct {
+    PoolAllocator pool;
+} PoolContext;
+
+static void *pool_create(const ReplayTrace *trace) {
+    PoolContext *ctx = malloc(sizeof(PoolContext));
+    size_t block_size = align_up(trace->max_size + alignment_padding(trace->max_alignment, 8), 8);
+
+    if (ctx == NULL) {
+        return NULL;
+    }
+    pool_allocator_init(&ctx->pool);
+    if (pool_allocator_create(&ctx->pool, block_size, trace->slot_count != 0 ? trace->slot_count : 1) != 0) {
+        free(ctx);
+        return NULL;
+    }
+    return ctx;
+}
+
+static void *pool_alloc(void *ctx, size_t size, size_t alignment) {
+    (void)size;
+    (void)alignment;
+    return pool_allocator_alloc(&((PoolContext *)ctx)->pool);
+}
+
+static void pool_free(void *ctx, void *ptr, size_t size) {
+    (void)size;
+    pool_allocator_free(&((PoolContext *)ctx)->pool, ptr);
+}
+
+static void pool_destroy(void *ctx) {
+    pool_allocator_destroy(&((PoolContext *)ctx)->pool);
+    free(ctx);
+}
+
+// Heap sized for twice the peak live footprint plus per-object overhead
+typedef struct {
+    FreeListAllocator freelist;
+    void *memory;
+} FreeListContext;
+
+static void *freelist_create(const ReplayTrace *trace) {
+    FreeListContext *ctx = malloc(sizeof(FreeListContext));
+    size_t per_object = FREELIST_MIN_BLOCK + alignment_padding(trace->max_alignment, 8);
+    size_t heap_size = 2 * (trace->peak_live_bytes + trace->slot_count * per_object) + ARENA_INITIAL_SIZE;
+
+    if (ctx == NULL) {
+        return NULL;
+    }
+    ctx->memory = malloc(heap_size);
+    if (ctx->memory == NULL) {
+        free(ctx);
+        return NULL;
+    }
+    freelist_init(&ctx->freelist, ctx->memory, heap_size);
+    return ctx;
+}
+
+static void *freelist_adapter_alloc(void *ctx, size_t size, size_t alignment) {
+    (void)alignment;
+    return freelist_alloc(&((FreeListContext *)ctx)->freelist, size);
+}
+
+static void freelist_adapter_free(void *ctx, void *ptr, size_t size) {
+    (void)size;
+    freelist_free(&((FreeListContext *)ctx)->freelist, ptr);
+}
+
+static void freelist_destroy(void *ctx) {
+    free(((FreeListContext *)ctx)->memory);
+    free(ctx);
+}
+
+// Stack sized for every allocation in the trace, since only top frees are reclaimed
+typedef struct {
+    void *stack;
+    void *memory;
+} StackContext;
+
+static void *stack_create(const ReplayTrace *trace) {
+    StackContext *ctx = malloc(sizeof(StackContext));
+    size_t per_object = 8 + alignment_padding(trace->max_alignment, 8);
+    size_t size = trace->total_bytes + trace->alloc_count * per_object + 8;
+
+    if (ctx == NULL) {
+        return NULL;
+    }
+    ctx->memory = malloc(size);
+    ctx->stack = ctx->memory != NULL ? tutorial_stack_create(ctx->memory, size) : NULL;
+    if (ctx->stack == NULL) {
+        free(ctx->memory);
+        free(ctx);
+        return NULL;
+    }
+    return ctx;
+}
+
+static void *stack_adapter_alloc(void *ctx, size_t size, size_t alignment) {
+    (void)alignment;
+    return tutorial_stack_alloc(((StackContext *)ctx)->stack, size);
+}
+
+static void stack_adapter_free(void *ctx, void *ptr, size_t size) {
+    tutorial_stack_free(((StackContext *)ctx)->stack, ptr, size);
+}
+
+static void stack_destroy(void *ctx) {
+    tutorial_stack_destroy(((StackContext *)ctx)->stack);
+    free(((StackContext *)ctx)->memory);
+    free(ctx);
+}
+
+static void *malloc_create(const ReplayTrace *trace) {
+    (void)trace;
+    static int dummy;
+    return &dummy;
+}
+
+static void *malloc_alloc(void *ctx, size_t size, size_t alignment) {
+    (void)ctx;
+    if (alignment > _Alignof(max_align_t)) {
+        return aligned_alloc(alignment, align_up(size, alignment));
+    }
+    return malloc(size);
+}
+
+static void malloc_free(void *ctx, void *ptr, size_t size) {
+    (void)ctx;
+    (void)size;
+    free(ptr);
+}
+
+static void malloc_destroy(void *ctx) {
+    (void)ctx;
+}
+
+static const ReplayAllocator allocators[] = {
+    {"SimpleMemoryAllocator (grow)", arena_create, arena_alloc, arena_free, arena_destroy, SIZE_MAX},
+    {"StackAllocator (tutorial)", stack_create, stack_adapter_alloc, stack_adapter_free, stack_destroy, 8},
+    {"PoolAllocator (max size)", pool_create, pool_alloc, pool_free, pool_destroy, 8},
+    {"FreeListAllocator (TLSF)", freelist_create, freelist_adapter_alloc, freelist_adapter_free, freelist_destroy, 8},
+    {"malloc/free", malloc_create, malloc_alloc, malloc_free, malloc_destroy, SIZE_MAX},
+};
+
+// ============================================================================
+// Replay
+// ============================================================================
+
+static void touch_pages(unsigned char *ptr, size_t size) {
+    for (size_t offset = 0; offset < size; offset += PAGE_SIZE_GUESS) {
+        ptr[offset] = 1;
+    }
+    if (size != 0) {
+        ptr[size - 1] = 1;
+    }
+}
+
+// Run the trace once; with latencies != NULL each call is timed and touched
+static size_t replay_pass(const ReplayAllocator *allocator, void *ctx, const ReplayTrace *trace,
+                          ReplaySlot *slots, uint32_t *latencies) {
+    size_t failed = 0;
+
+    for (size_t i = 0; i < trace->op_count; i++) {
+        const ReplayOp *op = &trace->ops[i];
+        ReplaySlot *slot = &slots[op->slot];
+        uint64_t start = latencies != NULL ? now_ns() : 0;
+
+        if (op->op == ALLOC_TRACE_OP_ALLOC) {
+            size_t alignment = (size_t)1 << op->alignment_log2;
+            size_t padding = alignment_padding(alignment, allocator->native_alignment);
+            slot->raw = allocator->alloc(ctx, op->size + padding, alignment);
+            slot->ptr = padding != 0 && slot->raw != NULL
+                            ? (void *)align_up((uintptr_t)slot->raw, alignment)
+                            : slot->raw;
+            slot->size = (uint32_t)(op->size + padding);
+        } else if (slot->raw != NULL) {
+            allocator->free(ctx, slot->raw, slot->size);
+            slot->raw = NULL;
+        }
+
+        if (latencies != NULL) {
+            uint64_t elapsed = now_ns() - start;
+            latencies[i] = elapsed > UINT32_MAX ? UINT32_MAX : (uint32_t)elapsed;
+            if (op->op == ALLOC_TRACE_OP_ALLOC && slot->ptr != NULL) {
+                touch_pages(slot->ptr, op->size);
+            }
+        }
+
+        if (op->op == ALLOC_TRACE_OP_ALLOC && slot->raw == NULL) {
+            failed++;
+        }
+    }
+
+    // Objects still live at the end of the trace are released untimed
+    for (size_t i = 0; i < trace->slot_count; i++) {
+        if (slots[i].raw != NULL) {
+            allocator->free(ctx, slots[i].raw, slots[i].size);
+            slots[i].raw = NULL;
+        }
+    }
+
+    return failed;
+}
+
+static int compare_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static uint32_t percentile(const uint32_t *sorted, size_t count, double p) {
+    size_t index = (size_t)(p * (double)(count - 1));
+    return sorted[index];
+}
+
+// Child process body: one pass in a fresh address-space copy
+static void replay_child(const ReplayAllocator *allocator, const ReplayTrace *trace, int timed, ReplayResult *result) {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    long baseline_kb = usage.ru_maxrss;
+
+    ReplaySlot *slots = calloc(trace->slot_count + 1, sizeof(ReplaySlot));
+    uint32_t *latencies = timed ? malloc(trace->op_count * sizeof(uint32_t) + 1) : NULL;
+    void *ctx = slots != NULL && (!timed || latencies != NULL) ? allocator->create(trace) : NULL;
+    if (ctx == NULL) {
+        return;
+    }
+
+    uint64_t start = now_ns();
+    result->failed = replay_pass(allocator, ctx, trace, slots, latencies);
+    uint64_t elapsed = now_ns() - start;
+
+    getrusage(RUSAGE_SELF, &usage);
+    result->peak_rss_kb = usage.ru_maxrss - baseline_kb;
+    allocator->destroy(ctx);
+
+    if (timed && trace->op_count != 0) {
+        qsort(latencies, trace->op_count, sizeof(uint32_t), compare_u32);
+        result->p50_ns = percentile(latencies, trace->op_count, 0.50);
+        result->p99_ns = percentile(latencies, trace->op_count, 0.99);
+        result->p999_ns = percentile(latencies, trace->op_count, 0.999);
+        result->max_ns = latencies[trace->op_count - 1];
+    } else {
+        result->ops_per_sec = (double)trace->op_count / ((double)elapsed / 1e9);
+    }
+
+    result->ok = 1;
+    free(latencies);
+    free(slots);
+}
+
+// Fork, replay in the child and ship the result back over a pipe
+static ReplayResult replay_forked(const ReplayAllocator *allocator, const ReplayTrace *trace, int timed) {
+    ReplayResult result;
+    memset(&result, 0, sizeof(result));
+
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return result;
+    }
+
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        replay_child(allocator, trace, timed, &result);
+        ssize_t written = write(fds[1], &result, sizeof(result));
+        _exit(written == (ssize_t)sizeof(result) ? 0 : 1);
+    }
+
+    close(fds[1]);
+    if (pid > 0) {
+        if (read(fds[0], &result, sizeof(result)) != (ssize_t)sizeof(result)) {
+            memset(&result, 0, sizeof(result));
+        }
+        waitpid(pid, NULL, 0);
+    }
+    close(fds[0]);
+    return result;
+}
+
+static uint32_t timer_overhead_ns(void) {
+    uint32_t samples[1001];
+    for (size_t i = 0; i < 1001; i++) {
+        uint64_t start = now_ns();
+        samples[i] = (uint32_t)(now_ns() - start);
+    }
+    qsort(samples, 1001, sizeof(uint32_t), compare_u32);
+    return samples[500];
+}
+
+static void print_trace_summary(const char *source, const ReplayTrace *trace) {
+    char ops_str[32];
+    format_number((double)trace->op_count, ops_str, sizeof(ops_str));
+
+    printf("\n▸ Trace: %s\n", source);
+    printf("  %-30s %12s\n", "Replayed operations", ops_str);
+    printf("  %-30s %12zu\n", "Allocations", trace->alloc_count);
+    printf("  %-30s %12zu\n", "Frees", trace->free_count);
+    printf("  %-30s %12zu\n", "Unmatched frees dropped", trace->dropped_frees);
+    if (trace->reused_live != 0) {
+        printf("  %-30s %12zu  (trace is out of order; results are approximate)\n", "Allocations over live objects",
+               trace->reused_live);
+    }
+    printf("  %-30s %12zu\n", "Recorded threads", trace->thread_count);
+    printf("  %-30s %12zu\n", "Peak live objects", trace->slot_count);
+    printf("  %-30s %9.2f MB\n", "Peak live bytes", (double)trace->peak_live_bytes / (1024.0 * 1024.0));
+    printf("  %-30s %12zu\n", "Largest request", trace->max_size);
+    printf("  %-30s %12zu\n", "Largest alignment", trace->max_alignment);
+    printf("  %-30s %9.1f ops\n", "Mean lifetime", trace->mean_lifetime_ops);
+}
+
+static void replay_all(const ReplayTrace *trace) {
+    printf("\n▸ Replay (latency includes ~%u ns timer overhead)\n", timer_overhead_ns());
+    printf("  %-30s %10s %7s %7s %7s %9s %10s %8s\n",
+           "Allocator", "ops/s", "p50", "p99", "p99.9", "max", "peak RSS", "failed");
+
+    for (size_t i = 0; i < sizeof(allocators) / sizeof(allocators[0]); i++) {
+        ReplayResult throughput = replay_forked(&allocators[i], trace, 0);
+        ReplayResult latency = replay_forked(&allocators[i], trace, 1);
+
+        if (!throughput.ok || !latency.ok) {
+            printf("  %-30s %10s\n", allocators[i].name, "setup failed");
+            continue;
+        }
+
+        char ops_str[32];
+        format_number(throughput.ops_per_sec, ops_str, sizeof(ops_str));
+        printf("  %-30s %10s %5uns %5uns %5uns %7uns %7.1f MB %8zu\n", allocators[i].name, ops_str,
+               latency.p50_ns, latency.p99_ns, latency.p999_ns, latency.max_ns,
+               (double)latency.peak_rss_kb / 1024.0, latency.failed);
+    }
+}
+
+int main(int argc, char **argv) {
+    RecordArray records = {NULL, 0, 0};
+    const char *source = "synthetic";
+
+    if (argc >= 3 && strcmp(argv[1], "--generate") == 0) {
+        size_t allocs = argc >= 4 ? strtoull(argv[3], NULL, 10) : SYNTHETIC_ALLOCS;
+        int status = generate_trace(&records, allocs) == 0 && write_trace(argv[2], &records) == 0 ? 0 : 1;
+        if (status == 0) {
+            printf("Wrote %zu records to %s\n", records.count, argv[2]);
+        }
+        free(records.records);
+        return status;
+    }
+
+    if (argc >= 2) {
+        source = argv[1];
+        if (load_trace(source, &records) != 0) {
+            free(records.records);
+            return 1;
+        }
+    } else if (generate_trace(&records, SYNTHETIC_ALLOCS) != 0) {
+        return 1;
+    }
+
+    printf("\n");
+    printf("╔════════════════════════════════════════════════════╗\n");
+    printf("║     Allocation Trace Replay                        ║\n");
+    printf("╚════════════════════════════════════════════════════╝\n");
+
+    ReplayTrace trace;
+    if (compile_trace(&records, &trace) != 0) {
+        fprintf(stderr, "Failed to compile trace\n");
+        free(records.records);
+        return 1;
+    }
+    free(records.records);
+
+    print_trace_summary(source, &trace);
+    replay_all(&trace);
+    printf("\n");
+
+    free(trace.ops);
+    return 0;
+}
@@ -0,0 +1,306 @@
+/*
+ * LD_PRELOAD allocation tracer
+ *
+ * Interposes malloc/calloc/realloc/free/aligned_alloc/posix_memalign and the
+ * obsolete memalign/valloc/pvalloc, forwards to the next definition in link
+ * order and appends an AllocTraceRecord per call to the file named by
+ * $SMA_TRACE_FILE (default "alloc.trace"):
+ *
+ *   SMA_TRACE_FILE=service.trace LD_PRELOAD=bin/libtrace_shim.so ./service
+ *
+ * Records are buffered under one mutex and flushed with write(2), so tracing
+ * serializes the traced allocator; the trace captures order and lifetimes,
+ * not timing-accurate contention. Frees are recorded before the memory is
+ * released and allocations after it is obtained, and realloc holds the lock
+ * across the call, so an address never appears allocated twice in the trace.
+ */
+
+#define _GNU_SOURCE
+
+#include <dlfcn.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <malloc.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "alloc_trace.h"
+
+#define TRACE_BUFFER_RECORDS 4096
+#define BOOTSTRAP_SIZE       (64 * 1024)  // Serves dlsym's own allocations before lookup completes
+
+#define TRACE_TLS __attribute__((tls_model("initial-exec")))
+
+static void *(*real_malloc)(size_t);
+static void *(*real_calloc)(size_t, size_t);
+static void *(*real_realloc)(void *, size_t);
+static void (*real_free)(void *);
+static void *(*real_aligned_alloc)(size_t, size_t);
+static int (*real_posix_memalign)(void **, size_t, size_t);
+static void *(*real_memalign)(size_t, size_t);
+static void *(*real_valloc)(size_t);
+static void *(*real_pvalloc)(size_t);
+
+static _Alignas(16) unsigned char bootstrap[BOOTSTRAP_SIZE];
+static size_t bootstrap_used;
+static int resolving;
+
+static pthread_mutex_t trace_lock = PTHREAD_MUTEX_INITIALIZER;
+static AllocTraceRecord trace_buffer[TRACE_BUFFER_RECORDS];
+static size_t trace_count;
+static int trace_fd = -1;
+static uint64_t trace_start_ns;
+static atomic_uint next_thread;
+
+static _Thread_local TRACE_TLS int in_shim;
+static _Thread_local TRACE_TLS unsigned thread_index;  // 0 = not assigned yet
+
+static int is_bootstrap(const void *ptr) {
+    return (const unsigned char *)ptr >= bootstrap &&
+           (const unsigned char *)ptr < bootstrap + BOOTSTRAP_SIZE;
+}
+
+static void *bootstrap_alloc(size_t size) {
+    size_t aligned = (size + 15) & ~(size_t)15;
+    if (aligned > BOOTSTRAP_SIZE - bootstrap_used) {
+        return NULL;
+    }
+    void *ptr = bootstrap + bootstrap_used;
+    bootstrap_used += aligned;
+    return ptr;  // Static storage, already zeroed for calloc
+}
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static uint8_t log2_of(size_t alignment) {
+    uint8_t log2 = 0;
+    while (((size_t)1 << log2) < alignment) {
+        log2++;
+    }
+    return log2;
+}
+
+static void flush_locked(void) {
+    const char *data = (const char *)trace_buffer;
+    size_t remaining = trace_count * sizeof(AllocTraceRecord);
+
+    while (remaining > 0 && trace_fd >= 0) {
+        ssize_t written = write(trace_fd, data, remaining);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        data += written;
+        remaining -= (size_t)written;
+    }
+    trace_count = 0;
+}
+
+static void resolve(void) {
+    resolving = 1;
+    *(void **)(&real_malloc) = dlsym(RTLD_NEXT, "malloc");
+    *(void **)(&real_calloc) = dlsym(RTLD_NEXT, "calloc");
+    *(void **)(&real_realloc) = dlsym(RTLD_NEXT, "realloc");
+    *(void **)(&real_free) = dlsym(RTLD_NEXT, "free");
+    *(void **)(&real_aligned_alloc) = dlsym(RTLD_NEXT, "aligned_alloc");
+    *(void **)(&real_posix_memalign) = dlsym(RTLD_NEXT, "posix_memalign");
+    *(void **)(&real_memalign) = dlsym(RTLD_NEXT, "memalign");
+    *(void **)(&real_valloc) = dlsym(RTLD_NEXT, "valloc");
+    *(void **)(&real_pvalloc) = dlsym(RTLD_NEXT, "pvalloc");
+    resolving = 0;
+}
+
+__attribute__((constructor)) static void trace_open(void) {
+    if (real_malloc == NULL) {
+        resolve();
+    }
+
+    const char *path = getenv("SMA_TRACE_FILE");
+    trace_fd = open(path != NULL ? path : "alloc.trace", O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (trace_fd < 0) {
+        return;
+    }
+
+    AllocTraceHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, ALLOC_TRACE_MAGIC, sizeof(header.magic));
+    header.version = ALLOC_TRACE_VERSION;
+    header.record_size = sizeof(AllocTraceRecord);
+    if (write(trace_fd, &header, sizeof(header)) != (ssize_t)sizeof(header)) {
+        close(trace_fd);
+        trace_fd = -1;
+        return;
+    }
+
+    trace_start_ns = now_ns();
+}
+
+__attribute__((destructor)) static void trace_close(void) {
+    pthread_mutex_lock(&trace_lock);
+    flush_locked();
+    if (trace_fd >= 0) {
+        close(trace_fd);
+        trace_fd = -1;
+    }
+    pthread_mutex_unlock(&trace_lock);
+}
+
+// Append one record; the caller holds trace_lock
+static void record_locked(uint8_t op, const void *ptr, size_t size, size_t alignment) {
+    if (trace_fd < 0 || ptr == NULL) {
+        return;
+    }
+
+    if (thread_index == 0) {
+        thread_index = atomic_fetch_add_explicit(&next_thread, 1, memory_order_relaxed) + 1;
+    }
+
+    AllocTraceRecord rec;
+    rec.id = (uint64_t)(uintptr_t)ptr;
+    rec.timestamp_ns = now_ns() - trace_start_ns;
+    rec.size = size > UINT32_MAX ? UINT32_MAX : (uint32_t)size;
+    rec.op = op;
+    rec.alignment_log2 = op == ALLOC_TRACE_OP_ALLOC ? log2_of(alignment) : 0;
+    rec.thread = (uint16_t)(thread_index - 1);
+
+    trace_buffer[trace_count++] = rec;
+    if (trace_count == TRACE_BUFFER_RECORDS) {
+        flush_locked();
+    }
+}
+
+static void record(uint8_t op, const void *ptr, size_t size, size_t alignment) {
+    if (trace_fd < 0 || ptr == NULL || in_shim) {
+        return;
+    }
+    in_shim = 1;
+    pthread_mutex_lock(&trace_lock);
+    record_locked(op, ptr, size, alignment);
+    pthread_mutex_unlock(&trace_lock);
+    in_shim = 0;
+}
+
+void *malloc(size_t size) {
+    if (real_malloc == NULL) {
+        if (resolving) {
+            return bootstrap_alloc(size);
+        }
+        resolve();
+    }
+    void *ptr = real_malloc(size);
+    record(ALLOC_TRACE_OP_ALLOC, ptr, size, _Alignof(max_align_t));
+    return ptr;
+}
+
+void *calloc(size_t count, size_t size) {
+    if (real_calloc == NULL) {
+        if (resolving) {
+            return count != 0 && size > SIZE_MAX / count ? NULL : bootstrap_alloc(count * size);
+        }
+        resolve();
+    }
+    void *ptr = real_calloc(count, size);
+    record(ALLOC_TRACE_OP_ALLOC, ptr, count * size, _Alignof(max_align_t));
+    return ptr;
+}
+
+void *realloc(void *old, size_t size) {
+    if (is_bootstrap(old)) {
+        void *ptr = malloc(size);
+        if (ptr != NULL) {
+            size_t available = (size_t)(bootstrap + BOOTSTRAP_SIZE - (unsigned char *)old);
+            memcpy(ptr, old, size < available ? size : available);
+        }
+        return ptr;
+    }
+    if (real_realloc == NULL) {
+        resolve();
+    }
+    if (in_shim) {
+        return real_realloc(old, size);
+    }
+
+    // The old block is released inside real_realloc; holding the lock until
+    // its FREE is recorded keeps another thread that is handed the same
+    // address from recording the ALLOC first
+    in_shim = 1;
+    pthread_mutex_lock(&trace_lock);
+    void *ptr = real_realloc(old, size);
+    if (ptr != NULL || size == 0) {
+        record_locked(ALLOC_TRACE_OP_FREE, old, 0, 0);
+        record_locked(ALLOC_TRACE_OP_ALLOC, ptr, size, _Alignof(max_align_t));
+    }
+    pthread_mutex_unlock(&trace_lock);
+    in_shim = 0;
+    return ptr;
+}
+
+void free(void *ptr) {
+    if (ptr == NULL || is_bootstrap(ptr)) {
+        return;
+    }
+    if (real_free == NULL) {
+        resolve();
+    }
+    record(ALLOC_TRACE_OP_FREE, ptr, 0, 0);
+    real_free(ptr);
+}
+
+void *aligned_alloc(size_t alignment, size_t size) {
+    if (real_aligned_alloc == NULL) {
+        resolve();
+    }
+    void *ptr = real_aligned_alloc(alignment, size);
+    record(ALLOC_TRACE_OP_ALLOC, ptr, size, alignment);
+    return ptr;
+}
+
+int posix_memalign(void **out, size_t alignment, size_t size) {
+    if (real_posix_memalign == NULL) {
+        resolve();
+    }
+    int result = real_posix_memalign(out, alignment, size);
+    if (result == 0) {
+        record(ALLOC_TRACE_OP_ALLOC, *out, size, alignment);
+    }
+    return result;
+}
+
+void *memalign(size_t alignment, size_t size) {
+    if (real_memalign == NULL) {
+        resolve();
+    }
+    void *ptr = real_memalign(alignment, size);
+    record(ALLOC_TRACE_OP_ALLOC, ptr, size, alignment);
+    return ptr;
+}
+
+void *valloc(size_t size) {
+    if (real_valloc == NULL) {
+        resolve();
+    }
+    void *ptr = real_valloc(size);
+    record(ALLOC_TRACE_OP_ALLOC, ptr, size, (size_t)sysconf(_SC_PAGESIZE));
+    return ptr;
+}
+
+// pvalloc rounds the request up to whole pages; the trace keeps the size asked for
+void *pvalloc(size_t size) {
+    if (real_pvalloc == NULL) {
+        resolve();
+    }
+    void *ptr = real_pvalloc(size);
+    record(ALLOC_TRACE_OP_ALLOC, ptr, size, (size_t)sysconf(_SC_PAGESIZE));
+    return ptr;
+}
@@ -0,0 +1,88 @@
+/*
+ * Wrappers around the tutorial allocators.h implementations
+ */
+
+#include <stdlib.h>
+#include "tutorial_allocators.h"
+#include "../allocators_tutorials_examples/examples/allocators.h"
+
+void *tutorial_pool_create(void *memory, size_t block_size, size_t block_count) {
+    PoolAllocator *pool = malloc(sizeof(PoolAllocator));
+    if (pool != NULL) {
+        pool_init(pool, memory, block_size, block_count);
+    }
+    return pool;
+}
+
+void *tutorial_pool_alloc(void *pool) {
+    return pool_alloc(pool);
+}
+
+void tutorial_pool_free(void *pool, void *ptr) {
+    pool_free(pool, ptr);
+}
+
+void tutorial_pool_destroy(void *pool) {
+    free(pool);
+}
+
+void *tutorial_freelist_create(void *memory, size_t size) {
+    FreeListAllocator *freelist = malloc(sizeof(FreeListAllocator));
+    if (freelist != NULL) {
+        freelist_init(freelist, memory, size);
+    }
+    return freelist;
+}
+
+void *tutorial_freelist_alloc(void *freelist, size_t size) {
+    return freelist_alloc(freelist, size);
+}
+
+void tutorial_freelist_free(void *freelist, void *ptr) {
+    freelist_free(freelist, ptr);
+}
+
+void tutorial_freelist_destroy(void *freelist) {
+    free(freelist);
+}
+
+double tutorial_freelist_fragmentation(void *freelist) {
+    FreeListAllocator *a = freelist;
+    size_t total = 0;
+    size_t largest = 0;
+
+    for (FreeListBlock *block = a->free_list; block != NULL; block = block->next) {
+        total += block->size;
+        if (block->size > largest) {
+            largest = block->size;
+        }
+    }
+
+    return total != 0 ? 1.0 - (double)largest / (double)total : 0.0;
+}
+
+void *tutorial_stack_create(void *memory, size_t size) {
+    StackAllocator *stack = malloc(sizeof(StackAllocator));
+    if (stack != NULL) {
+        stack_init(stack, memory, size);
+    }
+    return stack;
+}
+
+void *tutorial_stack_alloc(void *stack, size_t size) {
+    return stack_alloc(stack, size);
+}
+
+void tutorial_stack_free(void *stack, void *ptr, size_t size) {
+    StackAllocator *s = stack;
+    StackMarker marker = (StackMarker)((uint8_t *)ptr - s->memory);
+
+    // Only the most recent allocation can be released; anything else stays until reset
+    if (marker + ALIGN_UP(size, 8) == stack_get_marker(s)) {
+        stack_free_to_marker(s, marker);
+    }
+}
+
+void tutorial_stack_destroy(void *stack) {
+    free(stack);
+}
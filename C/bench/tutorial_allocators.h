@@ -0,0 +1,35 @@
+/*
+ * Wrappers around the tutorial allocators.h implementations
+ *
+ * The tutorial types share names with the production allocators in src/,
+ * so they live in their own translation unit and are exposed here behind
+ * opaque handles for side-by-side benchmarks.
+ */
+
+#ifndef TUTORIAL_ALLOCATORS_H
+#define TUTORIAL_ALLOCATORS_H
+
+#include <stddef.h>
+
+// Eagerly initialized tutorial pool on caller-provided memory
+void *tutorial_pool_create(void *memory, size_t block_size, size_t block_count);
+void *tutorial_pool_alloc(void *pool);
+void tutorial_pool_free(void *pool, void *ptr);
+void tutorial_pool_destroy(void *pool);
+
+// First-fit tutorial free list on caller-provided memory
+void *tutorial_freelist_create(void *memory, size_t size);
+void *tutorial_freelist_alloc(void *freelist, size_t size);
+void tutorial_freelist_free(void *freelist, void *ptr);
+void tutorial_freelist_destroy(void *freelist);
+
+// 1 - largest free block / free bytes, measured by walking the free list
+double tutorial_freelist_fragmentation(void *freelist);
+
+// LIFO tutorial stack on caller-provided memory; free only pops the top allocation
+void *tutorial_stack_create(void *memory, size_t size);
+void *tutorial_stack_alloc(void *stack, size_t size);
+void tutorial_stack_free(void *stack, void *ptr, size_t size);
+void tutorial_stack_destroy(void *stack);
+
+#endif
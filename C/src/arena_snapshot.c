@@ -0,0 +1,210 @@
+/*
+ * Arena snapshot
+ *
+ * Zero-copy persistence for read-only structures built in a bump arena.
+ * The used region of the arena's block is written to a file unchanged,
+ * behind a one-page header, and mapped back with mmap: no parsing and no
+ * pointer fixups, because everything inside links with self-relative
+ * ArenaRelPtr values. The mapping is MAP_SHARED and read-only, so every
+ * process that opens the same file shares its page-cache pages.
+ *
+ * The data starts at the same offset within a page as the arena's memory
+ * did, which keeps every alignment the arena handed out valid in the map.
+ */
+
+#define _GNU_SOURCE  // Required for madvise
+
+#include "arena_snapshot.h"
+#include "memory_guard.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define ARENA_SNAPSHOT_MAGIC   "SMASNAP"
+#define ARENA_SNAPSHOT_VERSION 1
+
+// On-disk header at offset 0 (host byte order: snapshots are per host)
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t pointer_size;  // Refuse files written by a different ABI
+    uint64_t data_offset;   // File offset of the data
+    uint64_t size;          // Data bytes
+    uint64_t root;          // Root offset within the data plus one, 0 = none
+} ArenaSnapshotHeader;
+
+// Write all of buf, retrying short writes
+static int write_all(int fd, const void *buf, size_t len) {
+    const unsigned char *p = buf;
+    while (len > 0) {
+        ssize_t n = write(fd, p, len);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        p += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+// Write the used region behind a header
+// Returns 0 on success, -1 on failure
+int arena_snapshot_write(const SimpleMemoryAllocator *allocator, const void *root, const char *path) {
+    if (allocator == NULL || allocator->memory == NULL || path == NULL || allocator->used == 0) {
+        return -1;
+    }
+
+    // Relative pointers only survive if the whole structure is one contiguous run
+    if (simple_memory_allocator_bytes_used(allocator) != allocator->used) {
+        return -1;
+    }
+    const unsigned char *base = allocator->memory;
+    if (root != NULL && ((const unsigned char *)root < base || (const unsigned char *)root >= base + allocator->used)) {
+        return -1;
+    }
+
+    long page = sysconf(_SC_PAGESIZE);
+    size_t page_size = page > 0 ? (size_t)page : 4096;
+
+    ArenaSnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, ARENA_SNAPSHOT_MAGIC, sizeof(ARENA_SNAPSHOT_MAGIC));
+    header.version = ARENA_SNAPSHOT_VERSION;
+    header.pointer_size = sizeof(void *);
+    header.data_offset = page_size + (uintptr_t)base % page_size;
+    header.size = allocator->used;
+    header.root = root != NULL ? (uint64_t)((const unsigned char *)root - base) + 1 : 0;
+
+    // Build next to the destination, then rename over it
+    size_t path_len = strlen(path);
+    char *tmp_path = malloc(path_len + 32);
+    if (tmp_path == NULL) {
+        return -1;
+    }
+    snprintf(tmp_path, path_len + 32, "%s.tmp.%ld", path, (long)getpid());
+
+    int fd = open(tmp_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        free(tmp_path);
+        return -1;
+    }
+
+    // Guard builds poison red zones inside the region; write a copy with those bytes zeroed
+    const unsigned char *data = base;
+#ifdef SIMPLE_MEMORY_ALLOCATOR_GUARD
+    unsigned char *bounce = malloc(allocator->used);
+    if (bounce == NULL) {
+        close(fd);
+        unlink(tmp_path);
+        free(tmp_path);
+        return -1;
+    }
+    memory_guard_copy_live(bounce, base, allocator->used);
+    data = bounce;
+#endif
+
+    // The gap between header and data is left as a hole
+    int result = -1;
+    if (write_all(fd, &header, sizeof(header)) == 0 && lseek(fd, (off_t)header.data_offset, SEEK_SET) >= 0 &&
+        write_all(fd, data, allocator->used) == 0) {
+        result = 0;
+    }
+#ifdef SIMPLE_MEMORY_ALLOCATOR_GUARD
+    free(bounce);
+#endif
+    if (close(fd) != 0) {
+        result = -1;
+    }
+    if (result == 0 && rename(tmp_path, path) != 0) {
+        result = -1;
+    }
+    if (result != 0) {
+        unlink(tmp_path);
+    }
+
+    free(tmp_path);
+    return result;
+}
+
+// Initialize the snapshot to zero state
+void arena_snapshot_init(ArenaSnapshot *snapshot) {
+    if (snapshot != NULL) {
+        memset(snapshot, 0, sizeof(*snapshot));
+    }
+}
+
+// Map and validate a snapshot file
+// Returns 0 on success, -1 on failure
+int arena_snapshot_open(ArenaSnapshot *snapshot, const char *path) {
+    if (snapshot == NULL || path == NULL) {
+        return -1;
+    }
+    arena_snapshot_init(snapshot);
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(ArenaSnapshotHeader)) {
+        close(fd);
+        return -1;
+    }
+
+    size_t length = (size_t)st.st_size;
+    void *mapping = mmap(NULL, length, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);  // The mapping keeps the file referenced
+    if (mapping == MAP_FAILED) {
+        return -1;
+    }
+
+    const ArenaSnapshotHeader *header = mapping;
+    if (memcmp(header->magic, ARENA_SNAPSHOT_MAGIC, sizeof(ARENA_SNAPSHOT_MAGIC)) != 0 ||
+        header->version != ARENA_SNAPSHOT_VERSION || header->pointer_size != sizeof(void *) ||
+        header->data_offset < sizeof(*header) || header->data_offset > length || header->size == 0 ||
+        header->size > length - header->data_offset || header->root > header->size) {
+        munmap(mapping, length);
+        return -1;
+    }
+
+    // Start readahead now instead of faulting the first lookups one by one
+    madvise(mapping, length, MADV_WILLNEED);
+
+    snapshot->mapping = mapping;
+    snapshot->mapping_length = length;
+    snapshot->data = (const unsigned char *)mapping + header->data_offset;
+    snapshot->size = (size_t)header->size;
+    snapshot->root = header->root != 0 ? (const unsigned char *)snapshot->data + (header->root - 1) : NULL;
+    return 0;
+}
+
+// Entry point of the snapshot
+const void *arena_snapshot_root(const ArenaSnapshot *snapshot) {
+    return snapshot != NULL ? snapshot->root : NULL;
+}
+
+// Bounds check against the data region
+int arena_snapshot_contains(const ArenaSnapshot *snapshot, const void *ptr) {
+    if (snapshot == NULL || snapshot->data == NULL || ptr == NULL) {
+        return 0;
+    }
+    const unsigned char *p = ptr;
+    const unsigned char *data = snapshot->data;
+    return p >= data && p < data + snapshot->size;
+}
+
+// Unmap the snapshot
+void arena_snapshot_close(ArenaSnapshot *snapshot) {
+    if (snapshot != NULL && snapshot->mapping != NULL) {
+        munmap(snapshot->mapping, snapshot->mapping_length);
+        arena_snapshot_init(snapshot);
+    }
+}
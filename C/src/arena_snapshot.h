@@ -0,0 +1,65 @@
+#ifndef ARENA_SNAPSHOT_H
+#define ARENA_SNAPSHOT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "simple_memory_allocator.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Self-relative pointer: stores target minus its own address, so a structure
+// linked with these stays valid wherever its memory is mapped. 0 is NULL
+// (a relative pointer cannot point at itself)
+typedef intptr_t ArenaRelPtr;
+
+// Point `rel` at target (NULL clears it)
+static inline void arena_relptr_set(ArenaRelPtr *rel, const void *target) {
+    *rel = target != NULL ? (intptr_t)((uintptr_t)target - (uintptr_t)rel) : 0;
+}
+
+// Resolve `rel` against its current address (NULL if unset)
+static inline void *arena_relptr_get(const ArenaRelPtr *rel) {
+    return *rel != 0 ? (void *)((uintptr_t)rel + (uintptr_t)*rel) : NULL;
+}
+
+// Read-only view of a snapshot file mapped into this process
+typedef struct {
+    void *mapping;          // Whole file, header included
+    size_t mapping_length;
+    const void *data;       // Copy of the arena's used region
+    size_t size;
+    const void *root;       // Entry point recorded by arena_snapshot_write (may be NULL)
+} ArenaSnapshot;
+
+// Write the arena's used region and a root object to `path`. Every pointer
+// inside the region must be an ArenaRelPtr (or point nowhere); raw pointers
+// are copied verbatim. The file is replaced atomically via rename(), so
+// processes that already mapped the old one keep a consistent view.
+// Returns 0 on success, -1 if the arena spans several blocks, is empty,
+// root lies outside the used region, or the file cannot be written
+int arena_snapshot_write(const SimpleMemoryAllocator *allocator, const void *root, const char *path);
+
+// Initialize snapshot struct to zero state
+void arena_snapshot_init(ArenaSnapshot *snapshot);
+
+// Map a snapshot read-only and shared (the pages come from the page cache)
+// Data keeps its original address modulo the page size, so alignments up to
+// a page still hold. Returns 0 on success, -1 on I/O error or a bad header
+int arena_snapshot_open(ArenaSnapshot *snapshot, const char *path);
+
+// Entry point of an open snapshot (NULL if none was recorded)
+const void *arena_snapshot_root(const ArenaSnapshot *snapshot);
+
+// Check whether ptr points into the snapshot's data
+int arena_snapshot_contains(const ArenaSnapshot *snapshot, const void *ptr);
+
+// Unmap the snapshot
+void arena_snapshot_close(ArenaSnapshot *snapshot);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,146 @@
+/*
+ * Concurrent memory allocator
+ *
+ * Lock-free bump allocator over a SimpleMemoryAllocator pool. The default
+ * path rounds every size to the pool alignment, so a bare fetch-add keeps
+ * all offsets aligned, but a failed fetch-add still moves the offset past
+ * the end. Explicit alignments need to pad the offset first and therefore
+ * use a compare-and-swap loop, which never moves the offset on failure.
+ *
+ * Offsets only need to be unique, so relaxed ordering is enough; publishing
+ * the contents of an allocation to other threads is up to the caller.
+ */
+
+#include "concurrent_memory_allocator.h"
+#include "memory_guard.h"
+#include <stdint.h>
+
+// Initialize the allocator to zero state
+void concurrent_memory_allocator_init(ConcurrentMemoryAllocator *allocator) {
+    simple_memory_allocator_init(&allocator->pool);
+    allocator->base = NULL;
+    allocator->capacity = 0;
+    allocator->alignment = 0;
+    atomic_init(&allocator->used, 0);
+}
+
+// Create allocator with a memory pool of given size
+// Returns 0 on success, -1 on failure
+int concurrent_memory_allocator_create(ConcurrentMemoryAllocator *allocator, size_t pool_size) {
+    return concurrent_memory_allocator_create_with_options(allocator, pool_size, NULL);
+}
+
+// Create allocator with explicit options
+// Returns 0 on success, -1 on failure
+int concurrent_memory_allocator_create_with_options(ConcurrentMemoryAllocator *allocator, size_t pool_size,
+                                                    const SimpleMemoryAllocatorOptions *options) {
+    if (allocator == NULL || (options != NULL && options->growable)) {
+        return -1;  // Chaining blocks cannot be done without a lock
+    }
+
+    concurrent_memory_allocator_init(allocator);
+    if (simple_memory_allocator_create_with_options(&allocator->pool, pool_size, options) != 0) {
+        return -1;
+    }
+
+    size_t alignment = allocator->pool.options.alignment;
+    uintptr_t start = (uintptr_t)allocator->pool.memory;
+    uintptr_t aligned = (start + (alignment - 1)) & ~((uintptr_t)alignment - 1);
+    size_t padding = (size_t)(aligned - start);
+
+    if (padding >= allocator->pool.size) {
+        simple_memory_allocator_destroy(&allocator->pool);
+        return -1;
+    }
+
+    allocator->base = (unsigned char *)aligned;
+    allocator->capacity = allocator->pool.size - padding;
+    allocator->alignment = alignment;
+#ifdef SIMPLE_MEMORY_ALLOCATOR_GUARD
+    // The block is carved here rather than through the pool's bump path
+    memory_guard_unpoison(allocator->pool.memory, allocator->pool.size);
+#endif
+
+    return 0;
+}
+
+// Allocate memory from the pool
+// Returns pointer to allocated memory, or NULL if not enough space
+void *concurrent_memory_allocator_alloc(ConcurrentMemoryAllocator *allocator, size_t size) {
+    if (allocator == NULL || allocator->base == NULL || size == 0) {
+        return NULL;
+    }
+
+    size_t mask = allocator->alignment - 1;
+    size_t aligned_size = (size + mask) & ~mask;
+    if (aligned_size < size || aligned_size > allocator->capacity) {
+        return NULL;
+    }
+
+    size_t offset = atomic_fetch_add_explicit(&allocator->used, aligned_size, memory_order_relaxed);
+    if (offset > allocator->capacity - aligned_size) {
+        return NULL;  // Not enough space; the overshoot is harmless until reset
+    }
+
+    return allocator->base + offset;
+}
+
+// Allocate memory whose address is a multiple of `alignment`
+// Returns NULL if alignment is not a power of two or there is not enough space
+void *concurrent_memory_allocator_alloc_aligned(ConcurrentMemoryAllocator *allocator, size_t size, size_t alignment) {
+    if (allocator == NULL || allocator->base == NULL || size == 0 ||
+        alignment == 0 || (alignment & (alignment - 1)) != 0) {
+        return NULL;
+    }
+
+    if (alignment < allocator->alignment) {
+        alignment = allocator->alignment;
+    }
+
+    size_t mask = allocator->alignment - 1;
+    size_t aligned_size = (size + mask) & ~mask;
+    if (aligned_size < size || aligned_size > allocator->capacity) {
+        return NULL;
+    }
+
+    uintptr_t base = (uintptr_t)allocator->base;
+    size_t used = atomic_load_explicit(&allocator->used, memory_order_relaxed);
+    size_t offset;
+
+    do {
+        uintptr_t cursor = base + used;
+        uintptr_t aligned = (cursor + (alignment - 1)) & ~((uintptr_t)alignment - 1);
+        offset = (size_t)(aligned - base);
+        if (offset > allocator->capacity - aligned_size) {
+            return NULL;  // Not enough space
+        }
+    } while (!atomic_compare_exchange_weak_explicit(&allocator->used, &used, offset + aligned_size,
+                                                    memory_order_relaxed, memory_order_relaxed));
+
+    return allocator->base + offset;
+}
+
+// Bytes handed out so far
+size_t concurrent_memory_allocator_used(const ConcurrentMemoryAllocator *allocator) {
+    if (allocator == NULL) {
+        return 0;
+    }
+
+    size_t used = atomic_load_explicit(&allocator->used, memory_order_relaxed);
+    return used < allocator->capacity ? used : allocator->capacity;
+}
+
+// Reset allocator - all threads must be quiescent
+void concurrent_memory_allocator_reset(ConcurrentMemoryAllocator *allocator) {
+    if (allocator != NULL) {
+        atomic_store_explicit(&allocator->used, 0, memory_order_release);
+    }
+}
+
+// Destroy allocator and free the memory pool - all threads must be quiescent
+void concurrent_memory_allocator_destroy(ConcurrentMemoryAllocator *allocator) {
+    if (allocator != NULL) {
+        simple_memory_allocator_destroy(&allocator->pool);
+        concurrent_memory_allocator_init(allocator);
+    }
+}
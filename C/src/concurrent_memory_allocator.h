@@ -0,0 +1,51 @@
+#ifndef CONCURRENT_MEMORY_ALLOCATOR_H
+#define CONCURRENT_MEMORY_ALLOCATOR_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include "simple_memory_allocator.h"
+
+/*
+ * Thread-safe bump allocator. Any number of threads may call alloc at the
+ * same time; the offset is advanced with a single atomic fetch-add (or a
+ * CAS loop for explicit alignments), so no lock is ever taken.
+ *
+ * Quiescence rules: create, reset and destroy are NOT thread-safe. Before
+ * calling reset or destroy, every allocating thread must have stopped and
+ * must no longer touch memory handed out by the arena.
+ */
+typedef struct {
+    SimpleMemoryAllocator pool;  // Owns the backing block; its own used counter stays 0
+    unsigned char *base;         // First address aligned to the default alignment
+    size_t capacity;             // Usable bytes from base
+    size_t alignment;            // Default alignment (sizes are rounded to it)
+    _Atomic size_t used;         // Bump offset from base (may overshoot capacity when full)
+} ConcurrentMemoryAllocator;
+
+// Initialize allocator struct to zero state
+void concurrent_memory_allocator_init(ConcurrentMemoryAllocator *allocator);
+
+// Create allocator with a memory pool of given size
+int concurrent_memory_allocator_create(ConcurrentMemoryAllocator *allocator, size_t pool_size);
+
+// Create allocator with explicit options (growable pools are rejected)
+int concurrent_memory_allocator_create_with_options(ConcurrentMemoryAllocator *allocator, size_t pool_size,
+                                                    const SimpleMemoryAllocatorOptions *options);
+
+// Allocate memory from the pool (thread-safe, returns NULL if not enough space)
+void *concurrent_memory_allocator_alloc(ConcurrentMemoryAllocator *allocator, size_t size);
+
+// Allocate memory aligned to `alignment` (thread-safe, any power of two)
+// Uses a CAS loop, so a failed request leaves the remaining space usable
+void *concurrent_memory_allocator_alloc_aligned(ConcurrentMemoryAllocator *allocator, size_t size, size_t alignment);
+
+// Bytes handed out so far (thread-safe snapshot)
+size_t concurrent_memory_allocator_used(const ConcurrentMemoryAllocator *allocator);
+
+// Reset allocator (requires quiescence, see above)
+void concurrent_memory_allocator_reset(ConcurrentMemoryAllocator *allocator);
+
+// Destroy allocator and free the memory pool (requires quiescence)
+void concurrent_memory_allocator_destroy(ConcurrentMemoryAllocator *allocator);
+
+#endif
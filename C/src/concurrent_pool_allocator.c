@@ -0,0 +1,290 @@
+/*
+ * Concurrent pool allocator
+ *
+ * Lock-free counterpart of the pool allocator. Like the serial pool it is
+ * lazy: untouched blocks are claimed from a high-water index with one
+ * fetch-add, and only recycled blocks go through the free stacks. Heads
+ * are 64-bit {tag, index + 1} words; every successful CAS bumps the tag,
+ * so a head that was popped and pushed back no longer compares equal.
+ */
+
+#include "concurrent_pool_allocator.h"
+#include <stdlib.h>
+
+// Link words at the start of a free block
+typedef struct {
+    _Atomic uint32_t next;        // Next block in the list or batch (index + 1, 0 = end)
+    _Atomic uint32_t next_batch;  // Depot only, in a batch's first block: the next batch
+} PoolLink;
+
+#define HEAD_REF(head) ((uint32_t)(head))
+#define HEAD_TAG(head) ((uint32_t)((head) >> 32))
+#define MAKE_HEAD(tag, ref) (((uint64_t)(uint32_t)(tag) << 32) | (uint32_t)(ref))
+
+static inline PoolLink *link_at(const ConcurrentPoolAllocator *pool, uint32_t ref) {
+    return (PoolLink *)(pool->memory + (size_t)(ref - 1) * pool->block_size);
+}
+
+static inline uint32_t ref_of(const ConcurrentPoolAllocator *pool, const void *ptr) {
+    return (uint32_t)(((const unsigned char *)ptr - pool->memory) / pool->block_size) + 1;
+}
+
+static inline _Atomic uint32_t *link_field(PoolLink *link, int batch) {
+    return batch ? &link->next_batch : &link->next;
+}
+
+// Pop the top entry of a stack (batch selects the depot link)
+// Returns its ref, or 0 if the stack is empty
+static uint32_t stack_pop(const ConcurrentPoolAllocator *pool, _Atomic uint64_t *stack, int batch) {
+    uint64_t head = atomic_load_explicit(stack, memory_order_acquire);
+    for (;;) {
+        uint32_t ref = HEAD_REF(head);
+        if (ref == 0) {
+            return 0;
+        }
+        // May read a block another thread just took; the tag makes that CAS fail
+        uint32_t next = atomic_load_explicit(link_field(link_at(pool, ref), batch), memory_order_relaxed);
+        if (atomic_compare_exchange_weak_explicit(stack, &head, MAKE_HEAD(HEAD_TAG(head) + 1, next),
+                                                  memory_order_acquire, memory_order_acquire)) {
+            return ref;
+        }
+    }
+}
+
+// Push an entry whose stack link lives in block `first`; `last` carries the
+// link for plain chains (first == last for a single block or a depot batch)
+static void stack_push(const ConcurrentPoolAllocator *pool, _Atomic uint64_t *stack, int batch, uint32_t first,
+                       uint32_t last) {
+    _Atomic uint32_t *link = link_field(link_at(pool, last), batch);
+    uint64_t head = atomic_load_explicit(stack, memory_order_relaxed);
+    do {
+        atomic_store_explicit(link, HEAD_REF(head), memory_order_relaxed);
+    } while (!atomic_compare_exchange_weak_explicit(stack, &head, MAKE_HEAD(HEAD_TAG(head) + 1, first),
+                                                    memory_order_release, memory_order_relaxed));
+}
+
+// Link blocks[0..count) into one chain through their `next` words
+static void link_chain(const ConcurrentPoolAllocator *pool, void *const *blocks, size_t count) {
+    for (size_t i = 0; i + 1 < count; i++) {
+        atomic_store_explicit(&((PoolLink *)blocks[i])->next, ref_of(pool, blocks[i + 1]), memory_order_relaxed);
+    }
+    atomic_store_explicit(&((PoolLink *)blocks[count - 1])->next, 0, memory_order_relaxed);
+}
+
+// Claim up to `count` never-used blocks
+// Returns the index of the first one, and the number claimed in *claimed
+static size_t claim_fresh(ConcurrentPoolAllocator *pool, size_t count, size_t *claimed) {
+    *claimed = 0;
+    if (atomic_load_explicit(&pool->next_unused, memory_order_relaxed) >= pool->block_count) {
+        return 0;  // Exhausted: skip the fetch-add so the counter stops growing
+    }
+    size_t start = atomic_fetch_add_explicit(&pool->next_unused, count, memory_order_relaxed);
+    if (start < pool->block_count) {
+        size_t left = pool->block_count - start;
+        *claimed = count < left ? count : left;
+    }
+    return start;
+}
+
+// Initialize the pool to zero state
+void concurrent_pool_allocator_init(ConcurrentPoolAllocator *pool) {
+    pool->memory = NULL;
+    pool->block_size = 0;
+    pool->block_count = 0;
+    atomic_init(&pool->free_head, 0);
+    atomic_init(&pool->depot_head, 0);
+    atomic_init(&pool->next_unused, 0);
+}
+
+// Create pool owning its memory
+// Returns 0 on success, -1 on failure
+int concurrent_pool_allocator_create(ConcurrentPoolAllocator *pool, size_t block_size, size_t block_count) {
+    if (pool == NULL || block_size == 0 || block_count == 0 || block_count >= UINT32_MAX) {
+        return -1;
+    }
+
+    // Blocks must hold both link words and keep 8-byte alignment
+    size_t rounded = block_size < sizeof(PoolLink) ? sizeof(PoolLink) : block_size;
+    rounded = (rounded + 7) & ~((size_t)7);
+    if (rounded < block_size || block_count > SIZE_MAX / rounded) {
+        return -1;
+    }
+
+    concurrent_pool_allocator_init(pool);
+    pool->memory = malloc(rounded * block_count);
+    if (pool->memory == NULL) {
+        return -1;
+    }
+    pool->block_size = rounded;
+    pool->block_count = block_count;
+
+    return 0;
+}
+
+// Allocate one block
+// Returns pointer to the block, or NULL if the pool is exhausted
+void *concurrent_pool_allocator_alloc(ConcurrentPoolAllocator *pool) {
+    if (pool == NULL || pool->memory == NULL) {
+        return NULL;
+    }
+
+    uint32_t ref = stack_pop(pool, &pool->free_head, 0);
+    if (ref != 0) {
+        return link_at(pool, ref);
+    }
+
+    // Batches parked by magazines: keep the first block, free-list the rest
+    ref = stack_pop(pool, &pool->depot_head, 1);
+    if (ref != 0) {
+        uint32_t rest = atomic_load_explicit(&link_at(pool, ref)->next, memory_order_relaxed);
+        if (rest != 0) {
+            uint32_t last = rest;
+            uint32_t next;
+            while ((next = atomic_load_explicit(&link_at(pool, last)->next, memory_order_relaxed)) != 0) {
+                last = next;
+            }
+            stack_push(pool, &pool->free_head, 0, rest, last);
+        }
+        return link_at(pool, ref);
+    }
+
+    size_t claimed;
+    size_t index = claim_fresh(pool, 1, &claimed);
+    return claimed != 0 ? pool->memory + index * pool->block_size : NULL;
+}
+
+// Return a block to the pool
+void concurrent_pool_allocator_free(ConcurrentPoolAllocator *pool, void *ptr) {
+    if (pool == NULL || ptr == NULL) {
+        return;
+    }
+    uint32_t ref = ref_of(pool, ptr);
+    stack_push(pool, &pool->free_head, 0, ref, ref);
+}
+
+// Check whether ptr points at a block inside the pool
+int concurrent_pool_allocator_owns(const ConcurrentPoolAllocator *pool, const void *ptr) {
+    if (pool == NULL || pool->memory == NULL || ptr == NULL) {
+        return 0;
+    }
+
+    uintptr_t start = (uintptr_t)pool->memory;
+    uintptr_t addr = (uintptr_t)ptr;
+    return addr >= start && addr < start + pool->block_size * pool->block_count;
+}
+
+// Return every block to the pool
+void concurrent_pool_allocator_reset(ConcurrentPoolAllocator *pool) {
+    if (pool != NULL) {
+        atomic_store(&pool->free_head, 0);
+        atomic_store(&pool->depot_head, 0);
+        atomic_store(&pool->next_unused, 0);
+    }
+}
+
+// Destroy pool and free its memory
+void concurrent_pool_allocator_destroy(ConcurrentPoolAllocator *pool) {
+    if (pool != NULL) {
+        free(pool->memory);
+        concurrent_pool_allocator_init(pool);
+    }
+}
+
+// Attach a magazine to a pool
+void concurrent_pool_magazine_init(ConcurrentPoolMagazine *magazine, ConcurrentPoolAllocator *pool, size_t capacity) {
+    if (capacity == 0) {
+        capacity = CONCURRENT_POOL_MAGAZINE_DEFAULT;
+    }
+    if (capacity < 2) {
+        capacity = 2;
+    }
+    if (capacity > CONCURRENT_POOL_MAGAZINE_MAX) {
+        capacity = CONCURRENT_POOL_MAGAZINE_MAX;
+    }
+    magazine->pool = pool;
+    magazine->count = 0;
+    magazine->capacity = capacity;
+}
+
+// Refill an empty magazine with up to half its capacity
+// Returns one block, or NULL if the pool is exhausted
+void *concurrent_pool_magazine_alloc_slow(ConcurrentPoolMagazine *magazine) {
+    ConcurrentPoolAllocator *pool = magazine != NULL ? magazine->pool : NULL;
+    if (pool == NULL || pool->memory == NULL) {
+        return NULL;
+    }
+    size_t batch = magazine->capacity / 2;
+
+    // A whole batch from the depot in one CAS
+    uint32_t ref = stack_pop(pool, &pool->depot_head, 1);
+    if (ref != 0) {
+        while (ref != 0 && magazine->count < magazine->capacity) {
+            magazine->blocks[magazine->count++] = link_at(pool, ref);
+            ref = atomic_load_explicit(&link_at(pool, ref)->next, memory_order_relaxed);
+        }
+        // Batches spilled by a larger magazine may not fit; the tail goes to the free list
+        if (ref != 0) {
+            uint32_t last = ref;
+            uint32_t next;
+            while ((next = atomic_load_explicit(&link_at(pool, last)->next, memory_order_relaxed)) != 0) {
+                last = next;
+            }
+            stack_push(pool, &pool->free_head, 0, ref, last);
+        }
+        return magazine->blocks[--magazine->count];
+    }
+
+    // Single recycled blocks, then untouched ones in one fetch-add
+    while (magazine->count < batch && (ref = stack_pop(pool, &pool->free_head, 0)) != 0) {
+        magazine->blocks[magazine->count++] = link_at(pool, ref);
+    }
+    if (magazine->count < batch) {
+        size_t claimed;
+        size_t index = claim_fresh(pool, batch - magazine->count, &claimed);
+        // Hand out in address order: the last slot is popped first
+        for (size_t i = claimed; i-- > 0;) {
+            magazine->blocks[magazine->count++] = pool->memory + (index + i) * pool->block_size;
+        }
+    }
+
+    return magazine->count != 0 ? magazine->blocks[--magazine->count] : NULL;
+}
+
+// Spill half of a full magazine to the depot, then cache ptr
+void concurrent_pool_magazine_free_slow(ConcurrentPoolMagazine *magazine, void *ptr) {
+    if (magazine == NULL || magazine->pool == NULL || ptr == NULL) {
+        return;
+    }
+    ConcurrentPoolAllocator *pool = magazine->pool;
+    size_t batch = magazine->capacity / 2;
+
+    // The oldest half leaves; the recently freed (cache-warm) blocks stay
+    link_chain(pool, magazine->blocks, batch);
+    uint32_t first = ref_of(pool, magazine->blocks[0]);
+    stack_push(pool, &pool->depot_head, 1, first, first);
+
+    magazine->count -= batch;
+    for (size_t i = 0; i < magazine->count; i++) {
+        magazine->blocks[i] = magazine->blocks[batch + i];
+    }
+    magazine->blocks[magazine->count++] = ptr;
+}
+
+// Return every cached block to the shared free list with one CAS
+void concurrent_pool_magazine_flush(ConcurrentPoolMagazine *magazine) {
+    if (magazine == NULL || magazine->pool == NULL || magazine->count == 0) {
+        return;
+    }
+    ConcurrentPoolAllocator *pool = magazine->pool;
+    link_chain(pool, magazine->blocks, magazine->count);
+    stack_push(pool, &pool->free_head, 0, ref_of(pool, magazine->blocks[0]),
+               ref_of(pool, magazine->blocks[magazine->count - 1]));
+    magazine->count = 0;
+}
+
+// Forget cached blocks
+void concurrent_pool_magazine_reset(ConcurrentPoolMagazine *magazine) {
+    if (magazine != NULL) {
+        magazine->count = 0;
+    }
+}
@@ -0,0 +1,107 @@
+#ifndef CONCURRENT_POOL_ALLOCATOR_H
+#define CONCURRENT_POOL_ALLOCATOR_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Largest per-thread magazine
+#define CONCURRENT_POOL_MAGAZINE_MAX 64
+
+// Default magazine capacity (blocks moved per depot exchange = capacity / 2)
+#define CONCURRENT_POOL_MAGAZINE_DEFAULT 32
+
+/*
+ * Thread-safe fixed-size pool. Free blocks sit on a Treiber stack whose
+ * head packs a block index with a modification tag into one 64-bit word,
+ * so a CAS fails if the head was popped and pushed back in between (ABA).
+ * Block links are 32-bit indices stored in the free blocks themselves.
+ *
+ * Magazines (below) add a per-thread cache and a depot: a second lock-free
+ * stack whose entries are whole chains of blocks, so a thread moves a batch
+ * to or from the shared state with a single CAS.
+ *
+ * Any thread may free a block allocated by any other. create, reset and
+ * destroy are NOT thread-safe (same quiescence rules as the concurrent arena).
+ * The tag is 32 bits: ABA needs a thread to stall across 2^32 operations.
+ */
+typedef struct {
+    unsigned char *memory;
+    size_t block_size;
+    size_t block_count;
+    _Atomic uint64_t free_head;   // Single blocks: tag << 32 | (index + 1)
+    _Atomic uint64_t depot_head;  // Batches: tag << 32 | (index of the batch's first block + 1)
+    _Atomic size_t next_unused;   // Blocks at or above this index were never handed out
+} ConcurrentPoolAllocator;
+
+// Per-thread cache of free blocks (use from one thread only)
+typedef struct {
+    ConcurrentPoolAllocator *pool;
+    size_t count;
+    size_t capacity;
+    void *blocks[CONCURRENT_POOL_MAGAZINE_MAX];
+} ConcurrentPoolMagazine;
+
+// Initialize pool struct to zero state
+void concurrent_pool_allocator_init(ConcurrentPoolAllocator *pool);
+
+// Create pool owning memory for block_count blocks of block_size bytes
+// (block_count must fit a 32-bit index)
+int concurrent_pool_allocator_create(ConcurrentPoolAllocator *pool, size_t block_size, size_t block_count);
+
+// Allocate one block (thread-safe, returns NULL if the pool is exhausted)
+void *concurrent_pool_allocator_alloc(ConcurrentPoolAllocator *pool);
+
+// Return a block to the pool (thread-safe, NULL is ignored)
+void concurrent_pool_allocator_free(ConcurrentPoolAllocator *pool, void *ptr);
+
+// Check whether ptr points into the pool's memory
+int concurrent_pool_allocator_owns(const ConcurrentPoolAllocator *pool, const void *ptr);
+
+// Return every block to the pool (requires quiescence, magazines must be reset)
+void concurrent_pool_allocator_reset(ConcurrentPoolAllocator *pool);
+
+// Destroy pool and free its memory (requires quiescence)
+void concurrent_pool_allocator_destroy(ConcurrentPoolAllocator *pool);
+
+// Attach a magazine (capacity 0 = default, capped at CONCURRENT_POOL_MAGAZINE_MAX)
+void concurrent_pool_magazine_init(ConcurrentPoolMagazine *magazine, ConcurrentPoolAllocator *pool, size_t capacity);
+
+// Refill path: takes a batch from the depot, the free list or fresh blocks
+void *concurrent_pool_magazine_alloc_slow(ConcurrentPoolMagazine *magazine);
+
+// Spill path: hands half the magazine to the depot as one batch
+void concurrent_pool_magazine_free_slow(ConcurrentPoolMagazine *magazine, void *ptr);
+
+// Allocate from the thread's magazine
+static inline void *concurrent_pool_magazine_alloc(ConcurrentPoolMagazine *magazine) {
+    if (magazine->count != 0) {
+        return magazine->blocks[--magazine->count];
+    }
+    return concurrent_pool_magazine_alloc_slow(magazine);
+}
+
+// Free into the thread's magazine (the block may come from any thread)
+static inline void concurrent_pool_magazine_free(ConcurrentPoolMagazine *magazine, void *ptr) {
+    if (ptr != NULL && magazine->count < magazine->capacity) {
+        magazine->blocks[magazine->count++] = ptr;
+        return;
+    }
+    concurrent_pool_magazine_free_slow(magazine, ptr);
+}
+
+// Return every cached block to the pool (call before the thread exits)
+void concurrent_pool_magazine_flush(ConcurrentPoolMagazine *magazine);
+
+// Drop cached blocks without returning them (after a pool reset)
+void concurrent_pool_magazine_reset(ConcurrentPoolMagazine *magazine);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
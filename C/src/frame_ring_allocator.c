@@ -0,0 +1,134 @@
+/*
+ * Frame ring allocator
+ *
+ * Production version of the tutorial's frame allocator, generalised from
+ * one arena reset per frame to a ring of arenas. The hot path is the
+ * arena's inline bump; the only per-frame work is one reset in advance(),
+ * plus a walk of the retiring buffer's block chain when stats are enabled.
+ */
+
+#include "frame_ring_allocator.h"
+#include <string.h>
+
+// Initialize the ring to zero state
+void frame_ring_allocator_init(FrameRingAllocator *ring) {
+    for (size_t i = 0; i < FRAME_RING_MAX_DEPTH; i++) {
+        simple_memory_allocator_init(&ring->buffers[i]);
+    }
+    ring->depth = 0;
+    ring->current = 0;
+    ring->frame = 0;
+    ring->track_stats = 0;
+    memset(&ring->stats, 0, sizeof(ring->stats));
+}
+
+// Create ring with default arena options
+// Returns 0 on success, -1 on failure
+int frame_ring_allocator_create(FrameRingAllocator *ring, size_t depth, size_t buffer_size) {
+    return frame_ring_allocator_create_with_options(ring, depth, buffer_size, NULL);
+}
+
+// Create ring with explicit arena options
+// Returns 0 on success, -1 on failure
+int frame_ring_allocator_create_with_options(FrameRingAllocator *ring, size_t depth, size_t buffer_size,
+                                             const SimpleMemoryAllocatorOptions *options) {
+    if (ring == NULL || depth < 2 || depth > FRAME_RING_MAX_DEPTH) {
+        return -1;
+    }
+
+    frame_ring_allocator_init(ring);
+    for (size_t i = 0; i < depth; i++) {
+        if (simple_memory_allocator_create_with_options(&ring->buffers[i], buffer_size, options) != 0) {
+            frame_ring_allocator_destroy(ring);
+            return -1;
+        }
+    }
+    ring->depth = depth;
+
+    return 0;
+}
+
+// Allocate aligned memory from the current frame
+void *frame_ring_allocator_alloc_aligned(FrameRingAllocator *ring, size_t size, size_t alignment) {
+    if (ring == NULL) {
+        return NULL;
+    }
+    return simple_memory_allocator_alloc_aligned(&ring->buffers[ring->current], size, alignment);
+}
+
+// Arena for the frame `age` frames before the current one
+SimpleMemoryAllocator *frame_ring_allocator_buffer(FrameRingAllocator *ring, size_t age) {
+    if (ring == NULL || age >= ring->depth || age > ring->frame) {
+        return NULL;
+    }
+    return &ring->buffers[(ring->current + ring->depth - age) % ring->depth];
+}
+
+static void record_frame(FrameRingAllocator *ring) {
+    const SimpleMemoryAllocator *buffer = &ring->buffers[ring->current];
+    FrameRingFrameStats *last = &ring->stats.last;
+
+    last->frame = ring->frame;
+    last->bytes_used = simple_memory_allocator_bytes_used(buffer);
+    last->block_count = simple_memory_allocator_block_count(buffer);
+
+    ring->stats.frames++;
+    ring->stats.total_bytes += last->bytes_used;
+    if (last->bytes_used > ring->stats.peak_bytes) {
+        ring->stats.peak_bytes = last->bytes_used;
+    }
+    ring->stats.grown_frames += last->block_count > 1;
+}
+
+// Retire the current frame and recycle the oldest buffer
+void frame_ring_allocator_advance(FrameRingAllocator *ring) {
+    if (ring == NULL || ring->depth == 0) {
+        return;
+    }
+    if (ring->track_stats) {
+        record_frame(ring);
+    }
+
+    ring->current = (ring->current + 1) % ring->depth;
+    ring->frame++;
+    simple_memory_allocator_reset(&ring->buffers[ring->current]);
+}
+
+// Current frame number
+size_t frame_ring_allocator_frame(const FrameRingAllocator *ring) {
+    return ring != NULL ? ring->frame : 0;
+}
+
+// Enable or disable statistics
+void frame_ring_allocator_set_stats(FrameRingAllocator *ring, int enabled) {
+    if (ring == NULL) {
+        return;
+    }
+    if (enabled && !ring->track_stats) {
+        memset(&ring->stats, 0, sizeof(ring->stats));
+    }
+    ring->track_stats = enabled != 0;
+}
+
+// Copy statistics
+// Returns 0 if statistics are being collected, -1 otherwise
+int frame_ring_allocator_get_stats(const FrameRingAllocator *ring, FrameRingStats *out) {
+    if (ring == NULL || out == NULL || !ring->track_stats) {
+        return -1;
+    }
+    *out = ring->stats;
+    return 0;
+}
+
+// Destroy all buffers
+void frame_ring_allocator_destroy(FrameRingAllocator *ring) {
+    if (ring == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < FRAME_RING_MAX_DEPTH; i++) {
+        simple_memory_allocator_destroy(&ring->buffers[i]);
+    }
+    ring->depth = 0;
+    ring->current = 0;
+    ring->frame = 0;
+}
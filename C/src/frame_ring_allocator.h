@@ -0,0 +1,86 @@
+#ifndef FRAME_RING_ALLOCATOR_H
+#define FRAME_RING_ALLOCATOR_H
+
+#include <stddef.h>
+#include "simple_memory_allocator.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Largest supported ring depth
+#define FRAME_RING_MAX_DEPTH 8
+
+// Usage of one retired frame
+typedef struct {
+    size_t frame;        // Frame number (counts advance() calls)
+    size_t bytes_used;   // Bytes handed out during the frame, padding included
+    size_t block_count;  // Blocks the frame's buffer held (> 1 = it had to grow)
+} FrameRingFrameStats;
+
+// Totals over retired frames, collected only while stats are enabled
+typedef struct {
+    size_t frames;             // Frames retired since stats were enabled
+    size_t total_bytes;        // Sum of bytes_used (average = total_bytes / frames)
+    size_t peak_bytes;         // Largest bytes_used
+    size_t grown_frames;       // Frames whose buffer chained extra blocks
+    FrameRingFrameStats last;  // Most recently retired frame
+} FrameRingStats;
+
+/*
+ * N-buffered frame allocator. Each frame bumps through its own arena;
+ * advance() moves to the next buffer and resets it, so memory allocated
+ * in frame N stays valid through frame N + depth - 1. Depth 2 is the classic
+ * double buffer: produce in frame N, consume in frame N + 1.
+ */
+typedef struct {
+    SimpleMemoryAllocator buffers[FRAME_RING_MAX_DEPTH];
+    size_t depth;
+    size_t current;  // Index of the buffer serving the current frame
+    size_t frame;    // Current frame number
+    int track_stats;
+    FrameRingStats stats;
+} FrameRingAllocator;
+
+// Initialize ring struct to zero state
+void frame_ring_allocator_init(FrameRingAllocator *ring);
+
+// Create `depth` buffers (2..FRAME_RING_MAX_DEPTH) of buffer_size bytes each
+int frame_ring_allocator_create(FrameRingAllocator *ring, size_t depth, size_t buffer_size);
+
+// Create with arena options applied to every buffer (NULL = same as create)
+int frame_ring_allocator_create_with_options(FrameRingAllocator *ring, size_t depth, size_t buffer_size,
+                                             const SimpleMemoryAllocatorOptions *options);
+
+// Allocate from the current frame (inline bump, see simple_memory_allocator_alloc_fast)
+static inline void *frame_ring_allocator_alloc(FrameRingAllocator *ring, size_t size) {
+    return simple_memory_allocator_alloc_fast(&ring->buffers[ring->current], size);
+}
+
+// Allocate from the current frame with explicit alignment
+void *frame_ring_allocator_alloc_aligned(FrameRingAllocator *ring, size_t size, size_t alignment);
+
+// Arena of the frame `age` frames back (0 = current), NULL if age >= depth
+SimpleMemoryAllocator *frame_ring_allocator_buffer(FrameRingAllocator *ring, size_t age);
+
+// End the current frame: rotate to the oldest buffer and reset it
+void frame_ring_allocator_advance(FrameRingAllocator *ring);
+
+// Current frame number
+size_t frame_ring_allocator_frame(const FrameRingAllocator *ring);
+
+// Start (non-zero) or stop collecting per-frame statistics; starting clears them
+void frame_ring_allocator_set_stats(FrameRingAllocator *ring, int enabled);
+
+// Copy the statistics into out
+// Returns 0 if statistics are being collected, -1 otherwise
+int frame_ring_allocator_get_stats(const FrameRingAllocator *ring, FrameRingStats *out);
+
+// Destroy every buffer
+void frame_ring_allocator_destroy(FrameRingAllocator *ring);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,284 @@
+/*
+ * Free list allocator
+ *
+ * Good-fit allocator with boundary-tag coalescing and two-level segregated
+ * free lists. The region ends with a zero-size "in use" sentinel header so
+ * the last block never looks past the end, and the first block always has
+ * FREELIST_PREV_IN_USE set.
+ */
+
+#include "freelist_allocator.h"
+#include <stdint.h>
+
+static inline size_t block_size(const FreeListBlock *block) {
+    return block->size & ~FREELIST_FLAGS;
+}
+
+static inline FreeListBlock *next_block(FreeListBlock *block) {
+    return (FreeListBlock *)((uint8_t *)block + block_size(block));
+}
+
+// Write the boundary tag at the end of a free block
+static inline void write_footer(FreeListBlock *block) {
+    size_t size = block_size(block);
+    *(size_t *)((uint8_t *)block + size - FREELIST_FOOTER_SIZE) = size;
+}
+
+static inline size_t floor_log2(size_t value) {
+    return sizeof(unsigned long) * 8 - 1 - (size_t)__builtin_clzl((unsigned long)value);
+}
+
+// Bin holding blocks of exactly this size class (rounding down)
+static inline void mapping_insert(size_t size, size_t *fl, size_t *sl) {
+    if (size < FREELIST_SMALL_SIZE) {
+        *fl = 0;
+        *sl = size / (FREELIST_SMALL_SIZE / FREELIST_SL_COUNT);
+    } else {
+        size_t log2 = floor_log2(size);
+        *fl = log2 - FREELIST_SMALL_LOG2 + 1;
+        *sl = (size >> (log2 - FREELIST_SL_LOG2)) ^ FREELIST_SL_COUNT;
+    }
+}
+
+// First bin whose every block is at least `size` (rounding up)
+static inline void mapping_search(size_t size, size_t *fl, size_t *sl) {
+    if (size >= FREELIST_SMALL_SIZE) {
+        size_t round = ((size_t)1 << (floor_log2(size) - FREELIST_SL_LOG2)) - 1;
+        if (size > SIZE_MAX - round) {
+            *fl = FREELIST_FL_COUNT;  // No bin can hold it
+            *sl = 0;
+            return;
+        }
+        size += round;
+    }
+    mapping_insert(size, fl, sl);
+}
+
+static inline void list_push(FreeListAllocator *a, FreeListBlock *block) {
+    size_t fl, sl;
+    mapping_insert(block_size(block), &fl, &sl);
+
+    block->prev = NULL;
+    block->next = a->bins[fl][sl];
+    if (block->next != NULL) {
+        block->next->prev = block;
+    }
+    a->bins[fl][sl] = block;
+    a->fl_bitmap |= (size_t)1 << fl;
+    a->sl_bitmap[fl] |= 1u << sl;
+}
+
+static inline void list_remove(FreeListAllocator *a, FreeListBlock *block) {
+    size_t fl, sl;
+    mapping_insert(block_size(block), &fl, &sl);
+
+    if (block->prev != NULL) {
+        block->prev->next = block->next;
+    } else {
+        a->bins[fl][sl] = block->next;
+        if (block->next == NULL) {
+            a->sl_bitmap[fl] &= ~(1u << sl);
+            if (a->sl_bitmap[fl] == 0) {
+                a->fl_bitmap &= ~((size_t)1 << fl);
+            }
+        }
+    }
+    if (block->next != NULL) {
+        block->next->prev = block->prev;
+    }
+}
+
+// Rounding up skips the bin that `size` itself maps to, even though some of
+// its blocks may fit. When nothing larger is free, scan that one bin so a
+// request close to the largest free block still succeeds.
+static FreeListBlock *find_in_own_bin(FreeListAllocator *a, size_t size) {
+    size_t fl, sl;
+    mapping_insert(size, &fl, &sl);
+
+    for (FreeListBlock *block = a->bins[fl][sl]; block != NULL; block = block->next) {
+        if (block_size(block) >= size) {
+            list_remove(a, block);
+            return block;
+        }
+    }
+    return NULL;
+}
+
+// Pop a free block of at least `size` bytes in bounded time
+static FreeListBlock *find_block(FreeListAllocator *a, size_t size) {
+    size_t fl, sl;
+    mapping_search(size, &fl, &sl);
+    if (fl >= FREELIST_FL_COUNT) {
+        return find_in_own_bin(a, size);
+    }
+
+    unsigned sl_map = a->sl_bitmap[fl] & (~0u << sl);
+    if (sl_map == 0) {
+        size_t fl_map = fl + 1 < FREELIST_FL_COUNT ? a->fl_bitmap & (~(size_t)0 << (fl + 1)) : 0;
+        if (fl_map == 0) {
+            return find_in_own_bin(a, size);
+        }
+        fl = (size_t)__builtin_ctzl((unsigned long)fl_map);
+        sl_map = a->sl_bitmap[fl];
+    }
+    sl = (size_t)__builtin_ctz(sl_map);
+
+    FreeListBlock *block = a->bins[fl][sl];
+    list_remove(a, block);
+    return block;
+}
+
+// Start with one big free block followed by the end sentinel
+void freelist_init(FreeListAllocator *a, void *memory, size_t size) {
+    a->memory = memory;
+    a->size = size;
+    a->used = 0;
+    a->capacity = 0;
+    a->fl_bitmap = 0;
+    for (size_t fl = 0; fl < FREELIST_FL_COUNT; fl++) {
+        a->sl_bitmap[fl] = 0;
+        for (size_t sl = 0; sl < FREELIST_SL_COUNT; sl++) {
+            a->bins[fl][sl] = NULL;
+        }
+    }
+
+    size_t usable = (size & ~((size_t)7));
+    if (memory == NULL || usable < FREELIST_MIN_BLOCK + FREELIST_HEADER_SIZE) {
+        return;
+    }
+    usable -= FREELIST_HEADER_SIZE;
+    a->capacity = usable;
+
+    FreeListBlock *block = (FreeListBlock *)memory;
+    block->size = usable | FREELIST_PREV_IN_USE;
+    write_footer(block);
+    list_push(a, block);
+
+    // Sentinel: zero-size block that is always in use
+    next_block(block)->size = FREELIST_IN_USE;
+}
+
+// Allocate size bytes
+// Returns pointer to allocated memory, or NULL if no free block fits
+void *freelist_alloc(FreeListAllocator *a, size_t size) {
+    if (a == NULL || size == 0 || size > SIZE_MAX - FREELIST_HEADER_SIZE - 7) {
+        return NULL;
+    }
+
+    size_t required = size + FREELIST_HEADER_SIZE;
+    required = (required + 7) & ~((size_t)7);  // Align
+    if (required < FREELIST_MIN_BLOCK) {
+        required = FREELIST_MIN_BLOCK;
+    }
+
+    FreeListBlock *block = find_block(a, required);
+    if (block == NULL) {
+        return NULL;
+    }
+
+    size_t available = block_size(block);
+    size_t prev_flag = block->size & FREELIST_PREV_IN_USE;
+
+    // Split if enough space for another block
+    if (available >= required + FREELIST_MIN_BLOCK) {
+        FreeListBlock *rest = (FreeListBlock *)((uint8_t *)block + required);
+        rest->size = (available - required) | FREELIST_PREV_IN_USE;
+        write_footer(rest);
+        list_push(a, rest);
+    } else {
+        required = available;  // Use full block
+        next_block(block)->size |= FREELIST_PREV_IN_USE;
+    }
+
+    block->size = required | FREELIST_IN_USE | prev_flag;
+    a->used += required;
+
+    return (uint8_t *)block + FREELIST_HEADER_SIZE;
+}
+
+// Free a block, merging with free neighbors found through the boundary tags
+void freelist_free(FreeListAllocator *a, void *ptr) {
+    if (a == NULL || ptr == NULL) {
+        return;
+    }
+
+    FreeListBlock *block = (FreeListBlock *)((uint8_t *)ptr - FREELIST_HEADER_SIZE);
+    if (!(block->size & FREELIST_IN_USE)) {
+        return;  // Double free
+    }
+
+    size_t size = block_size(block);
+    a->used -= size;
+
+    // Coalesce with next block if free
+    FreeListBlock *next = next_block(block);
+    if (!(next->size & FREELIST_IN_USE)) {
+        list_remove(a, next);
+        size += block_size(next);
+    }
+
+    // Coalesce with previous block if free (its footer sits right before us)
+    size_t prev_flag = block->size & FREELIST_PREV_IN_USE;
+    if (!prev_flag) {
+        size_t prev_size = *(size_t *)((uint8_t *)block - FREELIST_FOOTER_SIZE);
+        FreeListBlock *prev = (FreeListBlock *)((uint8_t *)block - prev_size);
+        list_remove(a, prev);
+        prev_flag = prev->size & FREELIST_PREV_IN_USE;
+        block->size &= ~FREELIST_IN_USE;  // Stale header is now inside prev; a second free must see it free
+        block = prev;
+        size += prev_size;
+    }
+
+    block->size = size | prev_flag;
+    write_footer(block);
+    next_block(block)->size &= ~FREELIST_PREV_IN_USE;
+    list_push(a, block);
+}
+
+// Bytes currently allocated
+size_t freelist_used(const FreeListAllocator *a) {
+    return a != NULL ? a->used : 0;
+}
+
+// Check whether ptr points into the allocator's region
+int freelist_owns(const FreeListAllocator *a, const void *ptr) {
+    if (a == NULL || a->memory == NULL || ptr == NULL) {
+        return 0;
+    }
+
+    uintptr_t start = (uintptr_t)a->memory;
+    uintptr_t addr = (uintptr_t)ptr;
+    return addr >= start && addr < start + a->size;
+}
+
+// Total bytes held by free blocks
+size_t freelist_free_bytes(const FreeListAllocator *a) {
+    return a != NULL ? a->capacity - a->used : 0;
+}
+
+// Size of the largest free block
+size_t freelist_largest_free(const FreeListAllocator *a) {
+    if (a == NULL || a->fl_bitmap == 0) {
+        return 0;
+    }
+
+    // The highest non-empty bin holds the largest blocks; only it needs a scan
+    size_t fl = floor_log2(a->fl_bitmap);
+    size_t sl = floor_log2(a->sl_bitmap[fl]);
+    size_t largest = 0;
+    for (const FreeListBlock *b = a->bins[fl][sl]; b != NULL; b = b->next) {
+        if (block_size(b) > largest) {
+            largest = block_size(b);
+        }
+    }
+    return largest;
+}
+
+// External fragmentation of the free space
+double freelist_fragmentation(const FreeListAllocator *a) {
+    size_t free_bytes = freelist_free_bytes(a);
+    if (free_bytes == 0) {
+        return 0.0;
+    }
+    return 1.0 - (double)freelist_largest_free(a) / (double)free_bytes;
+}
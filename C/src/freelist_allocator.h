@@ -0,0 +1,79 @@
+#ifndef FREELIST_ALLOCATOR_H
+#define FREELIST_ALLOCATOR_H
+
+#include <stddef.h>
+
+/*
+ * Variable-size allocator with individual free support, running on
+ * caller-provided memory. Same API as the tutorial FreeListAllocator in
+ * allocators.h, so existing call sites only need to switch the include.
+ *
+ * Every block starts with a size word whose low bits flag whether the block
+ * and its predecessor are in use; free blocks also end with a copy of their
+ * size (boundary tag). Neighbors are therefore found in O(1), and free
+ * blocks sit on doubly-linked lists so they can be unlinked in O(1).
+ *
+ * Free blocks are binned TLSF-style: a first-level index per power of two,
+ * split into FREELIST_SL_COUNT linear second-level ranges, with bitmaps
+ * marking non-empty bins. A good-fit lookup is a couple of bit scans, so
+ * alloc stays bounded-time no matter how many fragments the heap holds.
+ */
+
+typedef struct FreeListBlock {
+    size_t size;                 // Block size | FREELIST_IN_USE | FREELIST_PREV_IN_USE
+    struct FreeListBlock *next;  // Free blocks only
+    struct FreeListBlock *prev;  // Free blocks only
+} FreeListBlock;
+
+// Bin geometry: sizes below FREELIST_SMALL_SIZE share first-level bin 0
+#define FREELIST_SL_LOG2    4
+#define FREELIST_SL_COUNT   (1 << FREELIST_SL_LOG2)
+#define FREELIST_SMALL_LOG2 (FREELIST_SL_LOG2 + 3)
+#define FREELIST_SMALL_SIZE ((size_t)1 << FREELIST_SMALL_LOG2)
+#define FREELIST_FL_COUNT   (sizeof(size_t) * 8 - FREELIST_SMALL_LOG2 + 1)
+
+typedef struct {
+    unsigned char *memory;
+    size_t size;
+    size_t used;
+    size_t capacity;  // Bytes available to blocks (region minus sentinel)
+    size_t fl_bitmap;
+    unsigned sl_bitmap[FREELIST_FL_COUNT];
+    FreeListBlock *bins[FREELIST_FL_COUNT][FREELIST_SL_COUNT];
+} FreeListAllocator;
+
+#define FREELIST_HEADER_SIZE sizeof(size_t)
+#define FREELIST_FOOTER_SIZE sizeof(size_t)
+#define FREELIST_MIN_BLOCK   (sizeof(FreeListBlock) + FREELIST_FOOTER_SIZE)
+
+// Flag bits stored in the low bits of FreeListBlock.size
+#define FREELIST_IN_USE      ((size_t)1)
+#define FREELIST_PREV_IN_USE ((size_t)2)
+#define FREELIST_FLAGS       ((size_t)7)
+
+// Start with the whole region as one free block (memory must be 8-byte aligned)
+void freelist_init(FreeListAllocator *a, void *memory, size_t size);
+
+// Allocate size bytes (returns NULL if no free block is large enough)
+void *freelist_alloc(FreeListAllocator *a, size_t size);
+
+// Free a block returned by freelist_alloc in O(1)
+// NULL and double frees are ignored until the memory is handed out again
+void freelist_free(FreeListAllocator *a, void *ptr);
+
+// Bytes currently allocated, including headers
+size_t freelist_used(const FreeListAllocator *a);
+
+// Check whether ptr points into the allocator's region
+int freelist_owns(const FreeListAllocator *a, const void *ptr);
+
+// Total bytes held by free blocks
+size_t freelist_free_bytes(const FreeListAllocator *a);
+
+// Size of the largest free block
+size_t freelist_largest_free(const FreeListAllocator *a);
+
+// External fragmentation: 1 - largest free block / free bytes (0 = one free block)
+double freelist_fragmentation(const FreeListAllocator *a);
+
+#endif
@@ -0,0 +1,136 @@
+/*
+ * Compile-time-sized arena with inline storage
+ *
+ * InlineArena<Capacity, Alignment> bumps through a buffer embedded in the
+ * object itself, so a stack or static instance needs no allocation at all.
+ * Sizes and alignments known at compile time (alloc<Size, Align>(), create<T>())
+ * have their rounding folded and capacity checked by static_assert. When the
+ * inline buffer is full the arena falls back to a growable heap-backed
+ * SimpleMemoryAllocator created on first overflow.
+ *
+ * Like SimpleMemoryAllocator, individual frees are not supported; reset()
+ * rewinds both the inline buffer and the overflow arena, which keeps its
+ * memory until the InlineArena itself is destroyed. Not thread-safe.
+ */
+
+#ifndef INLINE_ARENA_HPP
+#define INLINE_ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include "simple_memory_allocator.h"
+
+namespace simple_memory {
+
+template <std::size_t Capacity, std::size_t Alignment = alignof(std::max_align_t)>
+class InlineArena {
+    static_assert(Capacity > 0 && Capacity % 8 == 0, "capacity must be a positive multiple of 8");
+    static_assert(Alignment >= 8 && (Alignment & (Alignment - 1)) == 0, "alignment must be a power of two >= 8");
+
+public:
+    // First overflow block size (it grows geometrically after that)
+    static constexpr std::size_t default_overflow_block = Capacity * 4;
+
+    explicit InlineArena(std::size_t overflow_block = default_overflow_block) noexcept
+        : used_(0), overflow_block_(overflow_block != 0 ? overflow_block : default_overflow_block) {
+        simple_memory_allocator_init(&overflow_);
+    }
+
+    ~InlineArena() { simple_memory_allocator_destroy(&overflow_); }
+
+    InlineArena(const InlineArena &) = delete;
+    InlineArena &operator=(const InlineArena &) = delete;
+
+    static constexpr std::size_t capacity() noexcept { return Capacity; }
+
+    // Bytes used in the inline buffer
+    std::size_t used() const noexcept { return used_; }
+
+    // True once any allocation spilled to the heap
+    bool overflowed() const noexcept { return overflow_.memory != nullptr; }
+
+    // Runtime-sized allocation (8-byte granules, Alignment-aligned start)
+    void *alloc(std::size_t size) noexcept { return alloc_aligned(size, Alignment); }
+
+    // Runtime size and alignment (alignment must be a power of two)
+    void *alloc_aligned(std::size_t size, std::size_t alignment) noexcept {
+        if (size == 0 || (alignment & (alignment - 1)) != 0) {
+            return nullptr;
+        }
+        if (alignment < 8) {
+            alignment = 8;
+        }
+        std::size_t aligned_size = (size + 7) & ~static_cast<std::size_t>(7);
+        if (aligned_size >= size) {
+            std::uintptr_t base = reinterpret_cast<std::uintptr_t>(storage_);
+            std::size_t offset = static_cast<std::size_t>(((base + used_ + alignment - 1) & ~(alignment - 1)) - base);
+            if (offset <= Capacity && aligned_size <= Capacity - offset) {
+                used_ = offset + aligned_size;
+                return storage_ + offset;
+            }
+        }
+        return overflow_alloc(size, alignment);
+    }
+
+    // Compile-time size and alignment: rounding is constant and the request
+    // is rejected at compile time if it could never fit inline
+    template <std::size_t Size, std::size_t Align = 8>
+    void *alloc() noexcept {
+        static_assert(Size > 0, "zero-sized allocation");
+        static_assert((Align & (Align - 1)) == 0, "alignment must be a power of two");
+        constexpr std::size_t align = Align < 8 ? 8 : Align;
+        constexpr std::size_t aligned_size = (Size + 7) & ~static_cast<std::size_t>(7);
+        static_assert(aligned_size <= Capacity, "allocation larger than the inline buffer");
+
+        if constexpr (align <= Alignment) {
+            // The buffer itself is Alignment-aligned, so offsets align directly
+            std::size_t offset = (used_ + align - 1) & ~(align - 1);
+            if (offset <= Capacity - aligned_size) {
+                used_ = offset + aligned_size;
+                return storage_ + offset;
+            }
+            return overflow_alloc(Size, align);
+        } else {
+            return alloc_aligned(Size, align);
+        }
+    }
+
+    // Construct a T in the arena (its destructor is never run by the arena)
+    template <typename T, typename... Args>
+    T *create(Args &&...args) {
+        void *ptr = alloc<sizeof(T), alignof(T)>();
+        return ptr != nullptr ? new (ptr) T(std::forward<Args>(args)...) : nullptr;
+    }
+
+    // Rewind the inline buffer and the overflow arena (which keeps its largest block)
+    void reset() noexcept {
+        used_ = 0;
+        if (overflowed()) {
+            simple_memory_allocator_reset(&overflow_);
+        }
+    }
+
+private:
+    void *overflow_alloc(std::size_t size, std::size_t alignment) noexcept {
+        if (!overflowed()) {
+            SimpleMemoryAllocatorOptions options = {};
+            options.growable = 1;
+            std::size_t block = overflow_block_ > size + alignment ? overflow_block_ : size + alignment;
+            if (simple_memory_allocator_create_with_options(&overflow_, block, &options) != 0) {
+                return nullptr;
+            }
+        }
+        return simple_memory_allocator_alloc_aligned(&overflow_, size, alignment);
+    }
+
+    alignas(Alignment) unsigned char storage_[Capacity];
+    std::size_t used_;
+    std::size_t overflow_block_;
+    SimpleMemoryAllocator overflow_;
+};
+
+}  // namespace simple_memory
+
+#endif
@@ -0,0 +1,114 @@
+/*
+ * Debug guard helpers shared by the arena and pool allocators
+ *
+ * Compiled in with -DSIMPLE_MEMORY_ALLOCATOR_GUARD. Under AddressSanitizer
+ * dead memory is poisoned through the manual-poisoning interface, so the
+ * faulting access itself is reported. Without ASan the same regions are
+ * filled with a byte pattern instead, and memory_guard_check() verifies the
+ * pattern when the allocator next looks at the region.
+ *
+ * Internal header: not part of the public API.
+ */
+
+#ifndef MEMORY_GUARD_H
+#define MEMORY_GUARD_H
+
+#include <stddef.h>
+
+#if defined(__SANITIZE_ADDRESS__)
+#define MEMORY_GUARD_ASAN 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define MEMORY_GUARD_ASAN 1
+#endif
+#endif
+
+#ifdef SIMPLE_MEMORY_ALLOCATOR_GUARD
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef MEMORY_GUARD_ASAN
+#include <sanitizer/asan_interface.h>
+#endif
+
+#define MEMORY_GUARD_RED_ZONE_BYTE 0xFD  // Gap after each arena allocation
+#define MEMORY_GUARD_FREED_BYTE    0xDD  // Reset arena memory and freed pool blocks
+
+// Mark [addr, addr + size) dead
+static inline void memory_guard_poison(void *addr, size_t size, int pattern) {
+    if (size == 0) {
+        return;
+    }
+#ifdef MEMORY_GUARD_ASAN
+    (void)pattern;
+    ASAN_POISON_MEMORY_REGION(addr, size);
+#else
+    memset(addr, pattern, size);
+#endif
+}
+
+// Mark never-used memory dead (it holds nothing stale, so only ASan needs telling)
+static inline void memory_guard_poison_fresh(void *addr, size_t size) {
+#ifdef MEMORY_GUARD_ASAN
+    ASAN_POISON_MEMORY_REGION(addr, size);
+#else
+    (void)addr;
+    (void)size;
+#endif
+}
+
+// Mark [addr, addr + size) live again
+static inline void memory_guard_unpoison(void *addr, size_t size) {
+#ifdef MEMORY_GUARD_ASAN
+    ASAN_UNPOISON_MEMORY_REGION(addr, size);
+#else
+    (void)addr;
+    (void)size;
+#endif
+}
+
+// Copy the addressable bytes of [src, src + size) and zero the poisoned ones
+static inline void memory_guard_copy_live(void *dst, const void *src, size_t size) {
+#ifdef MEMORY_GUARD_ASAN
+    unsigned char *out = dst;
+    const unsigned char *in = src;
+    const unsigned char *end = in + size;
+    while (in < end) {
+        const unsigned char *poisoned = __asan_region_is_poisoned((void *)in, (size_t)(end - in));
+        const unsigned char *stop = poisoned != NULL ? poisoned : end;
+        memcpy(out, in, (size_t)(stop - in));
+        out += stop - in;
+        for (in = stop; in < end && __asan_address_is_poisoned(in); in++) {
+            *out++ = 0;
+        }
+    }
+#else
+    memcpy(dst, src, size);
+#endif
+}
+
+// Abort if a region filled by memory_guard_poison was written since
+// (ASan builds report the write itself, so there is nothing to check)
+static inline void memory_guard_check(const void *addr, size_t size, int pattern, const char *what) {
+#ifdef MEMORY_GUARD_ASAN
+    (void)addr;
+    (void)size;
+    (void)pattern;
+    (void)what;
+#else
+    const unsigned char *bytes = addr;
+    for (size_t i = 0; i < size; i++) {
+        if (bytes[i] != (unsigned char)pattern) {
+            fprintf(stderr, "memory guard: %s at %p (byte %zu of %zu is 0x%02x)\n", what, (const void *)(bytes + i),
+                    i, size, bytes[i]);
+            abort();
+        }
+    }
+#endif
+}
+
+#endif  // SIMPLE_MEMORY_ALLOCATOR_GUARD
+
+#endif
@@ -0,0 +1,143 @@
+/*
+ * C++ adapters for the arena and pool allocators
+ *
+ * ArenaResource exposes a SimpleMemoryAllocator as a std::pmr::memory_resource:
+ * allocations honor the requested alignment and deallocate() is a no-op, so
+ * memory comes back on simple_memory_allocator_reset()/destroy(). PoolResource
+ * serves requests that fit a PoolAllocator block from the pool and forwards the
+ * rest to an upstream resource. ArenaAllocator<T> is the same arena behind the
+ * classic Allocator interface for containers that are not pmr-aware.
+ *
+ * The adapters borrow the C allocators; they must outlive every container
+ * using them. None of them are thread-safe.
+ */
+
+#ifndef MEMORY_RESOURCE_HPP
+#define MEMORY_RESOURCE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include "simple_memory_allocator.h"
+#include "pool_allocator.h"
+
+namespace simple_memory {
+
+// std::pmr view of a bump arena (deallocate is a no-op)
+class ArenaResource : public std::pmr::memory_resource {
+public:
+    explicit ArenaResource(SimpleMemoryAllocator *arena) noexcept : arena_(arena) {}
+
+    SimpleMemoryAllocator *arena() const noexcept { return arena_; }
+
+private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+        // The arena rejects zero-byte requests; pmr requires a unique pointer
+        void *ptr = simple_memory_allocator_alloc_aligned(arena_, bytes != 0 ? bytes : 1, alignment);
+        if (ptr == nullptr) {
+            throw std::bad_alloc();
+        }
+        return ptr;
+    }
+
+    void do_deallocate(void *, std::size_t, std::size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        const ArenaResource *arena = dynamic_cast<const ArenaResource *>(&other);
+        return arena != nullptr && arena->arena_ == arena_;
+    }
+
+    SimpleMemoryAllocator *arena_;
+};
+
+// Fixed-size resource: requests that fit a block come from the pool,
+// everything else (and pool exhaustion) goes to the upstream resource
+class PoolResource : public std::pmr::memory_resource {
+public:
+    explicit PoolResource(PoolAllocator *pool,
+                          std::pmr::memory_resource *upstream = std::pmr::get_default_resource()) noexcept
+        : pool_(pool), upstream_(upstream) {}
+
+    PoolAllocator *pool() const noexcept { return pool_; }
+    std::pmr::memory_resource *upstream() const noexcept { return upstream_; }
+
+private:
+    // Every block sits at base + k * block_size, so the alignment all of them
+    // share is the lowest set bit of both (caller memory from create_from()
+    // may be aligned to less than 16)
+    std::size_t block_alignment() const noexcept {
+        std::uintptr_t bits = reinterpret_cast<std::uintptr_t>(pool_->memory) | pool_->block_size;
+        return static_cast<std::size_t>(bits & (~bits + 1));
+    }
+
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+        if (bytes <= pool_->block_size && alignment <= block_alignment()) {
+            void *ptr = pool_allocator_alloc(pool_);
+            if (ptr != nullptr) {
+                return ptr;
+            }
+        }
+        return upstream_->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *ptr, std::size_t bytes, std::size_t alignment) override {
+        if (pool_allocator_owns(pool_, ptr)) {
+            pool_allocator_free(pool_, ptr);
+        } else {
+            upstream_->deallocate(ptr, bytes, alignment);
+        }
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        const PoolResource *pool = dynamic_cast<const PoolResource *>(&other);
+        return pool != nullptr && pool->pool_ == pool_;
+    }
+
+    PoolAllocator *pool_;
+    std::pmr::memory_resource *upstream_;
+};
+
+// Standard Allocator over a bump arena for non-pmr containers
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(SimpleMemoryAllocator *arena) noexcept : arena_(arena) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U> &other) noexcept : arena_(other.arena()) {}
+
+    T *allocate(std::size_t n) {
+        if (n > static_cast<std::size_t>(-1) / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        void *ptr = simple_memory_allocator_alloc_aligned(arena_, n != 0 ? n * sizeof(T) : 1, alignof(T));
+        if (ptr == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T *>(ptr);
+    }
+
+    void deallocate(T *, std::size_t) noexcept {}
+
+    SimpleMemoryAllocator *arena() const noexcept { return arena_; }
+
+private:
+    SimpleMemoryAllocator *arena_;
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T> &a, const ArenaAllocator<U> &b) noexcept {
+    return a.arena() == b.arena();
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T> &a, const ArenaAllocator<U> &b) noexcept {
+    return !(a == b);
+}
+
+}  // namespace simple_memory
+
+#endif
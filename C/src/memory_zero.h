@@ -0,0 +1,53 @@
+/*
+ * Bulk zeroing shared by the calloc entry points
+ *
+ * Small regions go to memset. Regions past MEMORY_ZERO_STREAM_THRESHOLD are
+ * cleared with non-temporal SSE2 stores instead: they are larger than the
+ * caches would keep anyway, and streaming them avoids evicting the working
+ * set and reading every line in before overwriting it.
+ *
+ * Internal header: not part of the public API.
+ */
+
+#ifndef MEMORY_ZERO_H
+#define MEMORY_ZERO_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Regions at least this large bypass the cache
+#ifndef MEMORY_ZERO_STREAM_THRESHOLD
+#define MEMORY_ZERO_STREAM_THRESHOLD ((size_t)1024 * 1024)
+#endif
+
+// Zero [addr, addr + size)
+static inline void memory_zero(void *addr, size_t size) {
+#if defined(__SSE2__)
+    if (size >= MEMORY_ZERO_STREAM_THRESHOLD) {
+        unsigned char *bytes = addr;
+        size_t head = (size_t)(-(uintptr_t)bytes & 15);  // Streaming stores need 16-byte alignment
+        memset(bytes, 0, head);
+        bytes += head;
+        size -= head;
+
+        __m128i zero = _mm_setzero_si128();
+        size_t body = size & ~(size_t)63;
+        for (size_t i = 0; i < body; i += 64) {
+            _mm_stream_si128((__m128i *)(bytes + i), zero);
+            _mm_stream_si128((__m128i *)(bytes + i + 16), zero);
+            _mm_stream_si128((__m128i *)(bytes + i + 32), zero);
+            _mm_stream_si128((__m128i *)(bytes + i + 48), zero);
+        }
+        _mm_sfence();  // Order the weakly-ordered stores before the memory is handed out
+        memset(bytes + body, 0, size - body);
+        return;
+    }
+#endif
+    memset(addr, 0, size);
+}
+
+#endif
@@ -0,0 +1,233 @@
+/*
+ * NUMA arena group
+ *
+ * Node-local front for the concurrent bump allocator. Each online node gets
+ * its own mbind'ed mmap pool, so pages are placed on the node before first
+ * touch rather than wherever the first writer happens to run. Routing asks
+ * getcpu() for the current node; glibc serves that from the vDSO, and the
+ * thread caches only ask once per refill.
+ */
+
+#define _GNU_SOURCE  // Required for getcpu and syscall
+
+#include "numa_arena_group.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+#define NUMA_SYSFS_NODES "/sys/devices/system/node"
+
+// Parse a sysfs list such as "0-3,8,10-11" into flags[0..limit)
+// Returns the number of ids set, or -1 if the file cannot be read
+static int read_id_list(const char *path, int *flags, int limit) {
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        return -1;
+    }
+
+    int count = 0;
+    int first, last;
+    char sep;
+    while (fscanf(f, "%d", &first) == 1) {
+        last = first;
+        sep = '\n';
+        if (fscanf(f, "%c", &sep) == 1 && sep == '-') {
+            if (fscanf(f, "%d", &last) != 1) {
+                break;
+            }
+            sep = '\n';
+            if (fscanf(f, "%c", &sep) != 1) {
+                sep = '\n';
+            }
+        }
+        for (int id = first; id <= last && id < limit; id++) {
+            if (id >= 0 && !flags[id]) {
+                flags[id] = 1;
+                count++;
+            }
+        }
+        if (sep != ',') {
+            break;
+        }
+    }
+    fclose(f);
+    return count;
+}
+
+// Initialize the group to zero state
+void numa_arena_group_init(NumaArenaGroup *group) {
+    for (int node = 0; node < NUMA_ARENA_GROUP_MAX_NODES; node++) {
+        concurrent_memory_allocator_init(&group->nodes[node]);
+        group->online[node] = 0;
+    }
+    group->node_count = 0;
+    group->first_node = 0;
+}
+
+// Create one arena per online node
+// Returns 0 on success, -1 on failure
+int numa_arena_group_create(NumaArenaGroup *group, size_t pool_size, const SimpleMemoryAllocatorOptions *options) {
+    if (group == NULL || pool_size == 0) {
+        return -1;
+    }
+
+    numa_arena_group_init(group);
+    if (read_id_list(NUMA_SYSFS_NODES "/online", group->online, NUMA_ARENA_GROUP_MAX_NODES) <= 0) {
+        group->online[0] = 1;  // No sysfs NUMA information: one node
+    }
+
+    SimpleMemoryAllocatorOptions opts = {0};
+    if (options != NULL) {
+        opts = *options;
+    }
+    opts.backing = SIMPLE_MEMORY_BACKING_MMAP;
+
+    int first = -1;
+    int count = 0;
+    for (int node = 0; node < NUMA_ARENA_GROUP_MAX_NODES; node++) {
+        if (!group->online[node]) {
+            continue;
+        }
+        count++;
+        first = first < 0 ? node : first;
+    }
+
+    for (int node = 0; node < NUMA_ARENA_GROUP_MAX_NODES; node++) {
+        if (!group->online[node]) {
+            continue;
+        }
+        opts.map_flags |= SIMPLE_MEMORY_MAP_NUMA_BIND;
+        opts.numa_node = node;
+        int rc = concurrent_memory_allocator_create_with_options(&group->nodes[node], pool_size, &opts);
+
+        // Binding is meaningless on one node, so a kernel without mbind is fine there
+        if (rc != 0 && count == 1) {
+            opts.map_flags &= ~SIMPLE_MEMORY_MAP_NUMA_BIND;
+            rc = concurrent_memory_allocator_create_with_options(&group->nodes[node], pool_size, &opts);
+        }
+        if (rc != 0) {
+            numa_arena_group_destroy(group);
+            return -1;
+        }
+    }
+
+    group->node_count = count;
+    group->first_node = first;
+    return 0;
+}
+
+// Node of the calling thread
+int numa_arena_group_current_node(void) {
+    unsigned cpu = 0;
+    unsigned node = 0;
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 29))
+    if (getcpu(&cpu, &node) != 0) {
+        return 0;
+    }
+#elif defined(SYS_getcpu)
+    if (syscall(SYS_getcpu, &cpu, &node, NULL) != 0) {
+        return 0;
+    }
+#endif
+    (void)cpu;
+    return (int)node;
+}
+
+// Arena serving a node id
+ConcurrentMemoryAllocator *numa_arena_group_node(NumaArenaGroup *group, int node) {
+    if (group == NULL || group->node_count == 0) {
+        return NULL;
+    }
+    if (node < 0 || node >= NUMA_ARENA_GROUP_MAX_NODES || !group->online[node]) {
+        node = group->first_node;
+    }
+    return &group->nodes[node];
+}
+
+// Allocate from the local node
+void *numa_arena_group_alloc(NumaArenaGroup *group, size_t size) {
+    return concurrent_memory_allocator_alloc(numa_arena_group_node(group, numa_arena_group_current_node()), size);
+}
+
+// Allocate from a chosen node
+void *numa_arena_group_alloc_on(NumaArenaGroup *group, int node, size_t size) {
+    return concurrent_memory_allocator_alloc(numa_arena_group_node(group, node), size);
+}
+
+// Lowest CPU listed for a node
+int numa_arena_group_node_cpu(int node) {
+    enum { MAX_CPUS = 4096 };
+    char path[64];
+    int *cpus = calloc(MAX_CPUS, sizeof(*cpus));
+    if (cpus == NULL) {
+        return -1;
+    }
+
+    snprintf(path, sizeof(path), NUMA_SYSFS_NODES "/node%d/cpulist", node);
+    int cpu = -1;
+    if (read_id_list(path, cpus, MAX_CPUS) > 0) {
+        for (int i = 0; i < MAX_CPUS && cpu < 0; i++) {
+            cpu = cpus[i] ? i : -1;
+        }
+    }
+    free(cpus);
+    return cpu;
+}
+
+// Reset every arena
+void numa_arena_group_reset(NumaArenaGroup *group) {
+    if (group == NULL) {
+        return;
+    }
+    for (int node = 0; node < NUMA_ARENA_GROUP_MAX_NODES; node++) {
+        if (group->online[node]) {
+            concurrent_memory_allocator_reset(&group->nodes[node]);
+        }
+    }
+}
+
+// Destroy every arena
+void numa_arena_group_destroy(NumaArenaGroup *group) {
+    if (group == NULL) {
+        return;
+    }
+    for (int node = 0; node < NUMA_ARENA_GROUP_MAX_NODES; node++) {
+        concurrent_memory_allocator_destroy(&group->nodes[node]);
+        group->online[node] = 0;
+    }
+    group->node_count = 0;
+}
+
+// Attach a cache to the group
+void numa_thread_cache_init(NumaThreadCache *cache, NumaArenaGroup *group, size_t chunk_size) {
+    thread_cache_allocator_init(&cache->cache, numa_arena_group_node(group, -1), chunk_size);
+    cache->group = group;
+    cache->node = -1;
+}
+
+// Refill from the node the thread runs on now
+// Returns pointer to allocated memory, or NULL if that node's arena is exhausted
+void *numa_thread_cache_alloc_slow(NumaThreadCache *cache, size_t size) {
+    if (cache == NULL || cache->group == NULL) {
+        return NULL;
+    }
+
+    // A migrated thread abandons its remote chunk rather than keep using it
+    int node = numa_arena_group_current_node();
+    if (node != cache->node) {
+        cache->cache.shared = numa_arena_group_node(cache->group, node);
+        thread_cache_allocator_reset(&cache->cache);
+        cache->node = node;
+    }
+    return thread_cache_allocator_alloc_slow(&cache->cache, size);
+}
+
+// Drop the current chunk
+void numa_thread_cache_reset(NumaThreadCache *cache) {
+    if (cache != NULL) {
+        thread_cache_allocator_reset(&cache->cache);
+        cache->node = -1;
+    }
+}
@@ -0,0 +1,87 @@
+#ifndef NUMA_ARENA_GROUP_H
+#define NUMA_ARENA_GROUP_H
+
+#include <stddef.h>
+#include "concurrent_memory_allocator.h"
+#include "thread_cache_allocator.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Highest supported node id + 1 (matches the mbind mask used for binding)
+#define NUMA_ARENA_GROUP_MAX_NODES 64
+
+/*
+ * One ConcurrentMemoryAllocator per NUMA node, each backed by an mmap pool
+ * bound to its node. alloc() routes to the calling thread's current node
+ * (getcpu), so arena data lands in local memory wherever the thread runs.
+ * Offline node ids have no arena and route to the first online node.
+ *
+ * Same quiescence rules as ConcurrentMemoryAllocator for create, reset
+ * and destroy.
+ */
+typedef struct {
+    ConcurrentMemoryAllocator nodes[NUMA_ARENA_GROUP_MAX_NODES];
+    int online[NUMA_ARENA_GROUP_MAX_NODES];  // Node has an arena
+    int node_count;                          // Online nodes
+    int first_node;                          // Fallback for offline ids
+} NumaArenaGroup;
+
+// Per-thread cache that refills from the thread's local node
+typedef struct {
+    ThreadCacheAllocator cache;
+    NumaArenaGroup *group;
+    int node;  // Node the current chunk came from (-1 = none yet)
+} NumaThreadCache;
+
+// Initialize group struct to zero state
+void numa_arena_group_init(NumaArenaGroup *group);
+
+// Create one pool_size arena per online node. options may set alignment
+// and map flags; backing is forced to mmap and node binding is added.
+// Without NUMA support in the kernel a single-node machine still works,
+// unbound. Returns 0 on success, -1 on failure
+int numa_arena_group_create(NumaArenaGroup *group, size_t pool_size, const SimpleMemoryAllocatorOptions *options);
+
+// Node the calling thread is running on (0 if unknown)
+int numa_arena_group_current_node(void);
+
+// Arena for a node id (offline ids map to the first online node)
+ConcurrentMemoryAllocator *numa_arena_group_node(NumaArenaGroup *group, int node);
+
+// Allocate from the calling thread's local node (thread-safe)
+void *numa_arena_group_alloc(NumaArenaGroup *group, size_t size);
+
+// Allocate from an explicit node (thread-safe)
+void *numa_arena_group_alloc_on(NumaArenaGroup *group, int node, size_t size);
+
+// Lowest CPU id of a node, -1 if unknown (for pinning in benchmarks)
+int numa_arena_group_node_cpu(int node);
+
+// Reset every node's arena (requires quiescence; reset all caches too)
+void numa_arena_group_reset(NumaArenaGroup *group);
+
+// Destroy every node's arena (requires quiescence)
+void numa_arena_group_destroy(NumaArenaGroup *group);
+
+// Attach a cache to the group (chunk_size 0 = default); the first refill picks the node
+void numa_thread_cache_init(NumaThreadCache *cache, NumaArenaGroup *group, size_t chunk_size);
+
+// Refill path: switches to the thread's current node before refilling
+void *numa_thread_cache_alloc_slow(NumaThreadCache *cache, size_t size);
+
+// Allocate from the thread's chunk, refilling from the local node
+static inline void *numa_thread_cache_alloc(NumaThreadCache *cache, size_t size) {
+    void *ptr = thread_cache_allocator_bump(&cache->cache, size);
+    return ptr != NULL ? ptr : numa_thread_cache_alloc_slow(cache, size);
+}
+
+// Drop the current chunk (required after the group is reset)
+void numa_thread_cache_reset(NumaThreadCache *cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,117 @@
+/*
+ * Owned pool allocator
+ *
+ * Message-passing front end for the pool allocator, after the delayed-free
+ * lists of thread-owned heaps: cross-thread frees are queued to the owner
+ * instead of being applied to its free list directly. The owner's alloc
+ * and free stay the serial pool's code, and the queue is only touched
+ * when the free list is empty.
+ */
+
+#include "owned_pool_allocator.h"
+#include "memory_guard.h"
+
+// Initialize the pool to zero state
+void owned_pool_allocator_init(OwnedPoolAllocator *pool) {
+    pool_allocator_init(&pool->pool);
+    atomic_init(&pool->remote_frees, NULL);
+    pool->owner = pthread_self();
+}
+
+// Create pool owned by the calling thread
+// Returns 0 on success, -1 on failure
+int owned_pool_allocator_create(OwnedPoolAllocator *pool, size_t block_size, size_t block_count) {
+    if (pool == NULL) {
+        return -1;
+    }
+    owned_pool_allocator_init(pool);
+    return pool_allocator_create(&pool->pool, block_size, block_count);
+}
+
+// Transfer ownership
+void owned_pool_allocator_set_owner(OwnedPoolAllocator *pool, pthread_t owner) {
+    if (pool != NULL) {
+        pool->owner = owner;
+    }
+}
+
+// Reclaim queued remote frees, then allocate
+// Returns pointer to the block, or NULL if the pool is exhausted
+void *owned_pool_allocator_alloc_slow(OwnedPoolAllocator *pool) {
+    if (pool == NULL || owned_pool_allocator_drain(pool) == 0) {
+        return NULL;
+    }
+    return pool_allocator_alloc(&pool->pool);
+}
+
+// Push onto the remote queue
+void owned_pool_allocator_free_remote(OwnedPoolAllocator *pool, void *ptr) {
+    if (pool == NULL || ptr == NULL) {
+        return;
+    }
+
+    PoolFreeBlock *block = ptr;
+#ifdef SIMPLE_MEMORY_ALLOCATOR_GUARD
+    // Poisoned here because the owner splices the queue in without visiting each block
+    memory_guard_poison(block + 1, pool->pool.block_size - sizeof(PoolFreeBlock), MEMORY_GUARD_FREED_BYTE);
+#endif
+    PoolFreeBlock *head = atomic_load_explicit(&pool->remote_frees, memory_order_relaxed);
+    do {
+        block->next = head;
+    } while (!atomic_compare_exchange_weak_explicit(&pool->remote_frees, &head, block, memory_order_release,
+                                                    memory_order_relaxed));
+}
+
+// Free from whichever thread is calling
+void owned_pool_allocator_free_any(OwnedPoolAllocator *pool, void *ptr) {
+    if (pool == NULL || ptr == NULL) {
+        return;
+    }
+    if (pthread_equal(pthread_self(), pool->owner)) {
+        owned_pool_allocator_free(pool, ptr);
+    } else {
+        owned_pool_allocator_free_remote(pool, ptr);
+    }
+}
+
+// Splice the whole remote queue onto the free list
+// Returns the number of blocks reclaimed
+size_t owned_pool_allocator_drain(OwnedPoolAllocator *pool) {
+    if (pool == NULL) {
+        return 0;
+    }
+
+    // Plain load first so an idle queue costs no locked instruction
+    if (atomic_load_explicit(&pool->remote_frees, memory_order_relaxed) == NULL) {
+        return 0;
+    }
+    PoolFreeBlock *head = atomic_exchange_explicit(&pool->remote_frees, NULL, memory_order_acquire);
+    if (head == NULL) {
+        return 0;
+    }
+
+    size_t count = 1;
+    PoolFreeBlock *tail = head;
+    while (tail->next != NULL) {
+        tail = tail->next;
+        count++;
+    }
+    tail->next = pool->pool.free_list;
+    pool->pool.free_list = head;
+    pool->pool.used_count -= count;
+
+    return count;
+}
+
+// Blocks still counted as in use
+size_t owned_pool_allocator_used(const OwnedPoolAllocator *pool) {
+    return pool != NULL ? pool_allocator_used(&pool->pool) : 0;
+}
+
+// Destroy the pool
+void owned_pool_allocator_destroy(OwnedPoolAllocator *pool) {
+    if (pool != NULL) {
+        pool_allocator_destroy(&pool->pool);
+        atomic_store(&pool->remote_frees, NULL);
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef OWNED_POOL_ALLOCATOR_H
+#define OWNED_POOL_ALLOCATOR_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include "pool_allocator.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Thread-owned pool with a remote-free queue. The owning thread allocates
+ * and frees through the plain PoolAllocator with no atomics at all; other
+ * threads push the blocks they free onto an MPSC list. The owner takes the
+ * whole list with one atomic exchange the next time its free list runs dry,
+ * before carving never-used blocks, and splices it in as a batch, so warm
+ * blocks are reused first and the free-list head never bounces between
+ * cores. Only the owner pops, so the queue has no ABA problem.
+ *
+ * create, destroy and set_owner are NOT thread-safe.
+ */
+typedef struct {
+    PoolAllocator pool;                     // Owner-only state
+    _Atomic(PoolFreeBlock *) remote_frees;  // Pushed by other threads, drained by the owner
+    pthread_t owner;
+} OwnedPoolAllocator;
+
+// Initialize pool struct to zero state
+void owned_pool_allocator_init(OwnedPoolAllocator *pool);
+
+// Create pool for block_count blocks of block_size bytes, owned by the calling thread
+int owned_pool_allocator_create(OwnedPoolAllocator *pool, size_t block_size, size_t block_count);
+
+// Hand the pool to another thread (the previous owner must have stopped using it)
+void owned_pool_allocator_set_owner(OwnedPoolAllocator *pool, pthread_t owner);
+
+// Move all queued remote frees onto the free list (owner only)
+// Returns the number of blocks reclaimed
+size_t owned_pool_allocator_drain(OwnedPoolAllocator *pool);
+
+// Miss path: drains remote frees and retries (owner only)
+void *owned_pool_allocator_alloc_slow(OwnedPoolAllocator *pool);
+
+// Allocate one block (owner only, returns NULL if the pool is exhausted)
+static inline void *owned_pool_allocator_alloc(OwnedPoolAllocator *pool) {
+    // Queued remote frees come before fresh capacity; the relaxed load keeps an idle queue free of atomics
+    if (pool != NULL && pool->pool.free_list == NULL &&
+        atomic_load_explicit(&pool->remote_frees, memory_order_relaxed) != NULL) {
+        owned_pool_allocator_drain(pool);
+    }
+    void *ptr = pool_allocator_alloc(&pool->pool);
+    return ptr != NULL ? ptr : owned_pool_allocator_alloc_slow(pool);
+}
+
+// Free a block from the owning thread
+static inline void owned_pool_allocator_free(OwnedPoolAllocator *pool, void *ptr) {
+    pool_allocator_free(&pool->pool, ptr);
+}
+
+// Free a block from any other thread (lock-free push onto the remote queue)
+void owned_pool_allocator_free_remote(OwnedPoolAllocator *pool, void *ptr);
+
+// Free from any thread, picking the local or remote path by pthread_self()
+void owned_pool_allocator_free_any(OwnedPoolAllocator *pool, void *ptr);
+
+// Blocks handed out and not yet reclaimed by the owner (owner only)
+size_t owned_pool_allocator_used(const OwnedPoolAllocator *pool);
+
+// Destroy pool and free its memory
+void owned_pool_allocator_destroy(OwnedPoolAllocator *pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,262 @@
+/*
+ * Pool allocator
+ *
+ * Fixed-size block allocator with O(1) alloc and free. Unlike the tutorial
+ * version, the free list is threaded lazily: never-used blocks are handed
+ * out from a high-water index and only recycled blocks go through the free
+ * list. Creating a pool therefore costs O(1) and touches no block memory,
+ * so startup time and RSS follow actual use instead of capacity.
+ *
+ * Owned memory comes from calloc(), which hands large pools straight from
+ * fresh zero pages. Blocks above dirty_count have never held data, so
+ * pool_allocator_calloc() only clears recycled blocks and those below it.
+ *
+ * With -DSIMPLE_MEMORY_ALLOCATOR_GUARD freed blocks are poisoned past their
+ * link word (filled with a pattern that is verified on reuse when ASan is
+ * not available), and so is every block after a reset.
+ */
+
+#include "pool_allocator.h"
+#include "memory_guard.h"
+#include "memory_zero.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef SIMPLE_MEMORY_ALLOCATOR_GUARD
+// Poison a freed block, leaving its free-list link addressable
+static void guard_free_block(const PoolAllocator *pool, void *block) {
+    memory_guard_poison((unsigned char *)block + sizeof(PoolFreeBlock), pool->block_size - sizeof(PoolFreeBlock),
+                        MEMORY_GUARD_FREED_BYTE);
+}
+
+// Check a recycled block was not written while free, then open it
+static void guard_reuse_block(const PoolAllocator *pool, void *block) {
+    memory_guard_check((unsigned char *)block + sizeof(PoolFreeBlock), pool->block_size - sizeof(PoolFreeBlock),
+                       MEMORY_GUARD_FREED_BYTE, "pool block written after free");
+    memory_guard_unpoison(block, pool->block_size);
+}
+
+#define GUARD_FREE_BLOCK(pool, block)  guard_free_block((pool), (block))
+#define GUARD_REUSE_BLOCK(pool, block) guard_reuse_block((pool), (block))
+#define GUARD_FRESH_BLOCK(pool, block) memory_guard_unpoison((block), (pool)->block_size)
+#define GUARD_DEAD(addr, size)         memory_guard_poison((addr), (size), MEMORY_GUARD_FREED_BYTE)
+#define GUARD_UNTOUCHED(addr, size)    memory_guard_poison_fresh((addr), (size))
+#define GUARD_LIVE(addr, size)         memory_guard_unpoison((addr), (size))
+#else
+#define GUARD_FREE_BLOCK(pool, block)  ((void)0)
+#define GUARD_REUSE_BLOCK(pool, block) ((void)0)
+#define GUARD_FRESH_BLOCK(pool, block) ((void)0)
+#define GUARD_DEAD(addr, size)         ((void)0)
+#define GUARD_UNTOUCHED(addr, size)    ((void)0)
+#define GUARD_LIVE(addr, size)         ((void)0)
+#endif
+
+// Blocks must hold a free-list link and keep 8-byte alignment
+static size_t round_block_size(size_t block_size) {
+    if (block_size < sizeof(PoolFreeBlock)) {
+        block_size = sizeof(PoolFreeBlock);
+    }
+    return (block_size + 7) & ~((size_t)7);
+}
+
+// Initialize the pool to zero state
+void pool_allocator_init(PoolAllocator *pool) {
+    pool->memory = NULL;
+    pool->block_size = 0;
+    pool->block_count = 0;
+    pool->used_count = 0;
+    pool->next_unused = 0;
+    pool->dirty_count = 0;
+    pool->free_list = NULL;
+    pool->owns_memory = 0;
+}
+
+// Create pool owning its memory
+// Returns 0 on success, -1 on failure
+int pool_allocator_create(PoolAllocator *pool, size_t block_size, size_t block_count) {
+    if (pool == NULL || block_size == 0 || block_count == 0) {
+        return -1;
+    }
+
+    size_t rounded = round_block_size(block_size);
+    if (rounded < block_size || block_count > SIZE_MAX / rounded) {
+        return -1;
+    }
+
+    void *memory = calloc(block_count, rounded);
+    if (memory == NULL) {
+        return -1;
+    }
+
+    if (pool_allocator_create_from(pool, memory, block_size, block_count) != 0) {
+        free(memory);
+        return -1;
+    }
+    pool->owns_memory = 1;
+    pool->dirty_count = 0;  // calloc memory starts zeroed
+
+    return 0;
+}
+
+// Create pool on caller-provided memory
+// Returns 0 on success, -1 on failure
+int pool_allocator_create_from(PoolAllocator *pool, void *memory, size_t block_size, size_t block_count) {
+    if (pool == NULL || memory == NULL || block_size == 0 || block_count == 0) {
+        return -1;
+    }
+
+    size_t rounded = round_block_size(block_size);
+    if (rounded < block_size || block_count > SIZE_MAX / rounded) {
+        return -1;
+    }
+
+    pool->memory = memory;
+    pool->block_size = rounded;
+    pool->block_count = block_count;
+    pool->used_count = 0;
+    pool->next_unused = 0;
+    pool->dirty_count = block_count;  // Nothing is known about caller memory
+    pool->free_list = NULL;
+    pool->owns_memory = 0;
+    GUARD_UNTOUCHED(memory, rounded * block_count);
+
+    return 0;
+}
+
+// Allocate one block
+// Returns pointer to the block, or NULL if the pool is exhausted
+void *pool_allocator_alloc(PoolAllocator *pool) {
+    if (pool == NULL) {
+        return NULL;
+    }
+
+    // Recycled blocks first: they are likely still in cache
+    PoolFreeBlock *block = pool->free_list;
+    if (block != NULL) {
+        pool->free_list = block->next;
+        pool->used_count++;
+        GUARD_REUSE_BLOCK(pool, block);
+        return block;
+    }
+
+    if (pool->next_unused < pool->block_count) {
+        void *ptr = pool->memory + pool->next_unused * pool->block_size;
+        pool->next_unused++;
+        pool->used_count++;
+        GUARD_FRESH_BLOCK(pool, ptr);
+        return ptr;
+    }
+
+    return NULL;
+}
+
+// Allocate one zeroed block
+// Returns pointer to the block, or NULL if the pool is exhausted
+void *pool_allocator_calloc(PoolAllocator *pool) {
+    if (pool == NULL) {
+        return NULL;
+    }
+
+    // Recycled blocks held data; fresh ones only if a reset handed them out before
+    int recycled = pool->free_list != NULL;
+    unsigned char *ptr = pool_allocator_alloc(pool);
+    if (ptr != NULL && (recycled || (size_t)(ptr - pool->memory) / pool->block_size < pool->dirty_count)) {
+        memory_zero(ptr, pool->block_size);
+    }
+    return ptr;
+}
+
+// Allocate up to `count` blocks into out[]
+// Returns the number of blocks handed out (less than count if the pool runs dry)
+size_t pool_allocator_alloc_batch(PoolAllocator *pool, size_t count, void **out) {
+    if (pool == NULL || out == NULL) {
+        return 0;
+    }
+
+    size_t n = 0;
+    PoolFreeBlock *block = pool->free_list;
+    while (n < count && block != NULL) {
+        out[n++] = block;
+        block = block->next;
+        GUARD_REUSE_BLOCK(pool, out[n - 1]);
+    }
+    pool->free_list = block;
+
+    // Untouched blocks are one contiguous range: take them with one bounds check
+    size_t fresh = pool->block_count - pool->next_unused;
+    if (fresh > count - n) {
+        fresh = count - n;
+    }
+    unsigned char *cursor = pool->memory + pool->next_unused * pool->block_size;
+    for (size_t i = 0; i < fresh; i++) {
+        GUARD_FRESH_BLOCK(pool, cursor);
+        out[n++] = cursor;
+        cursor += pool->block_size;
+    }
+    pool->next_unused += fresh;
+    pool->used_count += n;
+
+    return n;
+}
+
+// Return a block to the pool
+void pool_allocator_free(PoolAllocator *pool, void *ptr) {
+    if (pool == NULL || ptr == NULL) {
+        return;
+    }
+
+    PoolFreeBlock *block = ptr;
+    GUARD_FREE_BLOCK(pool, block);
+    block->next = pool->free_list;
+    pool->free_list = block;
+    pool->used_count--;
+}
+
+// Return every block to the pool
+void pool_allocator_reset(PoolAllocator *pool) {
+    if (pool != NULL) {
+        if (pool->memory != NULL) {
+            GUARD_DEAD(pool->memory, pool->next_unused * pool->block_size);
+        }
+        if (pool->next_unused > pool->dirty_count) {
+            pool->dirty_count = pool->next_unused;
+        }
+        pool->used_count = 0;
+        pool->next_unused = 0;
+        pool->free_list = NULL;
+    }
+}
+
+// Check whether ptr points at a block inside the pool
+int pool_allocator_owns(const PoolAllocator *pool, const void *ptr) {
+    if (pool == NULL || pool->memory == NULL || ptr == NULL) {
+        return 0;
+    }
+
+    uintptr_t start = (uintptr_t)pool->memory;
+    uintptr_t addr = (uintptr_t)ptr;
+    return addr >= start && addr < start + pool->block_size * pool->block_count;
+}
+
+// Number of blocks currently handed out
+size_t pool_allocator_used(const PoolAllocator *pool) {
+    return pool != NULL ? pool->used_count : 0;
+}
+
+// Number of blocks still available
+size_t pool_allocator_available(const PoolAllocator *pool) {
+    return pool != NULL ? pool->block_count - pool->used_count : 0;
+}
+
+// Destroy pool and free its memory if owned
+void pool_allocator_destroy(PoolAllocator *pool) {
+    if (pool != NULL) {
+        if (pool->memory != NULL) {
+            GUARD_LIVE(pool->memory, pool->block_size * pool->block_count);  // Hand the memory back unpoisoned
+        }
+        if (pool->owns_memory) {
+            free(pool->memory);
+        }
+        pool_allocator_init(pool);
+    }
+}
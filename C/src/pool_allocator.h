@@ -0,0 +1,67 @@
+#ifndef POOL_ALLOCATOR_H
+#define POOL_ALLOCATOR_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Free blocks store the link to the next free block in their first bytes
+typedef struct PoolFreeBlock {
+    struct PoolFreeBlock *next;
+} PoolFreeBlock;
+
+typedef struct {
+    unsigned char *memory;
+    size_t block_size;
+    size_t block_count;
+    size_t used_count;
+    size_t next_unused;       // Blocks at or above this index were never handed out
+    size_t dirty_count;       // Blocks below this index may hold old data (the rest are zero)
+    PoolFreeBlock *free_list; // Recycled blocks only
+    int owns_memory;          // Pool was created with create() and frees its memory
+} PoolAllocator;
+
+// Initialize pool struct to zero state
+void pool_allocator_init(PoolAllocator *pool);
+
+// Create pool owning memory for block_count blocks of block_size bytes
+int pool_allocator_create(PoolAllocator *pool, size_t block_size, size_t block_count);
+
+// Create pool on caller-provided memory (at least block_count * rounded block size bytes)
+int pool_allocator_create_from(PoolAllocator *pool, void *memory, size_t block_size, size_t block_count);
+
+// Allocate one block (returns NULL if the pool is exhausted)
+void *pool_allocator_alloc(PoolAllocator *pool);
+
+// Allocate one zeroed block (blocks that never held data are not cleared again)
+void *pool_allocator_calloc(PoolAllocator *pool);
+
+// Allocate up to `count` blocks into out[] (recycled first, then fresh ones)
+// Returns the number handed out, less than count if the pool runs dry
+size_t pool_allocator_alloc_batch(PoolAllocator *pool, size_t count, void **out);
+
+// Return a block to the pool (NULL is ignored)
+void pool_allocator_free(PoolAllocator *pool, void *ptr);
+
+// Return every block to the pool in O(1)
+void pool_allocator_reset(PoolAllocator *pool);
+
+// Check whether ptr points into the pool's memory
+int pool_allocator_owns(const PoolAllocator *pool, const void *ptr);
+
+// Number of blocks currently handed out
+size_t pool_allocator_used(const PoolAllocator *pool);
+
+// Number of blocks still available
+size_t pool_allocator_available(const PoolAllocator *pool);
+
+// Destroy pool and free its memory if owned
+void pool_allocator_destroy(PoolAllocator *pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,370 @@
+/*
+ * Shared memory arena
+ *
+ * Zero-copy transport for multi-process pipelines: producers allocate
+ * records directly in a shared segment and hand consumers an offset
+ * instead of copying bytes through a socket. The bump offset, the published
+ * root and every pool's free stack are lock-free 64-bit atomics inside the
+ * segment; lock-free atomics are address-free, so they work across
+ * processes that map the segment at different addresses.
+ *
+ * Pools use the same tagged {tag, index + 1} stack heads as the concurrent
+ * pool allocator, with links stored as block indices so they mean the same
+ * thing in every mapping.
+ */
+
+#define _GNU_SOURCE  // Required for memfd_create
+
+#include "shared_memory_arena.h"
+#include <fcntl.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define SHARED_MEMORY_MAGIC      0x534d41534547ull  // "SMASEG"
+#define SHARED_MEMORY_POOL_MAGIC 0x534d41504f4full  // "SMAPOO"
+#define SHARED_MEMORY_VERSION    1
+
+struct SharedMemorySegment {
+    _Atomic uint64_t magic;  // Stored last by the creator, so openers never see a half-built header
+    uint32_t version;
+    uint32_t header_size;
+    uint64_t size;
+    _Alignas(64) _Atomic uint64_t used;  // Bump offset from the segment start
+    _Atomic uint64_t root;
+};
+
+struct SharedMemoryPoolHeader {
+    uint64_t magic;
+    uint64_t block_size;
+    uint64_t block_count;
+    uint64_t blocks;                            // Offset of block 0
+    _Alignas(64) _Atomic uint64_t free_head;    // {tag, index + 1}
+    _Alignas(64) _Atomic uint64_t next_unused;  // Blocks at or above this index were never handed out
+};
+
+#define HEAD_REF(head) ((uint32_t)(head))
+#define HEAD_TAG(head) ((uint32_t)((head) >> 32))
+#define MAKE_HEAD(tag, ref) (((uint64_t)(uint32_t)(tag) << 32) | (uint32_t)(ref))
+
+// Map `fd` and check the header; `create` initializes it instead
+// Returns 0 on success, -1 on failure
+static int map_segment(SharedMemoryArena *arena, int fd, size_t size, int create) {
+    void *base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        return -1;
+    }
+    struct SharedMemorySegment *segment = base;
+
+    // A lock-based atomic would hide its lock in this process only
+    if (!atomic_is_lock_free(&segment->used)) {
+        munmap(base, size);
+        return -1;
+    }
+
+    if (create) {
+        segment->version = SHARED_MEMORY_VERSION;
+        segment->header_size = sizeof(*segment);
+        segment->size = size;
+        atomic_init(&segment->used, sizeof(*segment));
+        atomic_init(&segment->root, SHARED_MEMORY_NULL_OFFSET);
+        atomic_store_explicit(&segment->magic, SHARED_MEMORY_MAGIC, memory_order_release);
+    } else if (atomic_load_explicit(&segment->magic, memory_order_acquire) != SHARED_MEMORY_MAGIC ||
+               segment->version != SHARED_MEMORY_VERSION || segment->header_size != sizeof(*segment) ||
+               segment->size != size) {
+        munmap(base, size);
+        return -1;
+    }
+
+    arena->base = base;
+    arena->size = size;
+    arena->segment = segment;
+    arena->fd = fd;
+    return 0;
+}
+
+// Initialize the arena to zero state
+void shared_memory_arena_init(SharedMemoryArena *arena) {
+    if (arena != NULL) {
+        arena->base = NULL;
+        arena->size = 0;
+        arena->segment = NULL;
+        arena->fd = -1;
+    }
+}
+
+// Create and initialize a segment
+// Returns 0 on success, -1 on failure
+int shared_memory_arena_create(SharedMemoryArena *arena, const char *name, size_t size) {
+    if (arena == NULL) {
+        return -1;
+    }
+    shared_memory_arena_init(arena);
+    if (size <= sizeof(struct SharedMemorySegment) || (off_t)size < 0) {
+        return -1;
+    }
+
+    int fd = name != NULL ? shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600)
+                          : memfd_create("shared_memory_arena", MFD_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+    if (ftruncate(fd, (off_t)size) != 0 || map_segment(arena, fd, size, 1) != 0) {
+        close(fd);
+        if (name != NULL) {
+            shm_unlink(name);
+        }
+        return -1;
+    }
+    return 0;
+}
+
+// Map a named segment
+// Returns 0 on success, -1 on failure
+int shared_memory_arena_open(SharedMemoryArena *arena, const char *name) {
+    if (arena == NULL || name == NULL) {
+        return -1;
+    }
+    int fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0) {
+        shared_memory_arena_init(arena);
+        return -1;
+    }
+    int result = shared_memory_arena_open_fd(arena, fd);
+    close(fd);
+    return result;
+}
+
+// Map the segment behind an fd
+// Returns 0 on success, -1 on failure
+int shared_memory_arena_open_fd(SharedMemoryArena *arena, int fd) {
+    if (arena == NULL) {
+        return -1;
+    }
+    shared_memory_arena_init(arena);
+
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0 || st.st_size <= (off_t)sizeof(struct SharedMemorySegment)) {
+        return -1;
+    }
+    int own_fd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+    if (own_fd < 0) {
+        return -1;
+    }
+    if (map_segment(arena, own_fd, (size_t)st.st_size, 0) != 0) {
+        close(own_fd);
+        return -1;
+    }
+    return 0;
+}
+
+// Allocate with default alignment
+// Returns pointer to allocated memory, or NULL if not enough space
+void *shared_memory_arena_alloc(SharedMemoryArena *arena, size_t size) {
+    return shared_memory_arena_alloc_aligned(arena, size, 8);
+}
+
+// Allocate with explicit alignment (CAS loop so a failed request leaves the space usable)
+// Returns pointer to allocated memory, or NULL if not enough space
+void *shared_memory_arena_alloc_aligned(SharedMemoryArena *arena, size_t size, size_t alignment) {
+    if (arena == NULL || arena->segment == NULL || size == 0 || alignment == 0 ||
+        (alignment & (alignment - 1)) != 0 ||
+        (alignment > 4096 && alignment > (size_t)sysconf(_SC_PAGESIZE))) {  // Pages are at least 4 KiB
+        return NULL;
+    }
+    if (alignment < 8) {
+        alignment = 8;
+    }
+    size_t aligned_size = (size + 7) & ~(size_t)7;
+    if (aligned_size < size || aligned_size > arena->size) {
+        return NULL;
+    }
+
+    _Atomic uint64_t *used = &arena->segment->used;
+    uint64_t current = atomic_load_explicit(used, memory_order_relaxed);
+    uint64_t offset;
+    do {
+        offset = (current + (alignment - 1)) & ~((uint64_t)alignment - 1);
+        if (offset > arena->size - aligned_size) {
+            return NULL;  // Not enough space
+        }
+    } while (!atomic_compare_exchange_weak_explicit(used, &current, offset + aligned_size, memory_order_relaxed,
+                                                    memory_order_relaxed));
+
+    return arena->base + offset;
+}
+
+// Bounds check against the allocated part of the segment
+int shared_memory_arena_contains(const SharedMemoryArena *arena, SharedMemoryOffset offset) {
+    if (arena == NULL || arena->segment == NULL || offset < sizeof(struct SharedMemorySegment)) {
+        return 0;
+    }
+    return offset < atomic_load_explicit(&arena->segment->used, memory_order_acquire);
+}
+
+// Publish the root handle
+void shared_memory_arena_set_root(SharedMemoryArena *arena, SharedMemoryOffset root) {
+    if (arena != NULL && arena->segment != NULL) {
+        atomic_store_explicit(&arena->segment->root, root, memory_order_release);
+    }
+}
+
+// Read the root handle
+SharedMemoryOffset shared_memory_arena_root(const SharedMemoryArena *arena) {
+    if (arena == NULL || arena->segment == NULL) {
+        return SHARED_MEMORY_NULL_OFFSET;
+    }
+    return atomic_load_explicit(&arena->segment->root, memory_order_acquire);
+}
+
+// Bytes handed out so far
+size_t shared_memory_arena_used(const SharedMemoryArena *arena) {
+    if (arena == NULL || arena->segment == NULL) {
+        return 0;
+    }
+    return (size_t)atomic_load_explicit(&arena->segment->used, memory_order_relaxed);
+}
+
+// Rewind the segment (requires quiescence)
+void shared_memory_arena_reset(SharedMemoryArena *arena) {
+    if (arena != NULL && arena->segment != NULL) {
+        atomic_store(&arena->segment->root, SHARED_MEMORY_NULL_OFFSET);
+        atomic_store(&arena->segment->used, sizeof(struct SharedMemorySegment));
+    }
+}
+
+// Unmap this view
+void shared_memory_arena_close(SharedMemoryArena *arena) {
+    if (arena != NULL && arena->base != NULL) {
+        munmap(arena->base, arena->size);
+        close(arena->fd);
+        shared_memory_arena_init(arena);
+    }
+}
+
+// Remove a named segment
+// Returns 0 on success, -1 on failure
+int shared_memory_arena_unlink(const char *name) {
+    return name != NULL && shm_unlink(name) == 0 ? 0 : -1;
+}
+
+static inline _Atomic uint32_t *pool_link(const SharedMemoryPool *pool, uint32_t ref) {
+    return (_Atomic uint32_t *)(pool->blocks + (size_t)(ref - 1) * pool->header->block_size);
+}
+
+// Carve a pool from the segment
+// Returns 0 on success, -1 on failure
+int shared_memory_pool_create(SharedMemoryPool *pool, SharedMemoryArena *arena, size_t block_size,
+                              size_t block_count) {
+    if (pool == NULL || block_size == 0 || block_count == 0 || block_count >= UINT32_MAX) {
+        return -1;
+    }
+    pool->arena = NULL;
+    pool->header = NULL;
+    pool->blocks = NULL;
+
+    size_t rounded = (block_size + 7) & ~(size_t)7;
+    if (rounded < block_size || block_count > SIZE_MAX / rounded) {
+        return -1;
+    }
+
+    struct SharedMemoryPoolHeader *header = shared_memory_arena_alloc_aligned(arena, sizeof(*header), 64);
+    unsigned char *blocks = shared_memory_arena_alloc_aligned(arena, rounded * block_count, 64);
+    if (header == NULL || blocks == NULL) {
+        return -1;  // The header (if any) stays allocated until the segment resets
+    }
+
+    header->block_size = rounded;
+    header->block_count = block_count;
+    header->blocks = shared_memory_arena_offset(arena, blocks);
+    atomic_init(&header->free_head, 0);
+    atomic_init(&header->next_unused, 0);
+    header->magic = SHARED_MEMORY_POOL_MAGIC;
+
+    pool->arena = arena;
+    pool->header = header;
+    pool->blocks = blocks;
+    return 0;
+}
+
+// Attach to a pool by handle
+// Returns 0 on success, -1 if the handle does not name a pool in this segment
+int shared_memory_pool_attach(SharedMemoryPool *pool, SharedMemoryArena *arena, SharedMemoryOffset offset) {
+    if (pool == NULL) {
+        return -1;
+    }
+    pool->arena = NULL;
+    pool->header = NULL;
+    pool->blocks = NULL;
+    if (!shared_memory_arena_contains(arena, offset) || offset % 64 != 0) {
+        return -1;
+    }
+
+    struct SharedMemoryPoolHeader *header = shared_memory_arena_ptr(arena, offset);
+    if (header->magic != SHARED_MEMORY_POOL_MAGIC || !shared_memory_arena_contains(arena, header->blocks)) {
+        return -1;
+    }
+    pool->arena = arena;
+    pool->header = header;
+    pool->blocks = shared_memory_arena_ptr(arena, header->blocks);
+    return 0;
+}
+
+// Handle of the pool header
+SharedMemoryOffset shared_memory_pool_offset(const SharedMemoryPool *pool) {
+    if (pool == NULL || pool->header == NULL) {
+        return SHARED_MEMORY_NULL_OFFSET;
+    }
+    return shared_memory_arena_offset(pool->arena, pool->header);
+}
+
+// Allocate one block: recycled first, then never-used ones
+// Returns pointer to the block, or NULL if the pool is exhausted
+void *shared_memory_pool_alloc(SharedMemoryPool *pool) {
+    if (pool == NULL || pool->header == NULL) {
+        return NULL;
+    }
+    struct SharedMemoryPoolHeader *header = pool->header;
+
+    uint64_t head = atomic_load_explicit(&header->free_head, memory_order_acquire);
+    while (HEAD_REF(head) != 0) {
+        // May read a block another process just took; the tag makes that CAS fail
+        uint32_t next = atomic_load_explicit(pool_link(pool, HEAD_REF(head)), memory_order_relaxed);
+        if (atomic_compare_exchange_weak_explicit(&header->free_head, &head, MAKE_HEAD(HEAD_TAG(head) + 1, next),
+                                                  memory_order_acquire, memory_order_acquire)) {
+            return pool_link(pool, HEAD_REF(head));
+        }
+    }
+
+    if (atomic_load_explicit(&header->next_unused, memory_order_relaxed) >= header->block_count) {
+        return NULL;  // Exhausted: skip the fetch-add so the counter stops growing
+    }
+    uint64_t index = atomic_fetch_add_explicit(&header->next_unused, 1, memory_order_relaxed);
+    if (index >= header->block_count) {
+        return NULL;
+    }
+    return pool->blocks + index * header->block_size;
+}
+
+// Push a block onto the free stack
+void shared_memory_pool_free(SharedMemoryPool *pool, void *ptr) {
+    if (pool == NULL || pool->header == NULL || ptr == NULL) {
+        return;
+    }
+    struct SharedMemoryPoolHeader *header = pool->header;
+    uint32_t ref = (uint32_t)(((unsigned char *)ptr - pool->blocks) / header->block_size) + 1;
+    _Atomic uint32_t *link = ptr;
+
+    uint64_t head = atomic_load_explicit(&header->free_head, memory_order_relaxed);
+    do {
+        atomic_store_explicit(link, HEAD_REF(head), memory_order_relaxed);
+    } while (!atomic_compare_exchange_weak_explicit(&header->free_head, &head, MAKE_HEAD(HEAD_TAG(head) + 1, ref),
+                                                    memory_order_release, memory_order_relaxed));
+}
+
+// Rounded block size
+size_t shared_memory_pool_block_size(const SharedMemoryPool *pool) {
+    return pool != NULL && pool->header != NULL ? (size_t)pool->header->block_size : 0;
+}
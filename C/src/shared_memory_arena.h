@@ -0,0 +1,124 @@
+#ifndef SHARED_MEMORY_ARENA_H
+#define SHARED_MEMORY_ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Bump arena and fixed-size pools in a shared memory segment. All state
+ * lives in the segment itself (a header with process-shared atomics), so
+ * every process that maps it allocates from the same space without a
+ * lock. Each process maps the segment at its own address; memory is
+ * exchanged as SharedMemoryOffset handles and resolved per process.
+ *
+ * Segments are named (shm_open, found by name) or anonymous (memfd,
+ * shared by fork or by passing the fd). create, reset and close are NOT
+ * thread-safe; reset additionally requires every process to be quiescent.
+ */
+
+// Offset of an allocation from the start of the segment. 0 is never handed
+// out (the segment header lives there), so it doubles as the null handle
+typedef uint64_t SharedMemoryOffset;
+
+#define SHARED_MEMORY_NULL_OFFSET 0
+
+// Segment header (defined in shared_memory_arena.c)
+struct SharedMemorySegment;
+
+// One process's view of a segment
+typedef struct {
+    unsigned char *base;                  // Start of this process's mapping
+    size_t size;                          // Segment bytes, header included
+    struct SharedMemorySegment *segment;  // == base
+    int fd;
+} SharedMemoryArena;
+
+// Pool header inside the segment (defined in shared_memory_arena.c)
+struct SharedMemoryPoolHeader;
+
+// One process's view of a pool carved from a segment
+typedef struct {
+    SharedMemoryArena *arena;
+    struct SharedMemoryPoolHeader *header;
+    unsigned char *blocks;
+} SharedMemoryPool;
+
+// Initialize arena struct to zero state
+void shared_memory_arena_init(SharedMemoryArena *arena);
+
+// Create a segment of `size` bytes. A name ("/ingest") creates a new shm_open
+// object and fails if it exists; NULL creates an anonymous memfd segment
+int shared_memory_arena_create(SharedMemoryArena *arena, const char *name, size_t size);
+
+// Map an existing named segment (fails until its creator has initialized it)
+int shared_memory_arena_open(SharedMemoryArena *arena, const char *name);
+
+// Map the segment behind `fd` (duplicated; the caller keeps its own fd)
+int shared_memory_arena_open_fd(SharedMemoryArena *arena, int fd);
+
+// Allocate from the shared bump offset (thread- and process-safe)
+void *shared_memory_arena_alloc(SharedMemoryArena *arena, size_t size);
+
+// Allocate with `alignment` (power of two up to the page size). Offsets are
+// aligned, and every mapping starts on a page, so the alignment holds in all
+// processes
+void *shared_memory_arena_alloc_aligned(SharedMemoryArena *arena, size_t size, size_t alignment);
+
+// Handle for a pointer into this process's mapping (NULL maps to 0)
+static inline SharedMemoryOffset shared_memory_arena_offset(const SharedMemoryArena *arena, const void *ptr) {
+    return ptr != NULL ? (SharedMemoryOffset)((const unsigned char *)ptr - arena->base) : SHARED_MEMORY_NULL_OFFSET;
+}
+
+// Pointer for a handle in this process's mapping (0 maps to NULL)
+static inline void *shared_memory_arena_ptr(const SharedMemoryArena *arena, SharedMemoryOffset offset) {
+    return offset != SHARED_MEMORY_NULL_OFFSET ? arena->base + offset : NULL;
+}
+
+// Check whether `offset` names memory inside the segment's allocated range
+int shared_memory_arena_contains(const SharedMemoryArena *arena, SharedMemoryOffset offset);
+
+// Publish an entry point for other processes (release) / read it (acquire)
+void shared_memory_arena_set_root(SharedMemoryArena *arena, SharedMemoryOffset root);
+SharedMemoryOffset shared_memory_arena_root(const SharedMemoryArena *arena);
+
+// Bytes allocated so far, header included (thread-safe snapshot)
+size_t shared_memory_arena_used(const SharedMemoryArena *arena);
+
+// Rewind the segment and clear the root (all processes must be quiescent;
+// pools carved from it are discarded too)
+void shared_memory_arena_reset(SharedMemoryArena *arena);
+
+// Unmap this process's view (the segment lives on while mapped or named)
+void shared_memory_arena_close(SharedMemoryArena *arena);
+
+// Remove a named segment; existing mappings stay valid
+int shared_memory_arena_unlink(const char *name);
+
+// Carve a pool of block_count blocks of block_size bytes from the segment
+int shared_memory_pool_create(SharedMemoryPool *pool, SharedMemoryArena *arena, size_t block_size,
+                              size_t block_count);
+
+// Attach to a pool another process created (offset from shared_memory_pool_offset)
+int shared_memory_pool_attach(SharedMemoryPool *pool, SharedMemoryArena *arena, SharedMemoryOffset offset);
+
+// Handle other processes pass to shared_memory_pool_attach
+SharedMemoryOffset shared_memory_pool_offset(const SharedMemoryPool *pool);
+
+// Allocate one block (lock-free across processes, NULL if exhausted)
+void *shared_memory_pool_alloc(SharedMemoryPool *pool);
+
+// Return a block, from any process attached to the pool (NULL is ignored)
+void shared_memory_pool_free(SharedMemoryPool *pool, void *ptr);
+
+// Rounded block size
+size_t shared_memory_pool_block_size(const SharedMemoryPool *pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -4,74 +4,1034 @@
  * This is a bump/arena allocator that allocates memory from a pre-allocated pool.
  * Allocations are fast (O(1)) but individual frees are not supported.
  * Use reset() to free all allocations at once, or destroy() to free the pool.
+ *
+ * In growable mode a full pool chains an extra block (growth_factor times the
+ * current block, up to max_block_size) instead of returning NULL.
+ *
+ * Allocation sizes are rounded to 8-byte granules. The start address is
+ * aligned to the pool's default alignment, or to an explicit per-call
+ * alignment via simple_memory_allocator_alloc_aligned().
+ *
+ * Blocks come from malloc() by default. The mmap backing maps them directly
+ * so large pools can use huge pages, bind to a NUMA node and be pre-faulted
+ * at creation instead of on first touch.
+ *
+ * Child arenas borrow their blocks from a parent instead: a parent arena
+ * (released blocks go back only if they are its last allocation, otherwise
+ * at its next reset) or a PoolAllocator whose blocks each hold one child
+ * block. Creating a child costs a bump or a pop, with no system call.
+ *
+ * Building with -DSIMPLE_MEMORY_ALLOCATOR_STATS adds per-allocator counters
+ * (see SimpleMemoryAllocatorStats); without it the hooks compile to nothing.
+ *
+ * Building with -DSIMPLE_MEMORY_ALLOCATOR_GUARD follows every allocation
+ * with a red zone and poisons the unused tail and everything a reset or
+ * rewind gives back (see memory_guard.h), so sanitizers see arena memory
+ * the way they see individual mallocs.
+ *
+ * Every block tracks how far it may hold old bytes. Fresh mmap pages are
+ * zero, so calloc() only clears the part of an allocation below that mark:
+ * nothing on a fresh block, the recycled prefix after a reset.
  */
 
+#define _GNU_SOURCE  // Required for MAP_ANONYMOUS, MAP_HUGETLB, madvise and syscall
+
 #include "simple_memory_allocator.h"
+#include "pool_allocator.h"
+#include "memory_guard.h"
+#include "memory_zero.h"
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/*
+ * Every block carries a small header in front of its usable memory. The
+ * allocator only bumps inside the current block; in growable mode a full
+ * block is retired into the chain and a larger one takes its place.
+ */
+struct SimpleMemoryBlock {
+    struct SimpleMemoryBlock *prev;  // Older block (NULL for the oldest)
+    size_t size;                     // Usable bytes after the header
+    size_t used;                     // Bytes used when the block was retired
+    size_t mapped_length;            // Length of the mmap region (0 = malloc'd)
+    size_t resident;                 // Prefix touched since the last decommit (mmap only)
+    size_t dirty;                    // Prefix that may hold old bytes; the rest is zero
+};
+
+// Header size rounded up so block memory keeps malloc's 16-byte alignment
+#define BLOCK_ALIGNMENT   16
+#define BLOCK_HEADER_SIZE ((sizeof(struct SimpleMemoryBlock) + BLOCK_ALIGNMENT - 1) & ~((size_t)BLOCK_ALIGNMENT - 1))
+
+static inline int is_power_of_two(size_t value) {
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+static inline void *block_memory(struct SimpleMemoryBlock *block) {
+    return (uint8_t *)block + BLOCK_HEADER_SIZE;
+}
+
+// Record that the first `extent` bytes of the block have been handed out
+static inline void mark_dirty(struct SimpleMemoryBlock *block, size_t extent) {
+    if (extent > block->dirty) {
+        block->dirty = extent;
+    }
+}
+
+#define HUGE_PAGE_SIZE ((size_t)2 * 1024 * 1024)
+
+#ifndef MPOL_BIND
+#define MPOL_BIND 2
+#endif
+
+// Bind [addr, addr + length) to a single NUMA node
+// Returns 0 on success, -1 on failure
+static int bind_numa_node(void *addr, size_t length, int node) {
+#if defined(__linux__) && defined(SYS_mbind)
+    if (node < 0 || node >= (int)(sizeof(unsigned long) * 8)) {
+        return -1;
+    }
+    unsigned long nodemask = 1UL << node;
+    return syscall(SYS_mbind, addr, length, MPOL_BIND, &nodemask, sizeof(nodemask) * 8, 0) == 0 ? 0 : -1;
+#else
+    (void)addr;
+    (void)length;
+    (void)node;
+    return -1;
+#endif
+}
+
+#ifdef SIMPLE_MEMORY_ALLOCATOR_STATS
+// Bucket for a request: <=16 -> 0, then one bucket per power of 4, capped
+static inline size_t stats_bucket(size_t size) {
+    if (size <= 16) {
+        return 0;
+    }
+    size_t bits = sizeof(unsigned long) * 8 - (size_t)__builtin_clzl((unsigned long)(size - 1));
+    size_t bucket = (bits - 3) / 2;
+    return bucket < SIMPLE_MEMORY_STATS_BUCKETS ? bucket : SIMPLE_MEMORY_STATS_BUCKETS - 1;
+}
+
+static inline void stats_alloc(SimpleMemoryAllocatorStats *stats, size_t size, size_t consumed) {
+    size_t bucket = stats_bucket(size);
+    stats->alloc_calls++;
+    stats->bytes_requested += size;
+    stats->padding_bytes += consumed - size;
+    stats->current_bytes += consumed;
+    if (stats->current_bytes > stats->high_water) {
+        stats->high_water = stats->current_bytes;
+    }
+    stats->bucket_allocs[bucket]++;
+    stats->bucket_bytes[bucket] += size;
+}
+
+static inline void stats_failed(SimpleMemoryAllocatorStats *stats) {
+    stats->alloc_calls++;
+    stats->failed_allocs++;
+}
+
+// In-place resize of the last allocation from `old_consumed` to `new_consumed` bytes
+static inline void stats_resize(SimpleMemoryAllocatorStats *stats, size_t old_consumed, size_t new_consumed) {
+    stats->current_bytes = stats->current_bytes - old_consumed + new_consumed;
+    if (stats->current_bytes > stats->high_water) {
+        stats->high_water = stats->current_bytes;
+    }
+}
+
+#define STATS_ALLOC(allocator, size, consumed) stats_alloc(&(allocator)->stats, (size), (consumed))
+#define STATS_RESIZE(allocator, old_consumed, new_consumed) \
+    stats_resize(&(allocator)->stats, (old_consumed), (new_consumed))
+#define STATS_FAILED(allocator)                 stats_failed(&(allocator)->stats)
+#define STATS_GROW(allocator)                   ((allocator)->stats.blocks_chained++)
+#define STATS_RESET(allocator)                  ((allocator)->stats.resets++, (allocator)->stats.current_bytes = 0)
+#else
+#define STATS_ALLOC(allocator, size, consumed) ((void)0)
+#define STATS_RESIZE(allocator, old_consumed, new_consumed) ((void)0)
+#define STATS_FAILED(allocator)                 ((void)0)
+#define STATS_GROW(allocator)                   ((void)0)
+#define STATS_RESET(allocator)                  ((void)0)
+#endif
+
+#ifdef SIMPLE_MEMORY_ALLOCATOR_GUARD
+#define GUARD_RED_ZONE SIMPLE_MEMORY_GUARD_RED_ZONE
+
+// Verify the most recent red zone, then forget it
+static void guard_check_last(SimpleMemoryAllocator *allocator) {
+    if (allocator->guard_zone != NULL) {
+        memory_guard_check(allocator->guard_zone, allocator->guard_length, MEMORY_GUARD_RED_ZONE_BYTE,
+                           "arena write past the end of an allocation");
+        allocator->guard_zone = NULL;
+        allocator->guard_length = 0;
+    }
+}
+
+// Open an object of `size` bytes and poison the rest of its `span`
+static void guard_object(SimpleMemoryAllocator *allocator, void *ptr, size_t size, size_t span) {
+    guard_check_last(allocator);
+    memory_guard_unpoison(ptr, size);
+    allocator->guard_zone = (uint8_t *)ptr + size;
+    allocator->guard_length = span - size;
+    memory_guard_poison(allocator->guard_zone, allocator->guard_length, MEMORY_GUARD_RED_ZONE_BYTE);
+}
+
+#define GUARD_OBJECT(allocator, ptr, size, span) guard_object((allocator), (ptr), (size), (span))
+#define GUARD_CHECK_LAST(allocator)             guard_check_last(allocator)
+#define GUARD_DEAD(addr, size)                  memory_guard_poison((addr), (size), MEMORY_GUARD_FREED_BYTE)
+#define GUARD_FRESH(addr, size)                 memory_guard_poison_fresh((addr), (size))
+#define GUARD_LIVE(addr, size)                  memory_guard_unpoison((addr), (size))
+#else
+#define GUARD_RED_ZONE 0
+#define GUARD_OBJECT(allocator, ptr, size, span) ((void)0)
+#define GUARD_CHECK_LAST(allocator)             ((void)0)
+#define GUARD_DEAD(addr, size)                  ((void)0)
+#define GUARD_FRESH(addr, size)                 ((void)0)
+#define GUARD_LIVE(addr, size)                  ((void)0)
+#endif
+
+// Fault in every page of the region up front
+static void prefault(void *addr, size_t length) {
+#ifdef MADV_POPULATE_WRITE
+    if (madvise(addr, length, MADV_POPULATE_WRITE) == 0) {
+        return;
+    }
+#endif
+    size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+    volatile uint8_t *bytes = addr;
+    for (size_t offset = 0; offset < length; offset += page_size) {
+        bytes[offset] = 0;
+    }
+}
+
+// Map `length` bytes according to the options
+// Returns the mapping, or NULL on failure
+static void *map_region(size_t length, const SimpleMemoryAllocatorOptions *options) {
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    unsigned map_flags = options->map_flags;
+    int adjust = (map_flags & (SIMPLE_MEMORY_MAP_TRANSPARENT_HUGE_PAGES | SIMPLE_MEMORY_MAP_NUMA_BIND)) != 0;
+    void *addr = MAP_FAILED;
+
+    // Advice and binding must land before the first touch, so only let the
+    // kernel populate the mapping when neither is requested
+#ifdef MAP_POPULATE
+    if ((map_flags & SIMPLE_MEMORY_MAP_POPULATE) && !adjust) {
+        flags |= MAP_POPULATE;
+    }
+#endif
+
+#ifdef MAP_HUGETLB
+    if (map_flags & SIMPLE_MEMORY_MAP_HUGETLB) {
+        addr = mmap(NULL, length, PROT_READ | PROT_WRITE, flags | MAP_HUGETLB, -1, 0);
+    }
+#endif
+    // Without reserved huge pages fall back to regular pages
+    if (addr == MAP_FAILED) {
+        addr = mmap(NULL, length, PROT_READ | PROT_WRITE, flags, -1, 0);
+    }
+    if (addr == MAP_FAILED) {
+        return NULL;
+    }
+
+    if ((map_flags & SIMPLE_MEMORY_MAP_NUMA_BIND) && bind_numa_node(addr, length, options->numa_node) != 0) {
+        munmap(addr, length);
+        return NULL;
+    }
+#ifdef MADV_HUGEPAGE
+    if (map_flags & SIMPLE_MEMORY_MAP_TRANSPARENT_HUGE_PAGES) {
+        madvise(addr, length, MADV_HUGEPAGE);
+    }
+#endif
+    if ((map_flags & SIMPLE_MEMORY_MAP_POPULATE) && adjust) {
+        prefault(addr, length);
+    }
+
+    return addr;
+}
+
+// Page size an mmap-backed block is mapped (and decommitted) with
+static size_t map_page_size(const SimpleMemoryAllocatorOptions *options) {
+    if (options->map_flags & (SIMPLE_MEMORY_MAP_HUGETLB | SIMPLE_MEMORY_MAP_TRANSPARENT_HUGE_PAGES)) {
+        return HUGE_PAGE_SIZE;
+    }
+    return (size_t)sysconf(_SC_PAGESIZE);
+}
+
+// Largest block the backing can provide (a parent pool's block minus the header)
+static size_t backing_limit(const SimpleMemoryAllocatorOptions *options) {
+    if (options->backing == SIMPLE_MEMORY_BACKING_PARENT_POOL) {
+        return ((const PoolAllocator *)options->parent)->block_size - BLOCK_HEADER_SIZE;
+    }
+    return SIZE_MAX;
+}
+
+// Allocate a block with `size` usable bytes using the configured backing
+static struct SimpleMemoryBlock *block_create(size_t size, const SimpleMemoryAllocatorOptions *options) {
+    if (size > SIZE_MAX - BLOCK_HEADER_SIZE - HUGE_PAGE_SIZE) {
+        return NULL;
+    }
+
+    struct SimpleMemoryBlock *block;
+    size_t mapped_length = 0;
+
+    if (options->backing == SIMPLE_MEMORY_BACKING_MMAP) {
+        // Round to the page size the mapping will use
+        size_t page_size = map_page_size(options);
+        mapped_length = (BLOCK_HEADER_SIZE + size + page_size - 1) & ~(page_size - 1);
+        block = map_region(mapped_length, options);
+    } else if (options->backing == SIMPLE_MEMORY_BACKING_PARENT_ARENA) {
+        block = simple_memory_allocator_alloc_aligned(options->parent, BLOCK_HEADER_SIZE + size, BLOCK_ALIGNMENT);
+    } else if (options->backing == SIMPLE_MEMORY_BACKING_PARENT_POOL) {
+        // A pool block is all or nothing: take the whole of it
+        if (size > backing_limit(options)) {
+            return NULL;
+        }
+        size = backing_limit(options);
+        block = pool_allocator_alloc(options->parent);
+    } else {
+        block = malloc(BLOCK_HEADER_SIZE + size);
+    }
+    if (block == NULL) {
+        return NULL;
+    }
+
+    block->prev = NULL;
+    block->size = size;
+    block->used = 0;
+    block->mapped_length = mapped_length;
+    block->resident = (options->map_flags & SIMPLE_MEMORY_MAP_POPULATE) ? size : 0;
+    block->dirty = mapped_length != 0 ? 0 : size;  // Anonymous pages start zeroed, malloc memory does not
+    GUARD_FRESH(block_memory(block), size);
+    return block;
+}
+
+// Return a block to wherever it came from
+static void block_release(struct SimpleMemoryBlock *block, const SimpleMemoryAllocatorOptions *options) {
+    GUARD_LIVE(block_memory(block), block->size);  // Shadow must not outlive the memory
+    if (block->mapped_length != 0) {
+        munmap(block, block->mapped_length);
+    } else if (options->backing == SIMPLE_MEMORY_BACKING_PARENT_ARENA) {
+        // Only the parent's most recent allocation can be handed back early
+        simple_memory_allocator_shrink_last(options->parent, block, BLOCK_HEADER_SIZE + block->size, 0);
+    } else if (options->backing == SIMPLE_MEMORY_BACKING_PARENT_POOL) {
+        pool_allocator_free(options->parent, block);
+    } else {
+        free(block);
+    }
+}
+
+// Make `block` the current block
+static void use_block(SimpleMemoryAllocator *allocator, struct SimpleMemoryBlock *block) {
+    allocator->block = block;
+    allocator->memory = block_memory(block);
+    allocator->size = block->size;
+    allocator->used = block->used;
+}
+
+// Chain a new block large enough for `aligned_size` bytes
+// Returns 0 on success, -1 on failure
+static int grow(SimpleMemoryAllocator *allocator, size_t aligned_size) {
+    size_t factor = allocator->options.growth_factor;
+    size_t next_size = allocator->size;
+
+    if (next_size <= SIZE_MAX / factor) {
+        next_size *= factor;
+    } else {
+        next_size = SIZE_MAX;
+    }
+
+    if (allocator->options.max_block_size != 0 && next_size > allocator->options.max_block_size) {
+        next_size = allocator->options.max_block_size;
+    }
+    if (next_size > backing_limit(&allocator->options)) {
+        next_size = backing_limit(&allocator->options);
+    }
+
+    // A request larger than the policy allows still gets a block of its own
+    if (next_size < aligned_size) {
+        next_size = aligned_size;
+    }
+
+    // A block kept warm by a rewind is reused before asking for new memory
+    struct SimpleMemoryBlock *block;
+    if (allocator->spare != NULL && allocator->spare->size >= aligned_size) {
+        block = allocator->spare;
+        allocator->spare = NULL;
+        block->used = 0;
+    } else {
+        block = block_create(next_size, &allocator->options);
+    }
+    if (block == NULL) {
+        return -1;
+    }
+
+    allocator->block->used = allocator->used;
+    block->prev = allocator->block;
+    use_block(allocator, block);
+    STATS_GROW(allocator);
+
+    return 0;
+}
 
 // Initialize the memory allocator to zero state
 void simple_memory_allocator_init(SimpleMemoryAllocator *allocator) {
     allocator->memory = NULL;
     allocator->size = 0;
     allocator->used = 0;
+    allocator->block = NULL;
+    allocator->spare = NULL;
+    allocator->decommit_average = 0;
+    allocator->options.growable = 0;
+    allocator->options.growth_factor = 0;
+    allocator->options.max_block_size = 0;
+    allocator->options.alignment = 0;
+    allocator->options.backing = SIMPLE_MEMORY_BACKING_MALLOC;
+    allocator->options.map_flags = 0;
+    allocator->options.numa_node = 0;
+    allocator->options.parent = NULL;
+#ifdef SIMPLE_MEMORY_ALLOCATOR_STATS
+    memset(&allocator->stats, 0, sizeof(allocator->stats));
+#endif
+#ifdef SIMPLE_MEMORY_ALLOCATOR_GUARD
+    allocator->guard_zone = NULL;
+    allocator->guard_length = 0;
+#endif
 }
 
 // Create allocator with a memory pool of given size
 // Returns 0 on success, -1 on failure
 int simple_memory_allocator_create(SimpleMemoryAllocator *allocator, size_t pool_size) {
+    return simple_memory_allocator_create_with_options(allocator, pool_size, NULL);
+}
+
+// Create allocator with explicit options
+// Returns 0 on success, -1 on failure
+int simple_memory_allocator_create_with_options(SimpleMemoryAllocator *allocator, size_t pool_size,
+                                                const SimpleMemoryAllocatorOptions *options) {
     if (allocator == NULL || pool_size == 0) {
         return -1;
     }
 
-    void *memory = malloc(pool_size);
-    if (memory == NULL) {
+    SimpleMemoryAllocatorOptions opts = {0};
+    if (options != NULL) {
+        opts = *options;
+    }
+    if (opts.growth_factor == 0) {
+        opts.growth_factor = SIMPLE_MEMORY_ALLOCATOR_DEFAULT_GROWTH_FACTOR;
+    }
+    if (opts.alignment == 0) {
+        opts.alignment = SIMPLE_MEMORY_ALLOCATOR_DEFAULT_ALIGNMENT;
+    } else if (!is_power_of_two(opts.alignment)) {
+        return -1;
+    } else if (opts.alignment < SIMPLE_MEMORY_ALLOCATOR_DEFAULT_ALIGNMENT) {
+        opts.alignment = SIMPLE_MEMORY_ALLOCATOR_DEFAULT_ALIGNMENT;
+    }
+    if (opts.backing == SIMPLE_MEMORY_BACKING_PARENT_ARENA) {
+        const SimpleMemoryAllocator *parent = opts.parent;
+        if (parent == NULL || parent->memory == NULL || parent == allocator) {
+            return -1;
+        }
+    } else if (opts.backing == SIMPLE_MEMORY_BACKING_PARENT_POOL) {
+        // Pool blocks must keep the 16-byte alignment fresh blocks promise
+        const PoolAllocator *parent = opts.parent;
+        if (parent == NULL || parent->memory == NULL || parent->block_size <= BLOCK_HEADER_SIZE ||
+            parent->block_size % BLOCK_ALIGNMENT != 0 || (uintptr_t)parent->memory % BLOCK_ALIGNMENT != 0) {
+            return -1;
+        }
+    } else if (opts.backing != SIMPLE_MEMORY_BACKING_MALLOC && opts.backing != SIMPLE_MEMORY_BACKING_MMAP) {
+        return -1;
+    }
+
+    struct SimpleMemoryBlock *block = block_create(pool_size, &opts);
+    if (block == NULL) {
         return -1;
     }
 
-    allocator->memory = memory;
-    allocator->size = pool_size;
-    allocator->used = 0;
+    allocator->options = opts;
+    allocator->decommit_average = 0;
+    use_block(allocator, block);
+#ifdef SIMPLE_MEMORY_ALLOCATOR_STATS
+    memset(&allocator->stats, 0, sizeof(allocator->stats));
+#endif
+#ifdef SIMPLE_MEMORY_ALLOCATOR_GUARD
+    allocator->guard_zone = NULL;
+    allocator->guard_length = 0;
+#endif
 
     return 0;
 }
 
-// Allocate memory from the pool
+// Offset of the first `alignment`-aligned address at or after the bump pointer
+static inline size_t aligned_offset(const SimpleMemoryAllocator *allocator, size_t alignment) {
+    uintptr_t cursor = (uintptr_t)allocator->memory + allocator->used;
+    uintptr_t aligned = (cursor + (alignment - 1)) & ~((uintptr_t)alignment - 1);
+    return allocator->used + (size_t)(aligned - cursor);
+}
+
+// Offset where `aligned_size` bytes at `alignment` fit, growing if allowed
+// Returns SIZE_MAX if there is no room; does not move the bump pointer
+static inline size_t reserve(SimpleMemoryAllocator *allocator, size_t aligned_size, size_t alignment) {
+    size_t offset = aligned_offset(allocator, alignment);
+    if (offset > allocator->size || aligned_size > allocator->size - offset) {
+        if (!allocator->options.growable) {
+            STATS_FAILED(allocator);
+            return SIZE_MAX;  // Not enough space
+        }
+
+        // Fresh blocks start 16-byte aligned; reserve padding beyond that
+        size_t padding = alignment > BLOCK_ALIGNMENT ? alignment - 1 : 0;
+        if (aligned_size > SIZE_MAX - padding || grow(allocator, aligned_size + padding) != 0) {
+            STATS_FAILED(allocator);
+            return SIZE_MAX;
+        }
+        offset = aligned_offset(allocator, alignment);
+    }
+    return offset;
+}
+
+// Shared bump path; `alignment` is a power of two >= 8
+static inline void *alloc_aligned(SimpleMemoryAllocator *allocator, size_t size, size_t alignment) {
+    // Sizes are kept in 8-byte granules; alignment only moves the start
+    size_t aligned_size = ((size + 7) & ~((size_t)7)) + GUARD_RED_ZONE;
+    if (aligned_size < size) {
+        return NULL;  // Size overflowed while aligning
+    }
+
+    size_t offset = reserve(allocator, aligned_size, alignment);
+    if (offset == SIZE_MAX) {
+        return NULL;
+    }
+
+    void *ptr = (uint8_t *)allocator->memory + offset;
+    STATS_ALLOC(allocator, size, offset + aligned_size - allocator->used);
+    allocator->used = offset + aligned_size;
+    GUARD_OBJECT(allocator, ptr, size, aligned_size);
+
+    return ptr;
+}
+
+// Allocate memory from the pool using the pool's default alignment
 // Returns pointer to allocated memory, or NULL if not enough space
 void *simple_memory_allocator_alloc(SimpleMemoryAllocator *allocator, size_t size) {
     if (allocator == NULL || allocator->memory == NULL || size == 0) {
         return NULL;
     }
 
-    // Align to 8 bytes for better performance
-    size_t aligned_size = (size + 7) & ~((size_t)7);
+    return alloc_aligned(allocator, size, allocator->options.alignment);
+}
+
+// Slow path of the inline fast path: same checks and growth as alloc()
+void *simple_memory_allocator_alloc_slow(SimpleMemoryAllocator *allocator, size_t size) {
+    return simple_memory_allocator_alloc(allocator, size);
+}
 
-    if (allocator->used + aligned_size > allocator->size) {
-        return NULL;  // Not enough space
+// Allocate zeroed memory for `count` objects of `size` bytes
+// Only the part below the block's dirty mark is cleared; the rest is known zero
+// Returns NULL on overflow or if there is not enough space
+void *simple_memory_allocator_calloc(SimpleMemoryAllocator *allocator, size_t count, size_t size) {
+    if (allocator == NULL || allocator->memory == NULL || count == 0 || size == 0 || count > SIZE_MAX / size) {
+        return NULL;
     }
 
-    void *ptr = (uint8_t *)allocator->memory + allocator->used;
-    allocator->used += aligned_size;
+    size_t total = count * size;
+    uint8_t *ptr = alloc_aligned(allocator, total, allocator->options.alignment);
+    if (ptr == NULL) {
+        return NULL;
+    }
 
+    // Bytes past the old bump position were never handed out since the mark was set
+    size_t offset = (size_t)(ptr - (uint8_t *)allocator->memory);
+    size_t dirty = allocator->block->dirty;
+    if (dirty > offset) {
+        memory_zero(ptr, dirty - offset < total ? dirty - offset : total);
+    }
     return ptr;
 }
 
+// Allocate memory whose address is a multiple of `alignment`
+// Returns NULL if alignment is not a power of two or there is not enough space
+void *simple_memory_allocator_alloc_aligned(SimpleMemoryAllocator *allocator, size_t size, size_t alignment) {
+    if (allocator == NULL || allocator->memory == NULL || size == 0 || !is_power_of_two(alignment)) {
+        return NULL;
+    }
+
+    if (alignment < SIMPLE_MEMORY_ALLOCATOR_DEFAULT_ALIGNMENT) {
+        alignment = SIMPLE_MEMORY_ALLOCATOR_DEFAULT_ALIGNMENT;
+    }
+
+    return alloc_aligned(allocator, size, alignment);
+}
+
+// Allocate `count` objects of `size` bytes back to back with one capacity check
+// Returns count with out[] filled, or 0 (nothing allocated) if they do not fit
+size_t simple_memory_allocator_alloc_batch(SimpleMemoryAllocator *allocator, size_t size, size_t count, void **out) {
+    if (allocator == NULL || allocator->memory == NULL || size == 0 || count == 0 || out == NULL) {
+        return 0;
+    }
+
+    // Same layout as a loop of alloc(): every start stays aligned, and the
+    // last object ends at its 8-byte granule so realloc() can still find it
+    size_t alignment = allocator->options.alignment;
+    size_t stride = (size + GUARD_RED_ZONE + alignment - 1) & ~(alignment - 1);
+    size_t last = ((size + 7) & ~(size_t)7) + GUARD_RED_ZONE;
+    if (stride < size || last < size || count - 1 > (SIZE_MAX - last) / stride) {
+        return 0;
+    }
+    size_t total = stride * (count - 1) + last;
+
+    size_t offset = reserve(allocator, total, alignment);
+    if (offset == SIZE_MAX) {
+        return 0;
+    }
+
+    uint8_t *cursor = (uint8_t *)allocator->memory + offset;
+    for (size_t i = 0; i < count; i++) {
+        size_t span = i + 1 < count ? stride : last;
+        out[i] = cursor + i * stride;
+        STATS_ALLOC(allocator, size, i == 0 ? offset + span - allocator->used : span);
+        GUARD_OBJECT(allocator, out[i], size, span);
+        (void)span;  // Only the stats and guard builds use it
+    }
+    allocator->used = offset + total;
+
+    return count;
+}
+
+// Allocate one object per entry of sizes[] with one capacity check
+// Returns count with out[] filled, or 0 (nothing allocated) if they do not fit
+size_t simple_memory_allocator_alloc_batch_sizes(SimpleMemoryAllocator *allocator, const size_t *sizes, size_t count,
+                                                 void **out) {
+    if (allocator == NULL || allocator->memory == NULL || sizes == NULL || count == 0 || out == NULL) {
+        return 0;
+    }
+
+    // Each object keeps its own start aligned, so the total includes that
+    // padding; the last one ends at its 8-byte granule, as with alloc()
+    size_t alignment = allocator->options.alignment;
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        size_t span = i + 1 < count ? (sizes[i] + GUARD_RED_ZONE + alignment - 1) & ~(alignment - 1)
+                                    : ((sizes[i] + 7) & ~(size_t)7) + GUARD_RED_ZONE;
+        if (sizes[i] == 0 || span < sizes[i] || span > SIZE_MAX - total) {
+            return 0;
+        }
+        total += span;
+    }
+
+    size_t offset = reserve(allocator, total, alignment);
+    if (offset == SIZE_MAX) {
+        return 0;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        size_t span = i + 1 < count ? (sizes[i] + GUARD_RED_ZONE + alignment - 1) & ~(alignment - 1)
+                                    : ((sizes[i] + 7) & ~(size_t)7) + GUARD_RED_ZONE;
+        out[i] = (uint8_t *)allocator->memory + offset;
+        STATS_ALLOC(allocator, sizes[i], offset + span - allocator->used);
+        allocator->used = offset + span;
+        GUARD_OBJECT(allocator, out[i], sizes[i], span);
+        offset += span;
+    }
+
+    return count;
+}
+
+// Offset of ptr in the current block if it is the most recent allocation of
+// `old_size` bytes, or SIZE_MAX otherwise
+static inline size_t last_allocation_offset(const SimpleMemoryAllocator *allocator, const void *ptr,
+                                            size_t old_size) {
+    uintptr_t start = (uintptr_t)allocator->memory;
+    uintptr_t address = (uintptr_t)ptr;
+    size_t aligned_old = ((old_size + 7) & ~((size_t)7)) + GUARD_RED_ZONE;
+
+    if (address < start || address - start > allocator->used || aligned_old < old_size) {
+        return SIZE_MAX;
+    }
+    size_t offset = (size_t)(address - start);
+    return allocator->used - offset == aligned_old ? offset : SIZE_MAX;
+}
+
+// Resize in place when ptr is the last allocation and the block has room,
+// otherwise copy into a fresh allocation
+// Returns the (possibly moved) pointer, or NULL on failure with ptr untouched
+void *simple_memory_allocator_realloc(SimpleMemoryAllocator *allocator, void *ptr, size_t old_size, size_t new_size) {
+    if (ptr == NULL) {
+        return simple_memory_allocator_alloc(allocator, new_size);
+    }
+    if (allocator == NULL || allocator->memory == NULL || new_size == 0) {
+        return NULL;
+    }
+
+    size_t aligned_new = ((new_size + 7) & ~((size_t)7)) + GUARD_RED_ZONE;
+    if (aligned_new < new_size) {
+        return NULL;
+    }
+
+    size_t offset = last_allocation_offset(allocator, ptr, old_size);
+    if (offset != SIZE_MAX && aligned_new <= allocator->size - offset) {
+        mark_dirty(allocator->block, allocator->used);  // A shrink leaves written bytes past the bump
+        STATS_RESIZE(allocator, allocator->used - offset, aligned_new);
+        allocator->used = offset + aligned_new;
+        GUARD_OBJECT(allocator, ptr, new_size, aligned_new);
+        return ptr;
+    }
+    if (new_size <= old_size) {
+        return ptr;  // Buried allocation: shrinking cannot give anything back
+    }
+
+    void *moved = simple_memory_allocator_alloc(allocator, new_size);
+    if (moved != NULL) {
+        memcpy(moved, ptr, old_size);
+    }
+    return moved;
+}
+
+// Give back the tail of the most recent allocation
+// Returns 0 on success, -1 if ptr is not the last allocation
+int simple_memory_allocator_shrink_last(SimpleMemoryAllocator *allocator, void *ptr, size_t old_size, size_t new_size) {
+    if (allocator == NULL || allocator->memory == NULL || ptr == NULL || new_size > old_size) {
+        return -1;
+    }
+
+    size_t offset = last_allocation_offset(allocator, ptr, old_size);
+    if (offset == SIZE_MAX) {
+        return -1;
+    }
+
+    size_t aligned_new = ((new_size + 7) & ~((size_t)7)) + GUARD_RED_ZONE;
+    mark_dirty(allocator->block, allocator->used);
+    STATS_RESIZE(allocator, allocator->used - offset, aligned_new);
+    allocator->used = offset + aligned_new;
+    GUARD_OBJECT(allocator, ptr, new_size, aligned_new);
+    return 0;
+}
+
+// Release every block but the largest and make it current and empty
+// Returns the surviving block, with its touched extent folded into resident
+static struct SimpleMemoryBlock *reset_blocks(SimpleMemoryAllocator *allocator) {
+    GUARD_CHECK_LAST(allocator);
+    struct SimpleMemoryBlock *largest = allocator->block;
+    for (struct SimpleMemoryBlock *b = allocator->block->prev; b != NULL; b = b->prev) {
+        if (b->size > largest->size) {
+            largest = b;
+        }
+    }
+    // A spare's bump position is not kept up to date, so assume all of it
+    size_t touched = largest == allocator->block ? allocator->used : largest->used;
+    int kept_spare = 0;
+    if (allocator->spare != NULL) {
+        if (allocator->spare->size > largest->size) {
+            largest = allocator->spare;
+            touched = largest->size;
+            kept_spare = 1;
+        } else {
+            block_release(allocator->spare, &allocator->options);
+        }
+        allocator->spare = NULL;
+    }
+    if (touched > largest->resident) {
+        largest->resident = touched;
+    }
+    mark_dirty(largest, touched);
+    if (!kept_spare) {
+        GUARD_DEAD(block_memory(largest), touched);  // A spare was already poisoned by its rewind
+    }
+
+    struct SimpleMemoryBlock *block = allocator->block;
+    while (block != NULL) {
+        struct SimpleMemoryBlock *prev = block->prev;
+        if (block != largest) {
+            block_release(block, &allocator->options);
+        }
+        block = prev;
+    }
+
+    largest->prev = NULL;
+    largest->used = 0;
+    use_block(allocator, largest);
+    return largest;
+}
+
 // Reset allocator - keeps the pool but marks all memory as free
+// With chained blocks only the largest one survives, so the retained
+// footprint tracks the peak demand instead of the initial guess
 void simple_memory_allocator_reset(SimpleMemoryAllocator *allocator) {
-    if (allocator != NULL) {
+    if (allocator == NULL) {
+        return;
+    }
+    STATS_RESET(allocator);
+    if (allocator->block == NULL) {
         allocator->used = 0;
+        return;
     }
+    reset_blocks(allocator);
+}
+
+// Reset and hand the cold tail of an mmap-backed block back to the kernel
+// The hot prefix is a decaying average of recent per-reset peaks, so one
+// outsized cycle is released while the steady working set stays resident
+// Returns the number of bytes decommitted
+size_t simple_memory_allocator_reset_decommit(SimpleMemoryAllocator *allocator,
+                                              const SimpleMemoryDecommitPolicy *policy) {
+    if (allocator == NULL) {
+        return 0;
+    }
+    if (allocator->block == NULL) {
+        simple_memory_allocator_reset(allocator);
+        return 0;
+    }
+
+    size_t window = SIMPLE_MEMORY_DECOMMIT_DEFAULT_WINDOW;
+    size_t min_resident = 0;
+    int lazy = 0;
+    if (policy != NULL) {
+        window = policy->window != 0 ? policy->window : window;
+        min_resident = policy->min_resident;
+        lazy = policy->lazy;
+    }
+
+    // Fold this cycle's peak into the average (window 1 = last peak only)
+    size_t peak = simple_memory_allocator_bytes_used(allocator);
+    size_t average = allocator->decommit_average;
+    if (average == 0) {
+        average = peak;  // First sample seeds the average
+    } else if (peak >= average) {
+        average += (peak - average + window - 1) / window;
+    } else {
+        average -= (average - peak) / window;
+    }
+    allocator->decommit_average = average;
+
+    STATS_RESET(allocator);
+    struct SimpleMemoryBlock *block = reset_blocks(allocator);
+    if (block->mapped_length == 0) {
+        return 0;
+    }
+
+    size_t hot = average > min_resident ? average : min_resident;
+    if (hot >= block->resident) {
+        return 0;
+    }
+
+    // Decommit whole pages from the first page boundary past the hot prefix
+    size_t page_size = map_page_size(&allocator->options);
+    uintptr_t base = (uintptr_t)block_memory(block);
+    uintptr_t start = (base + hot + page_size - 1) & ~((uintptr_t)page_size - 1);
+    uintptr_t end = (base + block->resident + page_size - 1) & ~((uintptr_t)page_size - 1);
+    uintptr_t mapping_end = (uintptr_t)block + block->mapped_length;
+    if (end > mapping_end) {
+        end = mapping_end;
+    }
+    if (start >= end) {
+        return 0;
+    }
+
+    int advice = MADV_DONTNEED;
+#ifdef MADV_FREE
+    if (lazy) {
+        advice = MADV_FREE;
+    }
+#else
+    (void)lazy;
+#endif
+    if (madvise((void *)start, end - start, advice) != 0) {
+        return 0;
+    }
+    block->resident = start - base;
+    // MADV_DONTNEED refaults as zero pages; MADV_FREE may keep the old contents
+    if (advice == MADV_DONTNEED && block->dirty <= end - base && block->dirty > start - base) {
+        block->dirty = start - base;
+    }
+
+    return end - start;
+}
+
+// Capture the current bump position
+SimpleMemoryMarker simple_memory_allocator_get_marker(const SimpleMemoryAllocator *allocator) {
+    SimpleMemoryMarker marker = {NULL, 0};
+    if (allocator != NULL) {
+        marker.block = allocator->block;
+        marker.used = allocator->used;
+    }
+    return marker;
+}
+
+// Roll back to `marker`, releasing blocks chained after it but keeping the
+// largest of them (or the existing spare) warm for the next growth
+// Returns 0 on success, -1 if the marker is not reachable from the current block
+int simple_memory_allocator_free_to_marker(SimpleMemoryAllocator *allocator, SimpleMemoryMarker marker) {
+    if (allocator == NULL || marker.block == NULL) {
+        return -1;
+    }
+
+    // Validate before touching anything: the marker's block must be in the
+    // chain and the marker must not lie ahead of that block's bump position
+    size_t released_bytes = 0;
+    struct SimpleMemoryBlock *b = allocator->block;
+    size_t b_used = allocator->used;
+    while (b != NULL && b != marker.block) {
+        released_bytes += b_used;
+        b = b->prev;
+        b_used = b != NULL ? b->used : 0;
+    }
+    if (b == NULL || marker.used > b_used) {
+        return -1;
+    }
+    released_bytes += b_used - marker.used;
+    GUARD_CHECK_LAST(allocator);
+
+    struct SimpleMemoryBlock *block = allocator->block;
+    while (block != marker.block) {
+        struct SimpleMemoryBlock *prev = block->prev;
+        if (allocator->spare == NULL || block->size > allocator->spare->size) {
+            if (allocator->spare != NULL) {
+                block_release(allocator->spare, &allocator->options);
+            }
+            size_t block_used = block == allocator->block ? allocator->used : block->used;
+            mark_dirty(block, block_used);
+            GUARD_DEAD(block_memory(block), block_used);
+            block->prev = NULL;
+            allocator->spare = block;
+        } else {
+            block_release(block, &allocator->options);
+        }
+        block = prev;
+    }
+
+    // Pages past the marker stay resident until a decommit
+    size_t touched = marker.block == allocator->block ? allocator->used : marker.block->used;
+    if (touched > marker.block->resident) {
+        marker.block->resident = touched;
+    }
+    mark_dirty(marker.block, touched);
+    GUARD_DEAD((uint8_t *)block_memory(marker.block) + marker.used, touched - marker.used);
+    marker.block->used = marker.used;
+    use_block(allocator, marker.block);
+#ifdef SIMPLE_MEMORY_ALLOCATOR_STATS
+    allocator->stats.current_bytes -= released_bytes;
+#else
+    (void)released_bytes;
+#endif
+
+    return 0;
 }
 
 // Destroy allocator and free the memory pool
 void simple_memory_allocator_destroy(SimpleMemoryAllocator *allocator) {
     if (allocator != NULL) {
-        free(allocator->memory);
+        GUARD_CHECK_LAST(allocator);
+        // Newest first, so a parent arena can take each block back in turn
+        if (allocator->spare != NULL) {
+            block_release(allocator->spare, &allocator->options);
+        }
+        struct SimpleMemoryBlock *block = allocator->block;
+        while (block != NULL) {
+            struct SimpleMemoryBlock *prev = block->prev;
+            block_release(block, &allocator->options);
+            block = prev;
+        }
         allocator->memory = NULL;
         allocator->size = 0;
         allocator->used = 0;
+        allocator->block = NULL;
+        allocator->spare = NULL;
+    }
+}
+
+// Number of blocks currently owned by the allocator
+size_t simple_memory_allocator_block_count(const SimpleMemoryAllocator *allocator) {
+    size_t count = 0;
+    if (allocator != NULL) {
+        for (const struct SimpleMemoryBlock *b = allocator->block; b != NULL; b = b->prev) {
+            count++;
+        }
+        count += allocator->spare != NULL;
+    }
+    return count;
+}
+
+// Total bytes reserved across all blocks
+size_t simple_memory_allocator_capacity(const SimpleMemoryAllocator *allocator) {
+    size_t total = 0;
+    if (allocator != NULL) {
+        for (const struct SimpleMemoryBlock *b = allocator->block; b != NULL; b = b->prev) {
+            total += b->size;
+        }
+        if (allocator->spare != NULL) {
+            total += allocator->spare->size;
+        }
+    }
+    return total;
+}
+
+// Bytes in use: the live bump position plus what each retired block held
+size_t simple_memory_allocator_bytes_used(const SimpleMemoryAllocator *allocator) {
+    size_t total = 0;
+    if (allocator != NULL && allocator->block != NULL) {
+        total = allocator->used;
+        for (const struct SimpleMemoryBlock *b = allocator->block->prev; b != NULL; b = b->prev) {
+            total += b->used;
+        }
+    }
+    return total;
+}
+
+// Copy the counters into `out`
+// Returns 0 if statistics are enabled, -1 if compiled out (out is zeroed)
+int simple_memory_allocator_get_stats(const SimpleMemoryAllocator *allocator, SimpleMemoryAllocatorStats *out) {
+    if (out == NULL) {
+        return -1;
+    }
+#ifdef SIMPLE_MEMORY_ALLOCATOR_STATS
+    if (allocator != NULL) {
+        *out = allocator->stats;
+        return 0;
+    }
+#else
+    (void)allocator;
+#endif
+    memset(out, 0, sizeof(*out));
+    return -1;
+}
+
+// Clear the counters; high_water restarts from what is currently handed out
+void simple_memory_allocator_reset_stats(SimpleMemoryAllocator *allocator) {
+#ifdef SIMPLE_MEMORY_ALLOCATOR_STATS
+    if (allocator != NULL) {
+        size_t current = allocator->stats.current_bytes;
+        memset(&allocator->stats, 0, sizeof(allocator->stats));
+        allocator->stats.current_bytes = current;
+        allocator->stats.high_water = current;
     }
+#else
+    (void)allocator;
+#endif
+}
+
+// Write a snapshot as a single JSON object for metrics scrapers
+// Returns the length snprintf would produce (truncated if >= buf_size), or -1
+int simple_memory_allocator_stats_json(const SimpleMemoryAllocatorStats *stats, char *buf, size_t buf_size) {
+    if (stats == NULL || (buf == NULL && buf_size != 0)) {
+        return -1;
+    }
+
+    char buckets[2][SIMPLE_MEMORY_STATS_BUCKETS * 24];
+    const size_t *values[2] = {stats->bucket_allocs, stats->bucket_bytes};
+    for (int k = 0; k < 2; k++) {
+        size_t pos = 0;
+        for (size_t i = 0; i < SIMPLE_MEMORY_STATS_BUCKETS; i++) {
+            pos += (size_t)snprintf(buckets[k] + pos, sizeof(buckets[k]) - pos, "%s%zu", i ? "," : "", values[k][i]);
+        }
+    }
+
+    return snprintf(buf, buf_size,
+                    "{\"alloc_calls\":%zu,\"failed_allocs\":%zu,\"bytes_requested\":%zu,"
+                    "\"padding_bytes\":%zu,\"current_bytes\":%zu,\"high_water\":%zu,\"resets\":%zu,"
+                    "\"blocks_chained\":%zu,\"bucket_allocs\":[%s],\"bucket_bytes\":[%s]}",
+                    stats->alloc_calls, stats->failed_allocs, stats->bytes_requested, stats->padding_bytes,
+                    stats->current_bytes, stats->high_water, stats->resets, stats->blocks_chained,
+                    buckets[0], buckets[1]);
 }
 
 // Print allocator status with formatted output
@@ -99,6 +1059,10 @@ void simple_memory_allocator_print_status(const SimpleMemoryAllocator *allocator
     printf("│ Total Size:   %10zu bytes     │\n", allocator->size);
     printf("│ Used:         %10zu bytes     │\n", allocator->used);
     printf("│ Free:         %10zu bytes     │\n", free_bytes);
+    if (allocator->options.growable) {
+        printf("│ Blocks:       %10zu           │\n", simple_memory_allocator_block_count(allocator));
+        printf("│ Capacity:     %10zu bytes     │\n", simple_memory_allocator_capacity(allocator));
+    }
     printf("├────────────────────────────────────┤\n");
     printf("│ Usage: [");
 
@@ -2,29 +2,224 @@
 #define SIMPLE_MEMORY_ALLOCATOR_H
 
 #include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Pool block header (defined in simple_memory_allocator.c)
+struct SimpleMemoryBlock;
+
+// Default growth factor for growable allocators
+#define SIMPLE_MEMORY_ALLOCATOR_DEFAULT_GROWTH_FACTOR 2
+
+// Default (and minimum) allocation alignment
+#define SIMPLE_MEMORY_ALLOCATOR_DEFAULT_ALIGNMENT 8
+
+// Where pool blocks come from
+typedef enum {
+    SIMPLE_MEMORY_BACKING_MALLOC = 0,    // malloc() (default)
+    SIMPLE_MEMORY_BACKING_MMAP,          // Anonymous mmap() honoring map_flags
+    SIMPLE_MEMORY_BACKING_PARENT_ARENA,  // Carved from the SimpleMemoryAllocator in parent
+    SIMPLE_MEMORY_BACKING_PARENT_POOL    // One block of the PoolAllocator in parent per arena block
+} SimpleMemoryBacking;
+
+// mmap backing flags
+#define SIMPLE_MEMORY_MAP_HUGETLB                (1u << 0)  // MAP_HUGETLB, falls back to regular pages
+#define SIMPLE_MEMORY_MAP_TRANSPARENT_HUGE_PAGES (1u << 1)  // madvise(MADV_HUGEPAGE)
+#define SIMPLE_MEMORY_MAP_POPULATE               (1u << 2)  // Pre-fault every page at creation
+#define SIMPLE_MEMORY_MAP_NUMA_BIND              (1u << 3)  // Bind pages to numa_node
+
+// Creation options (zero-initialize for defaults)
+typedef struct {
+    int growable;           // Chain a new block instead of failing when the pool is full
+    size_t growth_factor;   // Next block = current block size * factor (0 = default)
+    size_t max_block_size;  // Cap for chained block sizes (0 = no cap)
+    size_t alignment;       // Default alignment for alloc(), power of two (0 = default)
+    SimpleMemoryBacking backing;
+    unsigned map_flags;     // SIMPLE_MEMORY_MAP_* (mmap backing only)
+    int numa_node;          // Node for SIMPLE_MEMORY_MAP_NUMA_BIND
+    void *parent;           // Arena or pool for the PARENT_* backings; must outlive the child
+} SimpleMemoryAllocatorOptions;
+
+// Red zone after every allocation when built with -DSIMPLE_MEMORY_ALLOCATOR_GUARD
+// (like the statistics flag it changes the struct layout, so every translation
+// unit must agree on it). Guard mode also poisons the unused tail and reset
+// memory: through ASan's manual-poisoning interface under -fsanitize=address,
+// with byte patterns verified by the allocator otherwise
+#define SIMPLE_MEMORY_GUARD_RED_ZONE 16
+
+// Request-size buckets for statistics: <=16, <=64, <=256, ... (powers of 4), >64K
+#define SIMPLE_MEMORY_STATS_BUCKETS 8
+
+// Counters collected when built with -DSIMPLE_MEMORY_ALLOCATOR_STATS
+// (every translation unit must agree on the flag, it changes the struct layout)
+typedef struct {
+    size_t alloc_calls;       // Successful and failed allocations
+    size_t failed_allocs;     // Allocations that returned NULL for lack of space
+    size_t bytes_requested;   // Sum of requested sizes
+    size_t padding_bytes;     // Bytes lost to alignment gaps and 8-byte rounding
+    size_t current_bytes;     // Bytes handed out since the last reset, padding included
+    size_t high_water;        // Largest current_bytes seen
+    size_t resets;
+    size_t blocks_chained;    // Blocks added by growable mode
+    size_t bucket_allocs[SIMPLE_MEMORY_STATS_BUCKETS];
+    size_t bucket_bytes[SIMPLE_MEMORY_STATS_BUCKETS];
+} SimpleMemoryAllocatorStats;
 
 typedef struct {
     void *memory;
     size_t size;
     size_t used;
+    struct SimpleMemoryBlock *block;  // Header of the current block, chains to older blocks
+    struct SimpleMemoryBlock *spare;  // Largest block released by a rewind, reused by the next growth
+    size_t decommit_average;          // Decaying average of per-reset peaks (reset_decommit)
+    SimpleMemoryAllocatorOptions options;
+#ifdef SIMPLE_MEMORY_ALLOCATOR_STATS
+    SimpleMemoryAllocatorStats stats;
+#endif
+#ifdef SIMPLE_MEMORY_ALLOCATOR_GUARD
+    unsigned char *guard_zone;  // Red zone of the most recent allocation, checked by the next one
+    size_t guard_length;
+#endif
 } SimpleMemoryAllocator;
 
+// Resets averaged into the hot prefix when the policy leaves window at 0
+#define SIMPLE_MEMORY_DECOMMIT_DEFAULT_WINDOW 8
+
+// Decommit policy for simple_memory_allocator_reset_decommit (NULL = defaults)
+typedef struct {
+    size_t window;        // Peaks decay over roughly this many resets (0 = default)
+    size_t min_resident;  // Hot prefix never shrinks below this many bytes
+    int lazy;             // MADV_FREE (reclaimed under pressure) instead of MADV_DONTNEED
+} SimpleMemoryDecommitPolicy;
+
+// Checkpoint of the bump position (see simple_memory_allocator_get_marker)
+typedef struct {
+    struct SimpleMemoryBlock *block;
+    size_t used;
+} SimpleMemoryMarker;
+
 // Initialize allocator struct to zero state
 void simple_memory_allocator_init(SimpleMemoryAllocator *allocator);
 
 // Create allocator with a memory pool of given size
 int simple_memory_allocator_create(SimpleMemoryAllocator *allocator, size_t pool_size);
 
+// Create allocator with explicit options (NULL options = same as create)
+// With a PARENT_* backing the arena is a child: its blocks, including the ones
+// growth chains, come from the parent and go back on reset and destroy. A
+// parent arena reclaims a block at once only if it is still the parent's last
+// allocation, otherwise at the parent's next reset (which the children must
+// not outlive). A parent pool needs 16-byte multiple block sizes; every child
+// block fills one pool block, so pool_size is rounded up to that and growth
+// cannot exceed it. Neither parent kind is thread-safe
+int simple_memory_allocator_create_with_options(SimpleMemoryAllocator *allocator, size_t pool_size,
+                                                const SimpleMemoryAllocatorOptions *options);
+
 // Allocate memory from the pool (returns NULL if not enough space)
 void *simple_memory_allocator_alloc(SimpleMemoryAllocator *allocator, size_t size);
 
+// Out-of-line path behind simple_memory_allocator_alloc_fast: growth and failure
+void *simple_memory_allocator_alloc_slow(SimpleMemoryAllocator *allocator, size_t size);
+
+// Inlinable alloc() for hot paths that don't rely on LTO. The allocator must
+// have been created successfully; the NULL checks happen once at create time
+// instead of on every call. Same result as simple_memory_allocator_alloc()
+static inline void *simple_memory_allocator_alloc_fast(SimpleMemoryAllocator *allocator, size_t size) {
+#if defined(SIMPLE_MEMORY_ALLOCATOR_STATS) || defined(SIMPLE_MEMORY_ALLOCATOR_GUARD)
+    return simple_memory_allocator_alloc_slow(allocator, size);  // Counters and red zones live out of line
+#else
+    uintptr_t base = (uintptr_t)allocator->memory;
+    uintptr_t mask = allocator->options.alignment - 1;
+    size_t offset = (size_t)(((base + allocator->used + mask) & ~mask) - base);
+    size_t aligned_size = (size + 7) & ~(size_t)7;
+
+    // aligned_size - 1 wraps for size 0 and for sizes that overflow rounding
+    if (offset <= allocator->size && aligned_size - 1 < allocator->size - offset) {
+        allocator->used = offset + aligned_size;
+        return (void *)(base + offset);
+    }
+
+    return simple_memory_allocator_alloc_slow(allocator, size);
+#endif
+}
+
+// Allocate count * size zeroed bytes at the default alignment (NULL on overflow)
+// Memory the block never handed out is not cleared again: on mmap backing a
+// fresh block is already zero, and after a reset only the recycled prefix is
+void *simple_memory_allocator_calloc(SimpleMemoryAllocator *allocator, size_t count, size_t size);
+
+// Allocate memory aligned to `alignment` (any power of two)
+void *simple_memory_allocator_alloc_aligned(SimpleMemoryAllocator *allocator, size_t size, size_t alignment);
+
+// Allocate `count` objects of `size` bytes with a single capacity check
+// Returns count with out[0..count) filled, or 0 if the batch does not fit
+size_t simple_memory_allocator_alloc_batch(SimpleMemoryAllocator *allocator, size_t size, size_t count, void **out);
+
+// Allocate one object per entry of sizes[] with a single capacity check
+// Returns count with out[0..count) filled, or 0 if the batch does not fit
+size_t simple_memory_allocator_alloc_batch_sizes(SimpleMemoryAllocator *allocator, const size_t *sizes, size_t count,
+                                                 void **out);
+
+// Resize an allocation of `old_size` bytes. The most recent allocation
+// grows or shrinks in place when the current block has room; anything else
+// is copied to a fresh allocation (the old copy stays until reset).
+// ptr == NULL behaves like alloc(). Returns NULL (ptr untouched) on failure
+void *simple_memory_allocator_realloc(SimpleMemoryAllocator *allocator, void *ptr, size_t old_size, size_t new_size);
+
+// Give back the tail of the most recent allocation
+// Returns 0 on success, -1 if ptr is not the last allocation or new_size > old_size
+int simple_memory_allocator_shrink_last(SimpleMemoryAllocator *allocator, void *ptr, size_t old_size, size_t new_size);
+
 // Reset allocator (keeps pool, resets used counter to 0)
+// Growable allocators keep only their largest block and release the rest
 void simple_memory_allocator_reset(SimpleMemoryAllocator *allocator);
 
+// Reset, then madvise away the part of an mmap-backed block beyond the hot
+// prefix (decaying average of recent peaks, at least policy->min_resident)
+// Returns bytes decommitted (0 for malloc backing or when nothing is cold)
+size_t simple_memory_allocator_reset_decommit(SimpleMemoryAllocator *allocator,
+                                              const SimpleMemoryDecommitPolicy *policy);
+
+// Capture the current bump position
+SimpleMemoryMarker simple_memory_allocator_get_marker(const SimpleMemoryAllocator *allocator);
+
+// Roll back every allocation made after `marker` (markers nest; rewinding to
+// an outer one discards inner ones). Blocks chained since the marker are
+// released except the largest, which is kept warm for the next growth.
+// Returns 0 on success, -1 if the marker does not belong to the current
+// chain (e.g. taken before a reset) or lies ahead of the bump position
+int simple_memory_allocator_free_to_marker(SimpleMemoryAllocator *allocator, SimpleMemoryMarker marker);
+
 // Destroy allocator and free the memory pool
 void simple_memory_allocator_destroy(SimpleMemoryAllocator *allocator);
 
+// Number of blocks currently owned by the allocator
+size_t simple_memory_allocator_block_count(const SimpleMemoryAllocator *allocator);
+
+// Total bytes reserved across all blocks
+size_t simple_memory_allocator_capacity(const SimpleMemoryAllocator *allocator);
+
+// Bytes handed out across the current and retired blocks, padding included
+size_t simple_memory_allocator_bytes_used(const SimpleMemoryAllocator *allocator);
+
+// Copy the counters into `out` (zeroed when statistics are compiled out)
+// Returns 0 if statistics are enabled, -1 otherwise
+int simple_memory_allocator_get_stats(const SimpleMemoryAllocator *allocator, SimpleMemoryAllocatorStats *out);
+
+// Clear the counters (high_water restarts from current_bytes)
+void simple_memory_allocator_reset_stats(SimpleMemoryAllocator *allocator);
+
+// Write a snapshot as one line of JSON; returns the length snprintf would produce
+int simple_memory_allocator_stats_json(const SimpleMemoryAllocatorStats *stats, char *buf, size_t buf_size);
+
 // Print allocator status with formatted output
 void simple_memory_allocator_print_status(const SimpleMemoryAllocator *allocator);
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif
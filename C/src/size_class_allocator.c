@@ -0,0 +1,111 @@
+/*
+ * Size class allocator
+ *
+ * One lazily threaded PoolAllocator per power-of-two size class, backed by
+ * a coalescing FreeListAllocator for everything above SIZE_CLASS_MAX_SIZE.
+ */
+
+#include "size_class_allocator.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+// Index of the smallest class that fits size (size must be <= SIZE_CLASS_MAX_SIZE)
+static inline size_t class_index(size_t size) {
+    if (size <= SIZE_CLASS_MIN_SIZE) {
+        return 0;
+    }
+    // ceil(log2(size)) - log2(SIZE_CLASS_MIN_SIZE)
+    return (size_t)(sizeof(unsigned long) * 8 - __builtin_clzl((unsigned long)(size - 1))) - 3;
+}
+
+// Initialize the allocator to zero state
+void size_class_allocator_init(SizeClassAllocator *allocator) {
+    for (size_t i = 0; i < SIZE_CLASS_COUNT; i++) {
+        pool_allocator_init(&allocator->classes[i]);
+    }
+    allocator->small_memory = NULL;
+    allocator->class_shift = 0;
+    freelist_init(&allocator->large, NULL, 0);
+    allocator->large_memory = NULL;
+}
+
+// Create allocator
+// Returns 0 on success, -1 on failure
+int size_class_allocator_create(SizeClassAllocator *allocator, size_t class_bytes, size_t large_bytes) {
+    if (allocator == NULL || class_bytes < SIZE_CLASS_MAX_SIZE || large_bytes < FREELIST_MIN_BLOCK + FREELIST_HEADER_SIZE) {
+        return -1;
+    }
+
+    size_class_allocator_init(allocator);
+
+    size_t shift = 0;
+    while (((size_t)1 << shift) < class_bytes) {
+        if (shift + 1 >= sizeof(size_t) * 8 - 4) {
+            return -1;  // Slab size would overflow
+        }
+        shift++;
+    }
+    size_t region = (size_t)1 << shift;
+
+    allocator->small_memory = malloc(region * SIZE_CLASS_COUNT);
+    allocator->large_memory = malloc(large_bytes);
+    if (allocator->small_memory == NULL || allocator->large_memory == NULL) {
+        free(allocator->small_memory);
+        free(allocator->large_memory);
+        size_class_allocator_init(allocator);
+        return -1;
+    }
+
+    allocator->class_shift = shift;
+    for (size_t i = 0; i < SIZE_CLASS_COUNT; i++) {
+        size_t block_size = (size_t)SIZE_CLASS_MIN_SIZE << i;
+        pool_allocator_create_from(&allocator->classes[i], allocator->small_memory + i * region,
+                                   block_size, region / block_size);
+    }
+    freelist_init(&allocator->large, allocator->large_memory, large_bytes);
+
+    return 0;
+}
+
+// Allocate size bytes
+// Returns pointer to allocated memory, or NULL if out of space
+void *size_class_allocator_alloc(SizeClassAllocator *allocator, size_t size) {
+    if (allocator == NULL || allocator->small_memory == NULL || size == 0) {
+        return NULL;
+    }
+
+    if (size <= SIZE_CLASS_MAX_SIZE) {
+        void *ptr = pool_allocator_alloc(&allocator->classes[class_index(size)]);
+        if (ptr != NULL) {
+            return ptr;
+        }
+    }
+
+    return freelist_alloc(&allocator->large, size);
+}
+
+// Free memory back to its class pool or to the backend
+void size_class_allocator_free(SizeClassAllocator *allocator, void *ptr) {
+    if (allocator == NULL || ptr == NULL) {
+        return;
+    }
+
+    uintptr_t offset = (uintptr_t)ptr - (uintptr_t)allocator->small_memory;
+    size_t index = (size_t)(offset >> allocator->class_shift);
+
+    // Pointers below the slab wrap around to a huge offset and fail this test too
+    if (index < SIZE_CLASS_COUNT) {
+        pool_allocator_free(&allocator->classes[index], ptr);
+    } else {
+        freelist_free(&allocator->large, ptr);
+    }
+}
+
+// Destroy allocator and free all memory
+void size_class_allocator_destroy(SizeClassAllocator *allocator) {
+    if (allocator != NULL) {
+        free(allocator->small_memory);
+        free(allocator->large_memory);
+        size_class_allocator_init(allocator);
+    }
+}
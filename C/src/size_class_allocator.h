@@ -0,0 +1,45 @@
+#ifndef SIZE_CLASS_ALLOCATOR_H
+#define SIZE_CLASS_ALLOCATOR_H
+
+#include <stddef.h>
+#include "pool_allocator.h"
+#include "freelist_allocator.h"
+
+// Power-of-two size classes 8, 16, 32 ... 2048
+#define SIZE_CLASS_MIN_SIZE 8
+#define SIZE_CLASS_MAX_SIZE 2048
+#define SIZE_CLASS_COUNT    9
+
+/*
+ * Segregated-fit allocator. Small requests are rounded up to a size class
+ * and served by that class's PoolAllocator in O(1); larger requests, and
+ * small ones whose class is exhausted, go to a coalescing free list.
+ *
+ * All class pools are carved from one slab with a power-of-two region per
+ * class, so free() finds the owning class with a subtract and a shift.
+ */
+typedef struct {
+    PoolAllocator classes[SIZE_CLASS_COUNT];
+    unsigned char *small_memory;  // Slab holding every class region
+    size_t class_shift;           // log2 of the bytes reserved per class
+    FreeListAllocator large;
+    void *large_memory;
+} SizeClassAllocator;
+
+// Initialize allocator struct to zero state
+void size_class_allocator_init(SizeClassAllocator *allocator);
+
+// Create allocator with class_bytes per size class (rounded up to a power
+// of two) and a large_bytes region for the free-list backend
+int size_class_allocator_create(SizeClassAllocator *allocator, size_t class_bytes, size_t large_bytes);
+
+// Allocate size bytes (returns NULL if neither the class nor the backend has space)
+void *size_class_allocator_alloc(SizeClassAllocator *allocator, size_t size);
+
+// Free memory returned by size_class_allocator_alloc (NULL is ignored)
+void size_class_allocator_free(SizeClassAllocator *allocator, void *ptr);
+
+// Destroy allocator and free all memory
+void size_class_allocator_destroy(SizeClassAllocator *allocator);
+
+#endif
@@ -0,0 +1,236 @@
+/*
+ * Generational slot map
+ *
+ * Typed-handle layer over the pool allocator. Objects live in the pool's
+ * blocks and are kept packed at the front: removal swaps the last object
+ * into the hole and frees the last block, and because the pool's free list
+ * is LIFO the next allocation hands that same block back. Slots are taken
+ * lazily from a high-water index like the pool's blocks, so creating a map
+ * touches neither the object storage nor the slot table.
+ */
+
+#include "slot_map.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define SLOT_MAP_INDEX_MASK      ((uint32_t)SLOT_MAP_MAX_CAPACITY - 1)
+#define SLOT_MAP_GENERATION_MASK ((1u << SLOT_MAP_GENERATION_BITS) - 1)
+#define SLOT_MAP_NO_SLOT         UINT32_MAX
+
+static SlotMapHandle make_handle(uint32_t index, uint32_t generation) {
+    return (generation << SLOT_MAP_INDEX_BITS) | index;
+}
+
+// Generation 0 is skipped so that SLOT_MAP_NULL_HANDLE never matches
+static uint32_t next_generation(uint32_t generation) {
+    generation = (generation + 1) & SLOT_MAP_GENERATION_MASK;
+    return generation != 0 ? generation : 1;
+}
+
+static unsigned char *object_at(const SlotMap *map, size_t dense) {
+    return map->objects.memory + dense * map->objects.block_size;
+}
+
+// Slot index for a live handle, or SLOT_MAP_NO_SLOT if stale or invalid
+static uint32_t find_slot(const SlotMap *map, SlotMapHandle handle) {
+    uint32_t index = handle & SLOT_MAP_INDEX_MASK;
+    if (map == NULL || index >= map->next_unused) {
+        return SLOT_MAP_NO_SLOT;
+    }
+
+    const SlotMapSlot *slot = &map->slots[index];
+    if (slot->generation != handle >> SLOT_MAP_INDEX_BITS || slot->dense >= map->count ||
+        map->dense_to_slot[slot->dense] != index) {
+        return SLOT_MAP_NO_SLOT;
+    }
+    return index;
+}
+
+// Initialize the map to zero state
+void slot_map_init(SlotMap *map) {
+    pool_allocator_init(&map->objects);
+    map->slots = NULL;
+    map->dense_to_slot = NULL;
+    map->element_size = 0;
+    map->capacity = 0;
+    map->count = 0;
+    map->next_unused = 0;
+    map->free_head = 0;
+    map->destroy = NULL;
+}
+
+// Create map with room for capacity objects
+// Returns 0 on success, -1 on failure
+int slot_map_create(SlotMap *map, size_t element_size, size_t capacity, SlotMapDestructor destroy) {
+    if (map == NULL || element_size == 0 || capacity == 0 || capacity > SLOT_MAP_MAX_CAPACITY) {
+        return -1;
+    }
+
+    slot_map_init(map);
+    if (pool_allocator_create(&map->objects, element_size, capacity) != 0) {
+        return -1;
+    }
+
+    map->slots = malloc(capacity * sizeof(*map->slots));
+    map->dense_to_slot = malloc(capacity * sizeof(*map->dense_to_slot));
+    if (map->slots == NULL || map->dense_to_slot == NULL) {
+        slot_map_destroy(map);
+        return -1;
+    }
+
+    map->element_size = element_size;
+    map->capacity = capacity;
+    map->free_head = (uint32_t)capacity;
+    map->destroy = destroy;
+
+    return 0;
+}
+
+// Reserve storage for a new object
+// Returns the storage (handle written to *handle), or NULL when full
+void *slot_map_emplace(SlotMap *map, SlotMapHandle *handle) {
+    if (map == NULL || handle == NULL || map->count == map->capacity) {
+        return NULL;
+    }
+
+    // Packed storage means the pool hands out block `count` next
+    void *object = pool_allocator_alloc(&map->objects);
+    if (object != object_at(map, map->count)) {
+        return NULL;
+    }
+
+    uint32_t index;
+    if (map->free_head != map->capacity) {
+        index = map->free_head;
+        map->free_head = map->slots[index].dense;
+    } else {
+        index = (uint32_t)map->next_unused++;
+        map->slots[index].generation = 1;
+    }
+
+    map->slots[index].dense = (uint32_t)map->count;
+    map->dense_to_slot[map->count] = index;
+    map->count++;
+
+    *handle = make_handle(index, map->slots[index].generation);
+    return object;
+}
+
+// Insert a copy of value
+// Returns its handle, or SLOT_MAP_NULL_HANDLE when full
+SlotMapHandle slot_map_insert(SlotMap *map, const void *value) {
+    SlotMapHandle handle;
+    void *object = slot_map_emplace(map, &handle);
+    if (object == NULL) {
+        return SLOT_MAP_NULL_HANDLE;
+    }
+    memcpy(object, value, map->element_size);
+    return handle;
+}
+
+// Look up a handle in O(1)
+// Returns the object, or NULL if the handle is stale or invalid
+void *slot_map_get(const SlotMap *map, SlotMapHandle handle) {
+    uint32_t index = find_slot(map, handle);
+    if (index == SLOT_MAP_NO_SLOT) {
+        return NULL;
+    }
+    return object_at(map, map->slots[index].dense);
+}
+
+// Check whether handle refers to a live object
+int slot_map_contains(const SlotMap *map, SlotMapHandle handle) {
+    return slot_map_get(map, handle) != NULL;
+}
+
+// Remove the object behind handle
+// Returns 0 on success, -1 if the handle is stale or invalid
+int slot_map_remove(SlotMap *map, SlotMapHandle handle) {
+    uint32_t index = find_slot(map, handle);
+    if (index == SLOT_MAP_NO_SLOT) {
+        return -1;
+    }
+
+    size_t dense = map->slots[index].dense;
+    size_t last = map->count - 1;
+    unsigned char *object = object_at(map, dense);
+
+    if (map->destroy != NULL) {
+        map->destroy(object);
+    }
+
+    // Keep storage packed: the last object fills the hole
+    if (dense != last) {
+        uint32_t moved = map->dense_to_slot[last];
+        memcpy(object, object_at(map, last), map->element_size);
+        map->slots[moved].dense = (uint32_t)dense;
+        map->dense_to_slot[dense] = moved;
+    }
+    pool_allocator_free(&map->objects, object_at(map, last));
+    map->count--;
+
+    map->slots[index].generation = next_generation(map->slots[index].generation);
+    map->slots[index].dense = map->free_head;
+    map->free_head = index;
+
+    return 0;
+}
+
+// Remove every object
+void slot_map_clear(SlotMap *map) {
+    if (map == NULL) {
+        return;
+    }
+
+    for (size_t dense = 0; dense < map->count; dense++) {
+        uint32_t index = map->dense_to_slot[dense];
+        if (map->destroy != NULL) {
+            map->destroy(object_at(map, dense));
+        }
+        map->slots[index].generation = next_generation(map->slots[index].generation);
+        map->slots[index].dense = map->free_head;
+        map->free_head = index;
+    }
+
+    map->count = 0;
+    pool_allocator_reset(&map->objects);
+}
+
+// Number of live objects
+size_t slot_map_count(const SlotMap *map) {
+    return map != NULL ? map->count : 0;
+}
+
+// First live object (NULL when empty)
+void *slot_map_data(const SlotMap *map) {
+    return map != NULL && map->count != 0 ? map->objects.memory : NULL;
+}
+
+// Bytes between consecutive live objects
+size_t slot_map_stride(const SlotMap *map) {
+    return map != NULL ? map->objects.block_size : 0;
+}
+
+// Handle of the object at dense_index
+SlotMapHandle slot_map_handle_at(const SlotMap *map, size_t dense_index) {
+    if (map == NULL || dense_index >= map->count) {
+        return SLOT_MAP_NULL_HANDLE;
+    }
+    uint32_t index = map->dense_to_slot[dense_index];
+    return make_handle(index, map->slots[index].generation);
+}
+
+// Destroy all objects and free memory
+void slot_map_destroy(SlotMap *map) {
+    if (map == NULL) {
+        return;
+    }
+
+    if (map->slots != NULL && map->dense_to_slot != NULL) {
+        slot_map_clear(map);
+    }
+    pool_allocator_destroy(&map->objects);
+    free(map->slots);
+    free(map->dense_to_slot);
+    slot_map_init(map);
+}
@@ -0,0 +1,94 @@
+#ifndef SLOT_MAP_H
+#define SLOT_MAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "pool_allocator.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Handles pack a slot index (low bits) and that slot's generation (high bits)
+typedef uint32_t SlotMapHandle;
+
+#define SLOT_MAP_INDEX_BITS      22
+#define SLOT_MAP_GENERATION_BITS 10
+#define SLOT_MAP_MAX_CAPACITY    ((size_t)1 << SLOT_MAP_INDEX_BITS)
+#define SLOT_MAP_NULL_HANDLE     ((SlotMapHandle)0)  // Never returned for a live object
+
+// Called on an object before its storage is reused (may be NULL)
+typedef void (*SlotMapDestructor)(void *object);
+
+// Per-slot state: generation plus the object's dense index, or the next
+// free slot while the slot is unused
+typedef struct {
+    uint32_t dense;
+    uint32_t generation;
+} SlotMapSlot;
+
+/*
+ * Generational slot map over a PoolAllocator. Live objects are kept packed
+ * in pool blocks [0, count) so they can be scanned as one strided array;
+ * removing an object moves the last one into its place. Handles go through
+ * the slot table, so a handle to a removed object is detected in O(1) by
+ * its generation no longer matching. Objects are relocated with memcpy and
+ * must not hold pointers into themselves.
+ */
+typedef struct {
+    PoolAllocator objects;    // Dense storage (blocks are the object stride)
+    SlotMapSlot *slots;       // Indexed by handle
+    uint32_t *dense_to_slot;  // Back-reference for each live object
+    size_t element_size;
+    size_t capacity;
+    size_t count;
+    size_t next_unused;       // Slots at or above this index were never handed out
+    uint32_t free_head;       // First recycled slot (capacity = none)
+    SlotMapDestructor destroy;
+} SlotMap;
+
+// Initialize slot map struct to zero state
+void slot_map_init(SlotMap *map);
+
+// Create map for up to capacity objects of element_size bytes (8-byte aligned)
+// capacity must not exceed SLOT_MAP_MAX_CAPACITY
+int slot_map_create(SlotMap *map, size_t element_size, size_t capacity, SlotMapDestructor destroy);
+
+// Reserve storage for a new object and write its handle to *handle
+// Returns uninitialized storage for the caller to construct, NULL when full
+void *slot_map_emplace(SlotMap *map, SlotMapHandle *handle);
+
+// Copy element_size bytes from value into a new object
+// Returns its handle, SLOT_MAP_NULL_HANDLE when full
+SlotMapHandle slot_map_insert(SlotMap *map, const void *value);
+
+// Object for handle, or NULL if the handle is stale or invalid
+void *slot_map_get(const SlotMap *map, SlotMapHandle handle);
+
+// Check whether handle refers to a live object
+int slot_map_contains(const SlotMap *map, SlotMapHandle handle);
+
+// Destroy the object and invalidate its handle (0 on success, -1 if stale)
+int slot_map_remove(SlotMap *map, SlotMapHandle handle);
+
+// Destroy every object and invalidate all outstanding handles
+void slot_map_clear(SlotMap *map);
+
+// Number of live objects
+size_t slot_map_count(const SlotMap *map);
+
+// Live objects as a packed array: object i is at data + i * stride
+void *slot_map_data(const SlotMap *map);
+size_t slot_map_stride(const SlotMap *map);
+
+// Handle of the object at dense index (SLOT_MAP_NULL_HANDLE if out of range)
+SlotMapHandle slot_map_handle_at(const SlotMap *map, size_t dense_index);
+
+// Destroy all objects and free the map's memory
+void slot_map_destroy(SlotMap *map);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
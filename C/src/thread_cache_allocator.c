@@ -0,0 +1,68 @@
+/*
+ * Thread cache allocator
+ *
+ * Magazine-style front end for the concurrent bump allocator: the hot path
+ * in the header is a plain pointer bump, and the shared arena's atomic is
+ * only hit once per chunk. The unused tail of a chunk is abandoned on
+ * refill, so at most one chunk per thread is wasted.
+ */
+
+#include "thread_cache_allocator.h"
+
+// Attach a cache to a shared arena
+void thread_cache_allocator_init(ThreadCacheAllocator *cache, ConcurrentMemoryAllocator *shared, size_t chunk_size) {
+    cache->shared = shared;
+    cache->cursor = NULL;
+    cache->end = NULL;
+    cache->alignment = shared != NULL && shared->alignment != 0
+        ? shared->alignment
+        : SIMPLE_MEMORY_ALLOCATOR_DEFAULT_ALIGNMENT;
+
+    // Keep chunk ends aligned so the bump cursor never needs padding
+    size_t mask = cache->alignment - 1;
+    chunk_size = chunk_size != 0 ? chunk_size : THREAD_CACHE_ALLOCATOR_DEFAULT_CHUNK_SIZE;
+    cache->chunk_size = (chunk_size + mask) & ~mask;
+}
+
+// Refill the chunk from the shared arena and allocate from it
+// Returns pointer to allocated memory, or NULL if the shared arena is exhausted
+void *thread_cache_allocator_alloc_slow(ThreadCacheAllocator *cache, size_t size) {
+    if (cache == NULL || cache->shared == NULL || size == 0) {
+        return NULL;
+    }
+
+    size_t mask = cache->alignment - 1;
+    size_t aligned_size = (size + mask) & ~mask;
+    if (aligned_size < size) {
+        return NULL;
+    }
+
+    // Large requests would waste most of a chunk
+    if (aligned_size > cache->chunk_size / 2) {
+        return concurrent_memory_allocator_alloc_aligned(cache->shared, aligned_size, cache->alignment);
+    }
+
+    // Refills use the CAS path so a chunk that no longer fits does not
+    // consume the arena tail
+    unsigned char *chunk = concurrent_memory_allocator_alloc_aligned(cache->shared, cache->chunk_size, cache->alignment);
+    if (chunk == NULL) {
+        return concurrent_memory_allocator_alloc_aligned(cache->shared, aligned_size, cache->alignment);
+    }
+
+    cache->cursor = chunk + aligned_size;
+    cache->end = chunk + cache->chunk_size;
+    return chunk;
+}
+
+// Bytes left in the current chunk
+size_t thread_cache_allocator_remaining(const ThreadCacheAllocator *cache) {
+    return cache != NULL ? (size_t)(cache->end - cache->cursor) : 0;
+}
+
+// Drop the current chunk
+void thread_cache_allocator_reset(ThreadCacheAllocator *cache) {
+    if (cache != NULL) {
+        cache->cursor = NULL;
+        cache->end = NULL;
+    }
+}
@@ -0,0 +1,59 @@
+#ifndef THREAD_CACHE_ALLOCATOR_H
+#define THREAD_CACHE_ALLOCATOR_H
+
+#include <stddef.h>
+#include "concurrent_memory_allocator.h"
+
+// Default chunk grabbed from the shared arena per refill
+#define THREAD_CACHE_ALLOCATOR_DEFAULT_CHUNK_SIZE (64 * 1024)
+
+/*
+ * Per-thread front end for a ConcurrentMemoryAllocator. Each thread owns one
+ * cache and bump-allocates from a private chunk without atomics; only a
+ * refill touches the shared arena. Requests larger than half a chunk bypass
+ * the cache and go straight to the shared arena.
+ *
+ * A cache must only be used by the thread that owns it. After the shared
+ * arena is reset, every cache must be reset too before it is used again.
+ */
+typedef struct {
+    ConcurrentMemoryAllocator *shared;
+    unsigned char *cursor;  // Next free byte in the current chunk
+    unsigned char *end;     // End of the current chunk
+    size_t chunk_size;
+    size_t alignment;       // Shared arena alignment, sizes are rounded to it
+} ThreadCacheAllocator;
+
+// Attach a cache to a shared arena (chunk_size 0 = default)
+void thread_cache_allocator_init(ThreadCacheAllocator *cache, ConcurrentMemoryAllocator *shared, size_t chunk_size);
+
+// Refill path used when the current chunk cannot satisfy a request
+void *thread_cache_allocator_alloc_slow(ThreadCacheAllocator *cache, size_t size);
+
+// Bump from the current chunk only (returns NULL when it cannot fit, never refills)
+// Front ends with their own refill policy pair it with their slow path
+static inline void *thread_cache_allocator_bump(ThreadCacheAllocator *cache, size_t size) {
+    size_t mask = cache->alignment - 1;
+    size_t aligned_size = (size + mask) & ~mask;
+
+    if (size != 0 && aligned_size >= size && aligned_size <= (size_t)(cache->end - cache->cursor)) {
+        void *ptr = cache->cursor;
+        cache->cursor += aligned_size;
+        return ptr;
+    }
+    return NULL;
+}
+
+// Allocate from the thread's chunk (returns NULL if the shared arena is exhausted)
+static inline void *thread_cache_allocator_alloc(ThreadCacheAllocator *cache, size_t size) {
+    void *ptr = thread_cache_allocator_bump(cache, size);
+    return ptr != NULL ? ptr : thread_cache_allocator_alloc_slow(cache, size);
+}
+
+// Bytes left in the current chunk
+size_t thread_cache_allocator_remaining(const ThreadCacheAllocator *cache);
+
+// Drop the current chunk (required after the shared arena is reset)
+void thread_cache_allocator_reset(ThreadCacheAllocator *cache);
+
+#endif
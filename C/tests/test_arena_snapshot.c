@@ -0,0 +1,232 @@
+/*
+ * Test suite for arena_snapshot
+ */
+
+#define _DEFAULT_SOURCE  // Required for truncate
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include "../src/arena_snapshot.h"
+#include "test_framework.h"
+
+#define NODE_COUNT 1000
+
+typedef struct {
+    ArenaRelPtr next;
+    ArenaRelPtr name;
+    uint32_t value;
+} SnapshotNode;
+
+typedef struct {
+    ArenaRelPtr head;
+    ArenaRelPtr aligned;  // 64-byte aligned block
+    uint32_t count;
+} SnapshotRoot;
+
+static char snapshot_path[64];
+
+static void set_path(void) {
+    snprintf(snapshot_path, sizeof(snapshot_path), "/tmp/test_arena_snapshot_%ld.snap", (long)getpid());
+}
+
+// Build an arena holding a linked list with names, return its root
+static SnapshotRoot *build_list(SimpleMemoryAllocator *arena) {
+    SnapshotRoot *root = simple_memory_allocator_alloc(arena, sizeof(*root));
+    root->count = NODE_COUNT;
+    arena_relptr_set(&root->head, NULL);
+
+    for (uint32_t i = 0; i < NODE_COUNT; i++) {
+        SnapshotNode *node = simple_memory_allocator_alloc(arena, sizeof(*node));
+        char *name = simple_memory_allocator_alloc(arena, 16);
+        snprintf(name, 16, "node-%u", i);
+        node->value = i * 3;
+        arena_relptr_set(&node->name, name);
+        arena_relptr_set(&node->next, arena_relptr_get(&root->head));
+        arena_relptr_set(&root->head, node);
+    }
+
+    unsigned char *aligned = simple_memory_allocator_alloc_aligned(arena, 64, 64);
+    memset(aligned, 0x5A, 64);
+    arena_relptr_set(&root->aligned, aligned);
+    return root;
+}
+
+// Test: relative pointers resolve wherever the bytes are copied
+TEST(relptr_round_trip) {
+    unsigned char buf[64];
+    unsigned char copy[64];
+    ArenaRelPtr *rel = (ArenaRelPtr *)buf;
+
+    arena_relptr_set(rel, NULL);
+    ASSERT_EQ(*rel, 0);
+    ASSERT_NULL(arena_relptr_get(rel));
+
+    arena_relptr_set(rel, buf + 32);
+    ASSERT_EQ(arena_relptr_get(rel), (void *)(buf + 32));
+
+    // Moving the bytes moves the target with them
+    memcpy(copy, buf, sizeof(buf));
+    ASSERT_EQ(arena_relptr_get((ArenaRelPtr *)copy), (void *)(copy + 32));
+
+    // Backwards targets work too
+    ArenaRelPtr *late = (ArenaRelPtr *)(buf + 48);
+    arena_relptr_set(late, buf);
+    ASSERT_EQ(arena_relptr_get(late), (void *)buf);
+    return 1;
+}
+
+// Test: a snapshot maps back with the same structure and alignments
+TEST(write_and_open_round_trip) {
+    SimpleMemoryAllocator arena;
+    simple_memory_allocator_init(&arena);
+    simple_memory_allocator_create(&arena, 64 * 1024);
+    SnapshotRoot *root = build_list(&arena);
+    ASSERT_EQ(arena_snapshot_write(&arena, root, snapshot_path), 0);
+    size_t used = arena.used;
+
+    // The builder's memory is gone before the snapshot is read
+    simple_memory_allocator_destroy(&arena);
+
+    ArenaSnapshot snap;
+    arena_snapshot_init(&snap);
+    ASSERT_EQ(arena_snapshot_open(&snap, snapshot_path), 0);
+    ASSERT_EQ(snap.size, used);
+
+    const SnapshotRoot *mapped = arena_snapshot_root(&snap);
+    ASSERT_EQ((const void *)mapped, snap.data);
+    ASSERT_EQ(mapped->count, NODE_COUNT);
+
+    uint32_t expected = NODE_COUNT;
+    char name[16];
+    for (const SnapshotNode *node = arena_relptr_get(&mapped->head); node != NULL;
+         node = arena_relptr_get(&node->next)) {
+        expected--;
+        ASSERT(arena_snapshot_contains(&snap, node));
+        snprintf(name, sizeof(name), "node-%u", expected);
+        ASSERT_EQ(strcmp(arena_relptr_get(&node->name), name), 0);
+        ASSERT_EQ(node->value, expected * 3);
+    }
+    ASSERT_EQ(expected, 0);
+
+    const unsigned char *aligned = arena_relptr_get(&mapped->aligned);
+    ASSERT_EQ((uintptr_t)aligned % 64, 0);
+    ASSERT_EQ(aligned[63], 0x5A);
+    ASSERT(!arena_snapshot_contains(&snap, &snap));
+
+    arena_snapshot_close(&snap);
+    ASSERT_NULL(snap.mapping);
+    unlink(snapshot_path);
+    return 1;
+}
+
+// Test: only a single contiguous, non-empty region can be written
+TEST(write_rejects_unrelocatable_arenas) {
+    SimpleMemoryAllocator arena;
+    simple_memory_allocator_init(&arena);
+    simple_memory_allocator_create(&arena, 1024);
+    ASSERT_EQ(arena_snapshot_write(&arena, NULL, snapshot_path), -1);  // Empty
+
+    void *inside = simple_memory_allocator_alloc(&arena, 64);
+    int outside = 0;
+    ASSERT_EQ(arena_snapshot_write(&arena, &outside, snapshot_path), -1);
+    ASSERT_EQ(arena_snapshot_write(&arena, inside, "/nonexistent-dir/x.snap"), -1);
+    ASSERT_EQ(arena_snapshot_write(&arena, NULL, snapshot_path), 0);  // Root is optional
+    simple_memory_allocator_destroy(&arena);
+
+    ArenaSnapshot snap;
+    ASSERT_EQ(arena_snapshot_open(&snap, snapshot_path), 0);
+    ASSERT_NULL(arena_snapshot_root(&snap));
+    arena_snapshot_close(&snap);
+
+    // Chained blocks are not contiguous
+    SimpleMemoryAllocatorOptions options = {.growable = 1};
+    simple_memory_allocator_create_with_options(&arena, 256, &options);
+    simple_memory_allocator_alloc(&arena, 200);
+    simple_memory_allocator_alloc(&arena, 200);
+    ASSERT(simple_memory_allocator_block_count(&arena) > 1);
+    ASSERT_EQ(arena_snapshot_write(&arena, NULL, snapshot_path), -1);
+
+    // After a reset only the kept block is live again
+    simple_memory_allocator_reset(&arena);
+    simple_memory_allocator_alloc(&arena, 8);
+    ASSERT_EQ(arena_snapshot_write(&arena, NULL, snapshot_path), 0);
+    simple_memory_allocator_destroy(&arena);
+    unlink(snapshot_path);
+    return 1;
+}
+
+// Test: missing, truncated or foreign files are refused
+TEST(open_rejects_bad_files) {
+    ArenaSnapshot snap;
+    arena_snapshot_init(&snap);
+    ASSERT_EQ(arena_snapshot_open(&snap, "/nonexistent-dir/x.snap"), -1);
+
+    FILE *f = fopen(snapshot_path, "wb");
+    fwrite("SMA", 1, 3, f);
+    fclose(f);
+    ASSERT_EQ(arena_snapshot_open(&snap, snapshot_path), -1);
+
+    f = fopen(snapshot_path, "wb");
+    char junk[4096];
+    memset(junk, 'x', sizeof(junk));
+    fwrite(junk, 1, sizeof(junk), f);
+    fclose(f);
+    ASSERT_EQ(arena_snapshot_open(&snap, snapshot_path), -1);
+
+    // A valid snapshot cut short loses its data
+    SimpleMemoryAllocator arena;
+    simple_memory_allocator_init(&arena);
+    simple_memory_allocator_create(&arena, 64 * 1024);
+    build_list(&arena);
+    ASSERT_EQ(arena_snapshot_write(&arena, NULL, snapshot_path), 0);
+    simple_memory_allocator_destroy(&arena);
+    ASSERT_EQ(truncate(snapshot_path, 8192), 0);
+    ASSERT_EQ(arena_snapshot_open(&snap, snapshot_path), -1);
+    ASSERT_NULL(snap.mapping);
+
+    unlink(snapshot_path);
+    return 1;
+}
+
+// Test: NULL arguments are handled safely
+TEST(handles_null) {
+    SimpleMemoryAllocator arena;
+    simple_memory_allocator_init(&arena);
+    ASSERT_EQ(arena_snapshot_write(NULL, NULL, snapshot_path), -1);
+    ASSERT_EQ(arena_snapshot_write(&arena, NULL, snapshot_path), -1);
+    ASSERT_EQ(arena_snapshot_write(&arena, NULL, NULL), -1);
+
+    ArenaSnapshot snap;
+    arena_snapshot_init(&snap);
+    ASSERT_EQ(arena_snapshot_open(NULL, snapshot_path), -1);
+    ASSERT_EQ(arena_snapshot_open(&snap, NULL), -1);
+    ASSERT_NULL(arena_snapshot_root(NULL));
+    ASSERT(!arena_snapshot_contains(NULL, &snap));
+    arena_snapshot_init(NULL);
+    arena_snapshot_close(NULL);
+    arena_snapshot_close(&snap);
+    return 1;
+}
+
+int main(void) {
+    set_path();
+
+    printf("\n");
+    printf("╔════════════════════════════════════════════════════╗\n");
+    printf("║     Arena Snapshot Test Suite                      ║\n");
+    printf("╚════════════════════════════════════════════════════╝\n\n");
+
+    printf("▸ Relative Pointer Tests\n");
+    RUN_TEST(relptr_round_trip);
+
+    printf("\n▸ Snapshot Tests\n");
+    RUN_TEST(write_and_open_round_trip);
+    RUN_TEST(write_rejects_unrelocatable_arenas);
+    RUN_TEST(open_rejects_bad_files);
+    RUN_TEST(handles_null);
+
+    return test_summary();
+}
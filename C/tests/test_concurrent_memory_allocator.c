@@ -0,0 +1,203 @@
+/*
+ * Test suite for concurrent_memory_allocator
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "../src/concurrent_memory_allocator.h"
+#include "test_framework.h"
+
+#define THREAD_COUNT      8
+#define ALLOCS_PER_THREAD 2000
+
+// Test: create sets up an empty pool
+TEST(create_sets_up_pool) {
+    ConcurrentMemoryAllocator alloc;
+    concurrent_memory_allocator_init(&alloc);
+
+    ASSERT_EQ(concurrent_memory_allocator_create(&alloc, 1024), 0);
+    ASSERT_NOT_NULL(alloc.base);
+    ASSERT_EQ(alloc.capacity, 1024);
+    ASSERT_EQ(concurrent_memory_allocator_used(&alloc), 0);
+
+    concurrent_memory_allocator_destroy(&alloc);
+    ASSERT_NULL(alloc.base);
+    return 1;
+}
+
+// Test: growable options are rejected
+TEST(create_rejects_growable) {
+    ConcurrentMemoryAllocator alloc;
+    SimpleMemoryAllocatorOptions opts = {0};
+    opts.growable = 1;
+
+    ASSERT_EQ(concurrent_memory_allocator_create_with_options(&alloc, 1024, &opts), -1);
+    ASSERT_EQ(concurrent_memory_allocator_create(NULL, 1024), -1);
+    return 1;
+}
+
+// Test: single-threaded allocations are sequential and aligned
+TEST(alloc_sequential) {
+    ConcurrentMemoryAllocator alloc;
+    concurrent_memory_allocator_create(&alloc, 1024);
+
+    uint8_t *ptr1 = concurrent_memory_allocator_alloc(&alloc, 100);
+    uint8_t *ptr2 = concurrent_memory_allocator_alloc(&alloc, 8);
+
+    ASSERT_NOT_NULL(ptr1);
+    ASSERT_EQ(ptr2, ptr1 + 104);
+    ASSERT_EQ((uintptr_t)ptr1 % 8, 0);
+    ASSERT_EQ(concurrent_memory_allocator_used(&alloc), 112);
+
+    concurrent_memory_allocator_destroy(&alloc);
+    return 1;
+}
+
+// Test: alloc fails when exhausted and used is clamped
+TEST(alloc_fails_when_exhausted) {
+    ConcurrentMemoryAllocator alloc;
+    concurrent_memory_allocator_create(&alloc, 128);
+
+    ASSERT_NOT_NULL(concurrent_memory_allocator_alloc(&alloc, 96));
+    ASSERT_NULL(concurrent_memory_allocator_alloc(&alloc, 64));
+    ASSERT_NULL(concurrent_memory_allocator_alloc(&alloc, 0));
+    ASSERT_EQ(concurrent_memory_allocator_used(&alloc), 128);
+
+    concurrent_memory_allocator_reset(&alloc);
+    ASSERT_EQ(concurrent_memory_allocator_used(&alloc), 0);
+    ASSERT_NOT_NULL(concurrent_memory_allocator_alloc(&alloc, 128));
+
+    concurrent_memory_allocator_destroy(&alloc);
+    return 1;
+}
+
+// Test: explicit alignment goes through the CAS path
+TEST(alloc_aligned_cas_path) {
+    ConcurrentMemoryAllocator alloc;
+    concurrent_memory_allocator_create(&alloc, 4096);
+
+    concurrent_memory_allocator_alloc(&alloc, 8);
+    void *ptr64 = concurrent_memory_allocator_alloc_aligned(&alloc, 10, 64);
+    void *ptr256 = concurrent_memory_allocator_alloc_aligned(&alloc, 10, 256);
+
+    ASSERT_NOT_NULL(ptr64);
+    ASSERT_NOT_NULL(ptr256);
+    ASSERT_EQ((uintptr_t)ptr64 % 64, 0);
+    ASSERT_EQ((uintptr_t)ptr256 % 256, 0);
+    ASSERT_NULL(concurrent_memory_allocator_alloc_aligned(&alloc, 10, 48));
+
+    concurrent_memory_allocator_destroy(&alloc);
+    return 1;
+}
+
+// Test: default alignment option aligns the base and rounds sizes
+TEST(default_alignment_option) {
+    ConcurrentMemoryAllocator alloc;
+    SimpleMemoryAllocatorOptions opts = {0};
+    opts.alignment = 64;
+    ASSERT_EQ(concurrent_memory_allocator_create_with_options(&alloc, 4096, &opts), 0);
+
+    uint8_t *ptr1 = concurrent_memory_allocator_alloc(&alloc, 1);
+    uint8_t *ptr2 = concurrent_memory_allocator_alloc(&alloc, 1);
+
+    ASSERT_EQ((uintptr_t)ptr1 % 64, 0);
+    ASSERT_EQ(ptr2, ptr1 + 64);
+
+    concurrent_memory_allocator_destroy(&alloc);
+    return 1;
+}
+
+typedef struct {
+    ConcurrentMemoryAllocator *alloc;
+    uintptr_t *ptrs;
+    size_t alignment;
+} ThreadArgs;
+
+static void *alloc_thread(void *arg) {
+    ThreadArgs *args = arg;
+    for (size_t i = 0; i < ALLOCS_PER_THREAD; i++) {
+        void *ptr = args->alignment
+            ? concurrent_memory_allocator_alloc_aligned(args->alloc, 24, args->alignment)
+            : concurrent_memory_allocator_alloc(args->alloc, 24);
+        args->ptrs[i] = (uintptr_t)ptr;
+    }
+    return NULL;
+}
+
+static int compare_uintptr(const void *a, const void *b) {
+    uintptr_t x = *(const uintptr_t *)a;
+    uintptr_t y = *(const uintptr_t *)b;
+    return (x > y) - (x < y);
+}
+
+// Run THREAD_COUNT allocating threads and check no two allocations overlap
+static int run_threads_and_check(size_t alignment) {
+    ConcurrentMemoryAllocator alloc;
+    size_t total = (size_t)THREAD_COUNT * ALLOCS_PER_THREAD;
+    if (concurrent_memory_allocator_create(&alloc, total * 64) != 0) return 0;
+
+    uintptr_t *ptrs = calloc(total, sizeof(uintptr_t));
+    pthread_t threads[THREAD_COUNT];
+    ThreadArgs args[THREAD_COUNT];
+
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        args[t].alloc = &alloc;
+        args[t].ptrs = ptrs + (size_t)t * ALLOCS_PER_THREAD;
+        args[t].alignment = alignment;
+        pthread_create(&threads[t], NULL, alloc_thread, &args[t]);
+    }
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    qsort(ptrs, total, sizeof(uintptr_t), compare_uintptr);
+
+    int ok = 1;
+    for (size_t i = 0; i < total && ok; i++) {
+        ok = ptrs[i] != 0 && (alignment == 0 || ptrs[i] % alignment == 0);
+        if (ok && i > 0) {
+            ok = ptrs[i] >= ptrs[i - 1] + 24;
+        }
+    }
+
+    free(ptrs);
+    concurrent_memory_allocator_destroy(&alloc);
+    return ok;
+}
+
+// Test: concurrent fetch-add allocations never overlap
+TEST(threads_never_overlap) {
+    ASSERT(run_threads_and_check(0));
+    return 1;
+}
+
+// Test: concurrent CAS allocations never overlap
+TEST(threads_aligned_never_overlap) {
+    ASSERT(run_threads_and_check(32));
+    return 1;
+}
+
+int main(void) {
+    printf("\n");
+    printf("╔════════════════════════════════════════════════════╗\n");
+    printf("║     Concurrent Memory Allocator Test Suite         ║\n");
+    printf("╚════════════════════════════════════════════════════╝\n\n");
+
+    printf("▸ Creation Tests\n");
+    RUN_TEST(create_sets_up_pool);
+    RUN_TEST(create_rejects_growable);
+
+    printf("\n▸ Allocation Tests\n");
+    RUN_TEST(alloc_sequential);
+    RUN_TEST(alloc_fails_when_exhausted);
+    RUN_TEST(alloc_aligned_cas_path);
+    RUN_TEST(default_alignment_option);
+
+    printf("\n▸ Threading Tests\n");
+    RUN_TEST(threads_never_overlap);
+    RUN_TEST(threads_aligned_never_overlap);
+
+    return test_summary();
+}
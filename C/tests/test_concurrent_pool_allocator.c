@@ -0,0 +1,235 @@
+/*
+ * Test suite for concurrent_pool_allocator
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include "../src/concurrent_pool_allocator.h"
+#include "test_framework.h"
+
+#define THREAD_COUNT 4
+#define ROUNDS       20000
+#define HELD         16
+
+// Test: create rounds blocks and hands them out lazily in address order
+TEST(create_and_alloc_fresh) {
+    ConcurrentPoolAllocator pool;
+    concurrent_pool_allocator_init(&pool);
+
+    ASSERT_EQ(concurrent_pool_allocator_create(&pool, 0, 8), -1);
+    ASSERT_EQ(concurrent_pool_allocator_create(&pool, 8, 0), -1);
+    ASSERT_EQ(concurrent_pool_allocator_create(&pool, 13, 4), 0);
+    ASSERT_EQ(pool.block_size, 16);
+
+    uint8_t *a = concurrent_pool_allocator_alloc(&pool);
+    uint8_t *b = concurrent_pool_allocator_alloc(&pool);
+    ASSERT_EQ(a, pool.memory);
+    ASSERT_EQ(b, a + 16);
+    ASSERT_NOT_NULL(concurrent_pool_allocator_alloc(&pool));
+    ASSERT_NOT_NULL(concurrent_pool_allocator_alloc(&pool));
+    ASSERT_NULL(concurrent_pool_allocator_alloc(&pool));
+    ASSERT(concurrent_pool_allocator_owns(&pool, b));
+    ASSERT(!concurrent_pool_allocator_owns(&pool, &pool));
+
+    concurrent_pool_allocator_destroy(&pool);
+    ASSERT_NULL(pool.memory);
+    return 1;
+}
+
+// Test: freed blocks are recycled LIFO and reset restores capacity
+TEST(free_recycles_and_reset) {
+    ConcurrentPoolAllocator pool;
+    concurrent_pool_allocator_init(&pool);
+    concurrent_pool_allocator_create(&pool, 32, 2);
+
+    void *a = concurrent_pool_allocator_alloc(&pool);
+    void *b = concurrent_pool_allocator_alloc(&pool);
+    concurrent_pool_allocator_free(&pool, a);
+    concurrent_pool_allocator_free(&pool, b);
+    concurrent_pool_allocator_free(&pool, NULL);
+    ASSERT_EQ(concurrent_pool_allocator_alloc(&pool), b);
+    ASSERT_EQ(concurrent_pool_allocator_alloc(&pool), a);
+    ASSERT_NULL(concurrent_pool_allocator_alloc(&pool));
+
+    // Every CAS bumps the tag even when the head ref ends up the same
+    concurrent_pool_allocator_free(&pool, a);
+    uint64_t before = pool.free_head;
+    ASSERT_EQ(concurrent_pool_allocator_alloc(&pool), a);
+    concurrent_pool_allocator_free(&pool, a);
+    ASSERT_EQ((uint32_t)pool.free_head, (uint32_t)before);
+    ASSERT_NE(pool.free_head, before);
+
+    concurrent_pool_allocator_reset(&pool);
+    ASSERT_EQ(concurrent_pool_allocator_alloc(&pool), (void *)pool.memory);
+
+    concurrent_pool_allocator_destroy(&pool);
+    return 1;
+}
+
+// Test: magazines refill in batches and spill whole batches to the depot
+TEST(magazine_batches_through_depot) {
+    ConcurrentPoolAllocator pool;
+    concurrent_pool_allocator_init(&pool);
+    concurrent_pool_allocator_create(&pool, 64, 64);
+    ConcurrentPoolMagazine mag;
+    concurrent_pool_magazine_init(&mag, &pool, 8);
+
+    // One refill claims half a magazine of fresh blocks
+    uint8_t *first = concurrent_pool_magazine_alloc(&mag);
+    ASSERT_EQ(first, pool.memory);
+    ASSERT_EQ(mag.count, 3);
+    ASSERT_EQ(pool.next_unused, 4);
+    ASSERT_EQ(concurrent_pool_magazine_alloc(&mag), first + 64);
+
+    void *held[12];
+    for (int i = 0; i < 12; i++) {
+        held[i] = concurrent_pool_allocator_alloc(&pool);
+    }
+    for (int i = 0; i < 12; i++) {
+        concurrent_pool_magazine_free(&mag, held[i]);
+    }
+    ASSERT(mag.count <= mag.capacity);
+    ASSERT_NE((uint32_t)pool.depot_head, 0);
+
+    // Another thread's magazine takes the parked batch in one pop
+    ConcurrentPoolMagazine other;
+    concurrent_pool_magazine_init(&other, &pool, 8);
+    size_t fresh_before = pool.next_unused;
+    ASSERT_NOT_NULL(concurrent_pool_magazine_alloc(&other));
+    ASSERT_EQ(pool.next_unused, fresh_before);
+    ASSERT_EQ(other.count, 3);
+
+    // Plain alloc() also drains depot batches
+    concurrent_pool_magazine_flush(&other);
+    ASSERT_EQ(other.count, 0);
+    concurrent_pool_magazine_flush(&mag);
+    size_t recycled = 0;
+    while ((uint32_t)pool.free_head != 0 || (uint32_t)pool.depot_head != 0) {
+        ASSERT_NOT_NULL(concurrent_pool_allocator_alloc(&pool));
+        recycled++;
+    }
+    ASSERT_EQ(recycled, 16 - 3);  // Everything but the three blocks still held
+
+    concurrent_pool_allocator_destroy(&pool);
+    return 1;
+}
+
+typedef struct {
+    ConcurrentPoolAllocator *pool;
+    int use_magazine;
+    int id;
+    int failures;
+} StressArgs;
+
+// Hold a few blocks, stamp them, and verify nobody else got them
+static void *stress_worker(void *arg) {
+    StressArgs *args = arg;
+    ConcurrentPoolMagazine mag;
+    concurrent_pool_magazine_init(&mag, args->pool, 16);
+    void *held[HELD];
+
+    for (int round = 0; round < ROUNDS; round++) {
+        int n = 1 + round % HELD;
+        for (int i = 0; i < n; i++) {
+            held[i] = args->use_magazine ? concurrent_pool_magazine_alloc(&mag)
+                                         : concurrent_pool_allocator_alloc(args->pool);
+            if (held[i] == NULL) {
+                args->failures++;
+                n = i;
+                break;
+            }
+            memset(held[i], args->id, 48);
+        }
+        for (int i = 0; i < n; i++) {
+            unsigned char *bytes = held[i];
+            if (bytes[8] != args->id || bytes[47] != args->id) {
+                args->failures++;
+            }
+            if (args->use_magazine) {
+                concurrent_pool_magazine_free(&mag, held[i]);
+            } else {
+                concurrent_pool_allocator_free(args->pool, held[i]);
+            }
+        }
+    }
+    concurrent_pool_magazine_flush(&mag);
+    return NULL;
+}
+
+static int run_stress(int use_magazine) {
+    ConcurrentPoolAllocator pool;
+    concurrent_pool_allocator_init(&pool);
+    concurrent_pool_allocator_create(&pool, 48, THREAD_COUNT * (HELD + 32));
+
+    StressArgs args[THREAD_COUNT];
+    pthread_t threads[THREAD_COUNT];
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        args[t] = (StressArgs){&pool, use_magazine, t + 1, 0};
+        pthread_create(&threads[t], NULL, stress_worker, &args[t]);
+    }
+    int failures = 0;
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        pthread_join(threads[t], NULL);
+        failures += args[t].failures;
+    }
+
+    // Every block made it back: the pool can hand out all of them again
+    size_t total = 0;
+    while (concurrent_pool_allocator_alloc(&pool) != NULL) {
+        total++;
+    }
+    concurrent_pool_allocator_destroy(&pool);
+    return failures == 0 && total == THREAD_COUNT * (HELD + 32);
+}
+
+// Test: concurrent alloc/free never hands one block to two threads
+TEST(concurrent_stress_free_list) {
+    ASSERT(run_stress(0));
+    return 1;
+}
+
+// Test: same with per-thread magazines
+TEST(concurrent_stress_magazines) {
+    ASSERT(run_stress(1));
+    return 1;
+}
+
+// Test: NULL arguments are handled safely
+TEST(handles_null) {
+    ConcurrentPoolMagazine mag;
+    concurrent_pool_magazine_init(&mag, NULL, 0);
+    ASSERT_EQ(mag.capacity, CONCURRENT_POOL_MAGAZINE_DEFAULT);
+    ASSERT_NULL(concurrent_pool_magazine_alloc(&mag));
+    concurrent_pool_magazine_flush(&mag);
+
+    ASSERT_EQ(concurrent_pool_allocator_create(NULL, 8, 8), -1);
+    ASSERT_NULL(concurrent_pool_allocator_alloc(NULL));
+    concurrent_pool_allocator_free(NULL, &mag);
+    concurrent_pool_allocator_reset(NULL);
+    concurrent_pool_allocator_destroy(NULL);
+    return 1;
+}
+
+int main(void) {
+    printf("\n");
+    printf("╔════════════════════════════════════════════════════╗\n");
+    printf("║     Concurrent Pool Allocator Test Suite           ║\n");
+    printf("╚════════════════════════════════════════════════════╝\n\n");
+
+    printf("▸ Free List Tests\n");
+    RUN_TEST(create_and_alloc_fresh);
+    RUN_TEST(free_recycles_and_reset);
+
+    printf("\n▸ Magazine Tests\n");
+    RUN_TEST(magazine_batches_through_depot);
+
+    printf("\n▸ Concurrency Tests\n");
+    RUN_TEST(concurrent_stress_free_list);
+    RUN_TEST(concurrent_stress_magazines);
+    RUN_TEST(handles_null);
+
+    return test_summary();
+}
@@ -0,0 +1,156 @@
+/*
+ * Test suite for frame_ring_allocator
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "../src/frame_ring_allocator.h"
+#include "test_framework.h"
+
+// Test: create validates depth and builds every buffer
+TEST(create_validates_depth) {
+    FrameRingAllocator ring;
+    frame_ring_allocator_init(&ring);
+
+    ASSERT_EQ(frame_ring_allocator_create(&ring, 1, 1024), -1);
+    ASSERT_EQ(frame_ring_allocator_create(&ring, FRAME_RING_MAX_DEPTH + 1, 1024), -1);
+    ASSERT_EQ(frame_ring_allocator_create(&ring, 3, 0), -1);
+
+    ASSERT_EQ(frame_ring_allocator_create(&ring, 3, 1024), 0);
+    ASSERT_EQ(ring.depth, 3);
+    for (size_t i = 0; i < 3; i++) {
+        ASSERT_NOT_NULL(ring.buffers[i].memory);
+    }
+    ASSERT_NULL(ring.buffers[3].memory);
+
+    frame_ring_allocator_destroy(&ring);
+    ASSERT_NULL(ring.buffers[0].memory);
+    return 1;
+}
+
+// Test: double buffer keeps the previous frame readable
+TEST(previous_frame_survives_advance) {
+    FrameRingAllocator ring;
+    frame_ring_allocator_init(&ring);
+    frame_ring_allocator_create(&ring, 2, 1024);
+
+    char *produced = frame_ring_allocator_alloc(&ring, 32);
+    ASSERT_NOT_NULL(produced);
+    strcpy(produced, "frame zero");
+
+    frame_ring_allocator_advance(&ring);
+    ASSERT_EQ(frame_ring_allocator_frame(&ring), 1);
+    ASSERT_EQ(strcmp(produced, "frame zero"), 0);
+    ASSERT_EQ(frame_ring_allocator_buffer(&ring, 1)->used, 32);
+    ASSERT_EQ(frame_ring_allocator_buffer(&ring, 0)->used, 0);
+
+    char *next = frame_ring_allocator_alloc(&ring, 32);
+    ASSERT_NE(next, produced);
+
+    // Two frames later the first buffer is recycled
+    frame_ring_allocator_advance(&ring);
+    ASSERT_EQ(frame_ring_allocator_alloc(&ring, 32), produced);
+
+    frame_ring_allocator_destroy(&ring);
+    return 1;
+}
+
+// Test: buffers rotate through the full depth
+TEST(ring_rotates_through_depth) {
+    FrameRingAllocator ring;
+    frame_ring_allocator_init(&ring);
+    frame_ring_allocator_create(&ring, 4, 256);
+
+    void *first[4];
+    for (int frame = 0; frame < 4; frame++) {
+        first[frame] = frame_ring_allocator_alloc(&ring, 8);
+        frame_ring_allocator_advance(&ring);
+    }
+    ASSERT_EQ(frame_ring_allocator_buffer(&ring, 0)->used, 0);
+    ASSERT_EQ(frame_ring_allocator_buffer(&ring, 3)->used, 8);
+    ASSERT_NULL(frame_ring_allocator_buffer(&ring, 4));
+
+    for (int frame = 0; frame < 4; frame++) {
+        ASSERT_EQ(frame_ring_allocator_alloc(&ring, 8), first[frame]);
+        frame_ring_allocator_advance(&ring);
+    }
+
+    void *aligned = frame_ring_allocator_alloc_aligned(&ring, 8, 64);
+    ASSERT_EQ((uintptr_t)aligned % 64, 0);
+
+    frame_ring_allocator_destroy(&ring);
+    return 1;
+}
+
+// Test: per-frame statistics are collected only when enabled
+TEST(frame_stats) {
+    FrameRingAllocator ring;
+    FrameRingStats stats;
+    SimpleMemoryAllocatorOptions opts = {0};
+    opts.growable = 1;
+    frame_ring_allocator_init(&ring);
+    frame_ring_allocator_create_with_options(&ring, 2, 128, &opts);
+
+    ASSERT_EQ(frame_ring_allocator_get_stats(&ring, &stats), -1);
+    frame_ring_allocator_alloc(&ring, 64);
+    frame_ring_allocator_advance(&ring);
+
+    frame_ring_allocator_set_stats(&ring, 1);
+    frame_ring_allocator_alloc(&ring, 40);
+    frame_ring_allocator_advance(&ring);
+    frame_ring_allocator_alloc(&ring, 100);
+    frame_ring_allocator_alloc(&ring, 100);  // Chains a second block
+    frame_ring_allocator_advance(&ring);
+
+    ASSERT_EQ(frame_ring_allocator_get_stats(&ring, &stats), 0);
+    ASSERT_EQ(stats.frames, 2);
+    ASSERT_EQ(stats.total_bytes, 40 + 208);
+    ASSERT_EQ(stats.peak_bytes, 208);
+    ASSERT_EQ(stats.grown_frames, 1);
+    ASSERT_EQ(stats.last.frame, 2);
+    ASSERT_EQ(stats.last.block_count, 2);
+
+    frame_ring_allocator_set_stats(&ring, 0);
+    ASSERT_EQ(frame_ring_allocator_get_stats(&ring, &stats), -1);
+
+    frame_ring_allocator_destroy(&ring);
+    return 1;
+}
+
+// Test: NULL and uncreated rings are handled safely
+TEST(handles_null) {
+    FrameRingAllocator ring;
+    frame_ring_allocator_init(&ring);
+    ASSERT_NULL(frame_ring_allocator_alloc(&ring, 8));
+    frame_ring_allocator_advance(&ring);
+    ASSERT_EQ(frame_ring_allocator_frame(&ring), 0);
+
+    ASSERT_EQ(frame_ring_allocator_create(NULL, 2, 64), -1);
+    ASSERT_NULL(frame_ring_allocator_alloc_aligned(NULL, 8, 8));
+    ASSERT_NULL(frame_ring_allocator_buffer(NULL, 0));
+    frame_ring_allocator_advance(NULL);
+    frame_ring_allocator_destroy(NULL);
+    return 1;
+}
+
+int main(void) {
+    printf("\n");
+    printf("╔════════════════════════════════════════════════════╗\n");
+    printf("║     Frame Ring Allocator Test Suite                ║\n");
+    printf("╚════════════════════════════════════════════════════╝\n\n");
+
+    printf("▸ Creation Tests\n");
+    RUN_TEST(create_validates_depth);
+
+    printf("\n▸ Rotation Tests\n");
+    RUN_TEST(previous_frame_survives_advance);
+    RUN_TEST(ring_rotates_through_depth);
+
+    printf("\n▸ Statistics Tests\n");
+    RUN_TEST(frame_stats);
+    RUN_TEST(handles_null);
+
+    return test_summary();
+}
@@ -0,0 +1,51 @@
+/*
+ * Minimal test harness shared by the test suites
+ */
+
+#ifndef TEST_FRAMEWORK_H
+#define TEST_FRAMEWORK_H
+
+#include <stdio.h>
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+// ANSI color codes
+#define COLOR_RESET   "\033[0m"
+#define COLOR_YELLOW  "\033[33m"
+#define COLOR_GREEN   "\033[32m"
+#define COLOR_RED     "\033[31m"
+
+#define TEST(name) static int test_##name(void)
+#define RUN_TEST(name) do { \
+    tests_run++; \
+    printf("  " COLOR_YELLOW "[TEST]" COLOR_RESET " %-40s ", #name); \
+    if (test_##name()) { \
+        tests_passed++; \
+        printf(COLOR_GREEN "[PASS]" COLOR_RESET "\n"); \
+    } else { \
+        printf(COLOR_RED "[FAIL]" COLOR_RESET "\n"); \
+    } \
+} while(0)
+
+#define ASSERT(cond) do { if (!(cond)) return 0; } while(0)
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+#define ASSERT_NE(a, b) ASSERT((a) != (b))
+#define ASSERT_NULL(p) ASSERT((p) == NULL)
+#define ASSERT_NOT_NULL(p) ASSERT((p) != NULL)
+
+// Print results and return the process exit code
+static inline int test_summary(void) {
+    printf("\n────────────────────────────────────────────────────\n");
+    printf("Results: %d/%d tests passed", tests_passed, tests_run);
+    if (tests_passed == tests_run) {
+        printf(" - ALL TESTS PASSED!\n");
+    } else {
+        printf(" - %d FAILED\n", tests_run - tests_passed);
+    }
+    printf("────────────────────────────────────────────────────\n\n");
+
+    return tests_passed == tests_run ? 0 : 1;
+}
+
+#endif
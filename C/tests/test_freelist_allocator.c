@@ -0,0 +1,312 @@
+/*
+ * Test suite for freelist_allocator
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include "../src/freelist_allocator.h"
+#include "test_framework.h"
+
+static _Alignas(16) unsigned char region[4096];
+
+// Test: init creates one free block covering the region
+TEST(init_single_free_block) {
+    FreeListAllocator a;
+    freelist_init(&a, region, sizeof(region));
+
+    ASSERT_EQ(freelist_used(&a), 0);
+    ASSERT_EQ(a.size, sizeof(region));
+    ASSERT_EQ(freelist_free_bytes(&a), sizeof(region) - FREELIST_HEADER_SIZE);
+    ASSERT_EQ(freelist_largest_free(&a), sizeof(region) - FREELIST_HEADER_SIZE);
+    return 1;
+}
+
+// Test: alloc returns memory after the header and accounts for it
+TEST(alloc_accounts_header) {
+    FreeListAllocator a;
+    freelist_init(&a, region, sizeof(region));
+
+    void *ptr = freelist_alloc(&a, 100);
+
+    ASSERT_NOT_NULL(ptr);
+    ASSERT(freelist_owns(&a, ptr));
+    ASSERT_EQ((uintptr_t)ptr % 8, 0);
+    ASSERT(freelist_used(&a) >= 100 + FREELIST_HEADER_SIZE);
+    return 1;
+}
+
+// Test: allocations never overlap and are writable
+TEST(allocs_do_not_overlap) {
+    FreeListAllocator a;
+    freelist_init(&a, region, sizeof(region));
+
+    unsigned char *ptrs[8];
+    for (int i = 0; i < 8; i++) {
+        ptrs[i] = freelist_alloc(&a, 64);
+        ASSERT_NOT_NULL(ptrs[i]);
+        memset(ptrs[i], i, 64);
+    }
+    for (int i = 0; i < 8; i++) {
+        for (int j = 0; j < 64; j++) {
+            ASSERT_EQ(ptrs[i][j], i);
+        }
+    }
+    return 1;
+}
+
+// Test: alloc fails when nothing fits
+TEST(alloc_fails_when_exhausted) {
+    FreeListAllocator a;
+    freelist_init(&a, region, sizeof(region));
+
+    ASSERT_NULL(freelist_alloc(&a, sizeof(region)));
+    ASSERT_NULL(freelist_alloc(&a, 0));
+    ASSERT_NULL(freelist_alloc(&a, SIZE_MAX));
+    return 1;
+}
+
+// Test: freeing everything coalesces back into one block
+TEST(free_coalesces_all) {
+    FreeListAllocator a;
+    freelist_init(&a, region, sizeof(region));
+
+    void *ptrs[6];
+    for (int i = 0; i < 6; i++) {
+        ptrs[i] = freelist_alloc(&a, 200);
+    }
+
+    // Free in mixed order to exercise both neighbor merges
+    int order[6] = {1, 3, 0, 5, 2, 4};
+    for (int i = 0; i < 6; i++) {
+        freelist_free(&a, ptrs[order[i]]);
+    }
+
+    ASSERT_EQ(freelist_used(&a), 0);
+    ASSERT_NOT_NULL(freelist_alloc(&a, sizeof(region) - 64));
+    return 1;
+}
+
+// Test: freed block is reused
+TEST(free_allows_reuse) {
+    FreeListAllocator a;
+    freelist_init(&a, region, sizeof(region));
+
+    void *ptr1 = freelist_alloc(&a, 128);
+    freelist_alloc(&a, 128);
+    freelist_free(&a, ptr1);
+
+    ASSERT_EQ(freelist_alloc(&a, 128), ptr1);
+    return 1;
+}
+
+// Test: NULL arguments are handled
+TEST(handles_null) {
+    FreeListAllocator a;
+    freelist_init(&a, region, sizeof(region));
+
+    freelist_free(&a, NULL);
+    freelist_free(NULL, region);
+    ASSERT_NULL(freelist_alloc(NULL, 8));
+    ASSERT(!freelist_owns(&a, NULL));
+    return 1;
+}
+
+// Test: freeing a block between two free neighbors merges all three
+TEST(free_merges_both_neighbors) {
+    FreeListAllocator a;
+    freelist_init(&a, region, sizeof(region));
+
+    void *left = freelist_alloc(&a, 64);
+    void *middle = freelist_alloc(&a, 64);
+    void *right = freelist_alloc(&a, 64);
+    void *guard = freelist_alloc(&a, 64);  // Keeps right away from the tail
+
+    freelist_free(&a, left);
+    freelist_free(&a, right);
+    freelist_free(&a, middle);
+
+    // The merged block starts at left
+    FreeListBlock *merged = (FreeListBlock *)((unsigned char *)left - FREELIST_HEADER_SIZE);
+    ASSERT(!(merged->size & FREELIST_IN_USE));
+    ASSERT_EQ(merged->size & ~FREELIST_FLAGS, 3 * 72);
+
+    // A request spanning all three now fits in place
+    ASSERT_EQ(freelist_alloc(&a, 3 * 72 - FREELIST_HEADER_SIZE), left);
+
+    freelist_free(&a, guard);
+    return 1;
+}
+
+// Test: in-use flags track neighbors through alloc and free
+TEST(boundary_flags_track_neighbors) {
+    FreeListAllocator a;
+    freelist_init(&a, region, sizeof(region));
+
+    unsigned char *ptr1 = freelist_alloc(&a, 64);
+    unsigned char *ptr2 = freelist_alloc(&a, 64);
+    FreeListBlock *block2 = (FreeListBlock *)(ptr2 - FREELIST_HEADER_SIZE);
+
+    ASSERT(block2->size & FREELIST_IN_USE);
+    ASSERT(block2->size & FREELIST_PREV_IN_USE);
+
+    freelist_free(&a, ptr1);
+    ASSERT(!(block2->size & FREELIST_PREV_IN_USE));
+
+    ASSERT_EQ(freelist_alloc(&a, 64), ptr1);
+    ASSERT(block2->size & FREELIST_PREV_IN_USE);
+    return 1;
+}
+
+// Test: double free is ignored
+TEST(double_free_ignored) {
+    FreeListAllocator a;
+    freelist_init(&a, region, sizeof(region));
+
+    void *ptr = freelist_alloc(&a, 64);
+    freelist_alloc(&a, 64);
+    size_t used = freelist_used(&a);
+
+    freelist_free(&a, ptr);
+    freelist_free(&a, ptr);
+
+    ASSERT_EQ(freelist_used(&a), used - 72);
+    return 1;
+}
+
+// Test: double free is ignored after the block merged into a free previous neighbor
+TEST(double_free_after_backward_merge) {
+    FreeListAllocator a;
+    freelist_init(&a, region, sizeof(region));
+
+    void *x = freelist_alloc(&a, 64);
+    void *y = freelist_alloc(&a, 64);
+    void *z = freelist_alloc(&a, 64);
+    freelist_free(&a, x);
+    freelist_free(&a, y);
+    size_t used = freelist_used(&a);
+    size_t largest = freelist_largest_free(&a);
+
+    freelist_free(&a, y);
+    ASSERT_EQ(freelist_used(&a), used);
+    ASSERT_EQ(freelist_largest_free(&a), largest);
+
+    // z is still live; freeing it folds everything back into one block
+    ASSERT_EQ(freelist_used(&a), 72);
+    freelist_free(&a, z);
+    ASSERT_EQ(freelist_used(&a), 0);
+    ASSERT_EQ(freelist_fragmentation(&a), 0.0);
+    return 1;
+}
+
+// Test: region too small for a block yields an empty allocator
+TEST(init_tiny_region) {
+    FreeListAllocator a;
+    freelist_init(&a, region, FREELIST_MIN_BLOCK);
+
+    ASSERT_EQ(freelist_free_bytes(&a), 0);
+    ASSERT_NULL(freelist_alloc(&a, 8));
+    return 1;
+}
+
+// Test: lookup finds a fitting block among many small fragments
+TEST(good_fit_skips_small_fragments) {
+    FreeListAllocator a;
+    freelist_init(&a, region, sizeof(region));
+
+    // Alternate 40-byte holes with live blocks, then leave one 600-byte hole
+    void *holes[16];
+    for (int i = 0; i < 16; i++) {
+        holes[i] = freelist_alloc(&a, 32);
+        freelist_alloc(&a, 32);
+    }
+    void *big = freelist_alloc(&a, 600);
+    freelist_alloc(&a, 32);
+
+    // Exhaust the tail so only the holes remain
+    while (freelist_alloc(&a, 8) != NULL) {
+    }
+    for (int i = 0; i < 16; i++) {
+        freelist_free(&a, holes[i]);
+    }
+    freelist_free(&a, big);
+
+    ASSERT_EQ(freelist_alloc(&a, 500), big);
+    return 1;
+}
+
+// Test: every size maps to a bin whose blocks are large enough
+TEST(bins_cover_all_sizes) {
+    FreeListAllocator a;
+    freelist_init(&a, region, sizeof(region));
+
+    for (size_t size = 1; size < 3000; size += 7) {
+        unsigned char *ptr = freelist_alloc(&a, size);
+        ASSERT_NOT_NULL(ptr);
+        FreeListBlock *block = (FreeListBlock *)(ptr - FREELIST_HEADER_SIZE);
+        ASSERT((block->size & ~FREELIST_FLAGS) >= size + FREELIST_HEADER_SIZE);
+        freelist_free(&a, ptr);
+    }
+    ASSERT_EQ(freelist_used(&a), 0);
+    return 1;
+}
+
+// Test: fragmentation metric reflects scattered free space
+TEST(fragmentation_metric) {
+    FreeListAllocator a;
+    freelist_init(&a, region, sizeof(region));
+
+    ASSERT(freelist_fragmentation(&a) == 0.0);
+
+    void *ptrs[8];
+    for (int i = 0; i < 8; i++) {
+        ptrs[i] = freelist_alloc(&a, 200);
+    }
+    while (freelist_alloc(&a, 8) != NULL) {
+    }
+    ASSERT_EQ(freelist_free_bytes(&a), 0);
+
+    // Four separate 208-byte holes: largest is a quarter of the free space
+    for (int i = 0; i < 8; i += 2) {
+        freelist_free(&a, ptrs[i]);
+    }
+    ASSERT_EQ(freelist_largest_free(&a), 208);
+    ASSERT(freelist_fragmentation(&a) > 0.74 && freelist_fragmentation(&a) < 0.76);
+
+    // Closing the gaps merges everything into one block
+    for (int i = 1; i < 8; i += 2) {
+        freelist_free(&a, ptrs[i]);
+    }
+    ASSERT(freelist_fragmentation(&a) == 0.0);
+    return 1;
+}
+
+int main(void) {
+    printf("\n");
+    printf("╔════════════════════════════════════════════════════╗\n");
+    printf("║     Free List Allocator Test Suite                 ║\n");
+    printf("╚════════════════════════════════════════════════════╝\n\n");
+
+    printf("▸ Allocation Tests\n");
+    RUN_TEST(init_single_free_block);
+    RUN_TEST(alloc_accounts_header);
+    RUN_TEST(allocs_do_not_overlap);
+    RUN_TEST(alloc_fails_when_exhausted);
+
+    printf("\n▸ Free Tests\n");
+    RUN_TEST(free_coalesces_all);
+    RUN_TEST(free_allows_reuse);
+    RUN_TEST(free_merges_both_neighbors);
+    RUN_TEST(boundary_flags_track_neighbors);
+    RUN_TEST(double_free_ignored);
+    RUN_TEST(double_free_after_backward_merge);
+    RUN_TEST(init_tiny_region);
+
+    printf("\n▸ Binning Tests\n");
+    RUN_TEST(good_fit_skips_small_fragments);
+    RUN_TEST(bins_cover_all_sizes);
+    RUN_TEST(fragmentation_metric);
+    RUN_TEST(handles_null);
+
+    return test_summary();
+}
@@ -0,0 +1,112 @@
+/*
+ * Test suite for the inline-storage arena template
+ */
+
+#include <cstdint>
+#include <cstring>
+#include "../src/inline_arena.hpp"
+#include "test_framework.h"
+
+using simple_memory::InlineArena;
+
+template <std::size_t N, std::size_t A>
+static bool in_inline(const InlineArena<N, A> &arena, const void *ptr) {
+    const unsigned char *base = reinterpret_cast<const unsigned char *>(&arena);
+    const unsigned char *p = static_cast<const unsigned char *>(ptr);
+    return p >= base && p < base + sizeof(arena);
+}
+
+struct Point {
+    Point(int x_, int y_) : x(x_), y(y_) {}
+    int x;
+    int y;
+};
+
+// Test: allocations come from the inline buffer without touching the heap
+TEST(inline_storage_serves_small_allocations) {
+    InlineArena<256> arena;
+    static_assert(InlineArena<256>::capacity() == 256, "capacity is a constant");
+
+    void *a = arena.alloc(10);
+    void *b = arena.alloc<24>();
+    ASSERT(in_inline(arena, a));
+    ASSERT(in_inline(arena, b));
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(a) % alignof(std::max_align_t), 0);
+    ASSERT(!arena.overflowed());
+    ASSERT(arena.used() >= 40);
+
+    std::memset(a, 0xAB, 10);
+    std::memset(b, 0xCD, 24);
+    ASSERT_EQ(static_cast<unsigned char *>(a)[9], 0xAB);
+    return 1;
+}
+
+// Test: compile-time alignment is honored, including over-aligned requests
+TEST(compile_time_alignment) {
+    InlineArena<512, 16> arena;
+
+    ASSERT_NOT_NULL(arena.alloc<1>());
+    void *aligned16 = arena.alloc<8, 16>();
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(aligned16) % 16, 0);
+    void *aligned64 = arena.alloc<8, 64>();
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(aligned64) % 64, 0);
+    ASSERT(in_inline(arena, aligned64));
+
+    void *runtime = arena.alloc_aligned(8, 128);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(runtime) % 128, 0);
+    ASSERT_NULL(arena.alloc_aligned(8, 24));
+    ASSERT_NULL(arena.alloc(0));
+    return 1;
+}
+
+// Test: create<T> constructs objects in place
+TEST(create_constructs_objects) {
+    InlineArena<64> arena;
+
+    Point *p = arena.create<Point>(3, 4);
+    ASSERT_NOT_NULL(p);
+    ASSERT(in_inline(arena, p));
+    ASSERT_EQ(p->x, 3);
+    ASSERT_EQ(p->y, 4);
+    return 1;
+}
+
+// Test: overflow spills to the heap arena and reset rewinds both
+TEST(overflow_falls_back_to_heap) {
+    InlineArena<64> arena;
+
+    void *inline_ptr = arena.alloc<48>();
+    ASSERT(in_inline(arena, inline_ptr));
+    void *spilled = arena.alloc<32>();
+    ASSERT_NOT_NULL(spilled);
+    ASSERT(!in_inline(arena, spilled));
+    ASSERT(arena.overflowed());
+
+    // Larger than the inline buffer and the first overflow block
+    void *large = arena.alloc(4096);
+    ASSERT_NOT_NULL(large);
+    std::memset(large, 0, 4096);
+
+    arena.reset();
+    ASSERT_EQ(arena.used(), 0);
+    void *again = arena.alloc<48>();
+    ASSERT_EQ(again, inline_ptr);
+    return 1;
+}
+
+int main(void) {
+    printf("\n");
+    printf("╔════════════════════════════════════════════════════╗\n");
+    printf("║     Inline Arena Test Suite                        ║\n");
+    printf("╚════════════════════════════════════════════════════╝\n\n");
+
+    printf("▸ Inline Storage Tests\n");
+    RUN_TEST(inline_storage_serves_small_allocations);
+    RUN_TEST(compile_time_alignment);
+    RUN_TEST(create_constructs_objects);
+
+    printf("\n▸ Overflow Tests\n");
+    RUN_TEST(overflow_falls_back_to_heap);
+
+    return test_summary();
+}
@@ -0,0 +1,272 @@
+/*
+ * Test suite for debug guard mode (red zones and poisoning)
+ *
+ * Built with -DSIMPLE_MEMORY_ALLOCATOR_GUARD on every translation unit,
+ * once under AddressSanitizer and once without it (byte patterns).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "../src/simple_memory_allocator.h"
+#include "../src/pool_allocator.h"
+#include "../src/concurrent_memory_allocator.h"
+#include "../src/memory_guard.h"
+#include "test_framework.h"
+
+#ifndef SIMPLE_MEMORY_ALLOCATOR_GUARD
+#error "test_memory_guard must be built with -DSIMPLE_MEMORY_ALLOCATOR_GUARD"
+#endif
+
+#define RED_ZONE SIMPLE_MEMORY_GUARD_RED_ZONE
+
+// Dead memory is poisoned under ASan and holds `pattern` otherwise
+static int is_dead(const void *addr, size_t size, int pattern) {
+    const unsigned char *bytes = addr;
+    for (size_t i = 0; i < size; i++) {
+#ifdef MEMORY_GUARD_ASAN
+        (void)pattern;
+        if (!__asan_address_is_poisoned(bytes + i)) {
+            return 0;
+        }
+#else
+        if (bytes[i] != (unsigned char)pattern) {
+            return 0;
+        }
+#endif
+    }
+    return 1;
+}
+
+static int is_live(const void *addr, size_t size) {
+#ifdef MEMORY_GUARD_ASAN
+    return __asan_region_is_poisoned((void *)addr, size) == NULL;
+#else
+    (void)addr;
+    (void)size;
+    return 1;
+#endif
+}
+
+// Run `fn` in a child with stderr silenced; true if the child was stopped
+static int child_is_stopped(void (*fn)(void)) {
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0) {
+        freopen("/dev/null", "w", stderr);
+        fn();
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return !(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+}
+
+// Test: every allocation is followed by a poisoned red zone
+TEST(red_zones_separate_allocations) {
+    SimpleMemoryAllocator arena;
+    simple_memory_allocator_init(&arena);
+    simple_memory_allocator_create(&arena, 4096);
+
+    unsigned char *a = simple_memory_allocator_alloc(&arena, 20);
+    unsigned char *b = simple_memory_allocator_alloc(&arena, 8);
+    ASSERT(b >= a + 20 + RED_ZONE);
+    ASSERT(is_live(a, 20));
+    ASSERT(is_dead(a + 20, RED_ZONE, MEMORY_GUARD_RED_ZONE_BYTE));
+    ASSERT(is_live(b, 8));
+    memset(a, 0x11, 20);
+    memset(b, 0x22, 8);
+
+    // Batches get a zone per object
+    void *batch[3];
+    ASSERT_EQ(simple_memory_allocator_alloc_batch(&arena, 12, 3, batch), 3);
+    for (int i = 0; i < 3; i++) {
+        ASSERT(is_live(batch[i], 12));
+        ASSERT(is_dead((unsigned char *)batch[i] + 12, RED_ZONE, MEMORY_GUARD_RED_ZONE_BYTE));
+    }
+
+    // The red zones are still intact when the next allocation checks them
+    ASSERT_NOT_NULL(simple_memory_allocator_alloc_aligned(&arena, 8, 64));
+    simple_memory_allocator_destroy(&arena);
+    return 1;
+}
+
+// Test: the unused tail and everything a reset gives back are dead
+TEST(tail_and_reset_are_poisoned) {
+    SimpleMemoryAllocator arena;
+    simple_memory_allocator_init(&arena);
+    simple_memory_allocator_create(&arena, 4096);
+
+    unsigned char *a = simple_memory_allocator_alloc(&arena, 64);
+    memset(a, 0x33, 64);
+#ifdef MEMORY_GUARD_ASAN
+    ASSERT(is_dead((unsigned char *)arena.memory + arena.used, arena.size - arena.used, 0));
+#endif
+
+    simple_memory_allocator_reset(&arena);
+    ASSERT(is_dead(a, 64, MEMORY_GUARD_FREED_BYTE));
+
+    // Memory handed out again is live
+    ASSERT_EQ(simple_memory_allocator_alloc(&arena, 32), a);
+    ASSERT(is_live(a, 32));
+    simple_memory_allocator_destroy(&arena);
+    return 1;
+}
+
+// Test: in-place resizes move the red zone with the end of the allocation
+TEST(resize_moves_red_zone) {
+    SimpleMemoryAllocator arena;
+    simple_memory_allocator_init(&arena);
+    simple_memory_allocator_create(&arena, 4096);
+
+    unsigned char *a = simple_memory_allocator_alloc(&arena, 16);
+    memset(a, 0x44, 16);
+    ASSERT_EQ(simple_memory_allocator_realloc(&arena, a, 16, 40), a);
+    ASSERT(is_live(a, 40));
+    ASSERT(is_dead(a + 40, RED_ZONE, MEMORY_GUARD_RED_ZONE_BYTE));
+    memset(a, 0x44, 40);
+
+    ASSERT_EQ(simple_memory_allocator_shrink_last(&arena, a, 40, 8), 0);
+    ASSERT(is_dead(a + 8, RED_ZONE, MEMORY_GUARD_RED_ZONE_BYTE));
+    ASSERT_EQ(simple_memory_allocator_alloc(&arena, 8), a + 8 + RED_ZONE);
+    simple_memory_allocator_destroy(&arena);
+    return 1;
+}
+
+// Test: rolling back to a marker poisons what was rolled back
+TEST(free_to_marker_poisons_rolled_back) {
+    SimpleMemoryAllocator arena;
+    simple_memory_allocator_init(&arena);
+    SimpleMemoryAllocatorOptions options = {.growable = 1};
+    simple_memory_allocator_create_with_options(&arena, 256, &options);
+
+    unsigned char *kept = simple_memory_allocator_alloc(&arena, 32);
+    SimpleMemoryMarker marker = simple_memory_allocator_get_marker(&arena);
+    unsigned char *dropped = simple_memory_allocator_alloc(&arena, 64);
+    memset(dropped, 0x55, 64);
+    unsigned char *chained = simple_memory_allocator_alloc(&arena, 400);  // Forces a second block
+    memset(chained, 0x66, 400);
+
+    ASSERT_EQ(simple_memory_allocator_free_to_marker(&arena, marker), 0);
+    ASSERT(is_live(kept, 32));
+    ASSERT(is_dead(dropped, 64, MEMORY_GUARD_FREED_BYTE));
+    ASSERT(is_dead(chained, 400, MEMORY_GUARD_FREED_BYTE));  // Kept warm as the spare
+
+    simple_memory_allocator_destroy(&arena);
+    return 1;
+}
+
+static void overflow_into_red_zone(void) {
+    SimpleMemoryAllocator arena;
+    simple_memory_allocator_init(&arena);
+    simple_memory_allocator_create(&arena, 4096);
+    unsigned char *a = simple_memory_allocator_alloc(&arena, 24);
+    memset(a, 0, 25);                      // One byte too many
+    simple_memory_allocator_alloc(&arena, 8);  // Pattern builds notice here
+    simple_memory_allocator_destroy(&arena);
+}
+
+static void stay_in_bounds(void) {
+    SimpleMemoryAllocator arena;
+    simple_memory_allocator_init(&arena);
+    simple_memory_allocator_create(&arena, 4096);
+    unsigned char *a = simple_memory_allocator_alloc(&arena, 24);
+    memset(a, 0, 24);
+    simple_memory_allocator_alloc(&arena, 8);
+    simple_memory_allocator_destroy(&arena);
+}
+
+// Test: an overrun into the next bump allocation stops the process
+TEST(overflow_is_caught) {
+    ASSERT(!child_is_stopped(stay_in_bounds));
+    ASSERT(child_is_stopped(overflow_into_red_zone));
+    return 1;
+}
+
+// Test: freed pool blocks are poisoned past their link and reopened on reuse
+TEST(pool_freed_blocks_poisoned) {
+    PoolAllocator pool;
+    pool_allocator_init(&pool);
+    pool_allocator_create(&pool, 48, 4);
+
+    unsigned char *a = pool_allocator_alloc(&pool);
+    ASSERT(is_live(a, 48));
+    memset(a, 0x77, 48);
+    pool_allocator_free(&pool, a);
+    ASSERT(is_live(a, sizeof(PoolFreeBlock)));
+    ASSERT(is_dead(a + sizeof(PoolFreeBlock), 48 - sizeof(PoolFreeBlock), MEMORY_GUARD_FREED_BYTE));
+
+    ASSERT_EQ(pool_allocator_alloc(&pool), a);
+    ASSERT(is_live(a, 48));
+    memset(a, 0x77, 48);
+
+    void *batch[2];
+    pool_allocator_free(&pool, a);
+    ASSERT_EQ(pool_allocator_alloc_batch(&pool, 2, batch), 2);
+    ASSERT(is_live(batch[0], 48) && is_live(batch[1], 48));
+
+    pool_allocator_reset(&pool);
+    ASSERT(is_dead(a, 48, MEMORY_GUARD_FREED_BYTE));
+    pool_allocator_destroy(&pool);
+    return 1;
+}
+
+static void write_after_free(void) {
+    PoolAllocator pool;
+    pool_allocator_init(&pool);
+    pool_allocator_create(&pool, 32, 2);
+    unsigned char *a = pool_allocator_alloc(&pool);
+    pool_allocator_free(&pool, a);
+    a[20] = 1;                  // Stale pointer
+    pool_allocator_alloc(&pool);  // Pattern builds notice here
+    pool_allocator_destroy(&pool);
+}
+
+// Test: writing a freed pool block stops the process
+TEST(pool_write_after_free_is_caught) {
+    ASSERT(child_is_stopped(write_after_free));
+    return 1;
+}
+
+// Test: allocators that carve a SimpleMemoryAllocator block directly still work
+TEST(concurrent_arena_stays_usable) {
+    ConcurrentMemoryAllocator arena;
+    concurrent_memory_allocator_init(&arena);
+    concurrent_memory_allocator_create(&arena, 4096);
+    unsigned char *a = concurrent_memory_allocator_alloc(&arena, 128);
+    ASSERT_NOT_NULL(a);
+    ASSERT(is_live(a, 128));
+    memset(a, 0x88, 128);
+    concurrent_memory_allocator_destroy(&arena);
+    return 1;
+}
+
+int main(void) {
+    printf("\n");
+    printf("╔════════════════════════════════════════════════════╗\n");
+    printf("║     Memory Guard Test Suite (%s)       ║\n",
+#ifdef MEMORY_GUARD_ASAN
+           "ASan poisoning   "
+#else
+           "byte patterns    "
+#endif
+    );
+    printf("╚════════════════════════════════════════════════════╝\n\n");
+
+    printf("▸ Arena Tests\n");
+    RUN_TEST(red_zones_separate_allocations);
+    RUN_TEST(tail_and_reset_are_poisoned);
+    RUN_TEST(resize_moves_red_zone);
+    RUN_TEST(free_to_marker_poisons_rolled_back);
+    RUN_TEST(overflow_is_caught);
+
+    printf("\n▸ Pool Tests\n");
+    RUN_TEST(pool_freed_blocks_poisoned);
+    RUN_TEST(pool_write_after_free_is_caught);
+    RUN_TEST(concurrent_arena_stays_usable);
+
+    return test_summary();
+}
@@ -0,0 +1,203 @@
+/*
+ * Test suite for the C++ memory_resource adapters
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../src/memory_resource.hpp"
+#include "test_framework.h"
+
+using simple_memory::ArenaAllocator;
+using simple_memory::ArenaResource;
+using simple_memory::PoolResource;
+
+static void *volatile sink;
+
+static bool in_arena(const SimpleMemoryAllocator &arena, const void *ptr) {
+    const unsigned char *base = static_cast<const unsigned char *>(arena.memory);
+    const unsigned char *p = static_cast<const unsigned char *>(ptr);
+    return p >= base && p < base + arena.size;
+}
+
+// Test: pmr containers allocate from the arena
+TEST(arena_backs_pmr_containers) {
+    SimpleMemoryAllocator arena;
+    simple_memory_allocator_init(&arena);
+    simple_memory_allocator_create(&arena, 64 * 1024);
+    ArenaResource resource(&arena);
+
+    {
+        std::pmr::vector<int> values(&resource);
+        for (int i = 0; i < 100; i++) {
+            values.push_back(i);
+        }
+        ASSERT(in_arena(arena, values.data()));
+
+        std::pmr::string text("a string long enough to skip the small buffer", &resource);
+        ASSERT(in_arena(arena, text.data()));
+
+        std::pmr::unordered_map<int, int> map(&resource);
+        map[1] = 2;
+        ASSERT_EQ(map.at(1), 2);
+    }
+    ASSERT(arena.used > 0);
+
+    simple_memory_allocator_destroy(&arena);
+    return 1;
+}
+
+// Test: alignment is honored and exhaustion throws bad_alloc
+TEST(arena_alignment_and_exhaustion) {
+    SimpleMemoryAllocator arena;
+    simple_memory_allocator_init(&arena);
+    simple_memory_allocator_create(&arena, 1024);
+    ArenaResource resource(&arena);
+
+    void *ptr = resource.allocate(10, 256);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % 256, 0);
+    ASSERT_NOT_NULL(resource.allocate(0, 8));
+
+    bool threw = false;
+    try {
+        sink = resource.allocate(4096, 8);
+    } catch (const std::bad_alloc &) {
+        threw = true;
+    }
+    ASSERT(threw);
+
+    ArenaResource same(&arena);
+    std::pmr::monotonic_buffer_resource other;
+    ASSERT(resource.is_equal(same));
+    ASSERT(!resource.is_equal(other));
+
+    simple_memory_allocator_destroy(&arena);
+    return 1;
+}
+
+// Test: fitting requests come from the pool, others from upstream
+TEST(pool_resource_routes_by_size) {
+    PoolAllocator pool;
+    pool_allocator_init(&pool);
+    pool_allocator_create(&pool, 32, 4);
+    PoolResource resource(&pool);
+
+    void *small = resource.allocate(24, 8);
+    ASSERT(pool_allocator_owns(&pool, small));
+    void *large = resource.allocate(100, 8);
+    ASSERT(!pool_allocator_owns(&pool, large));
+    void *overaligned = resource.allocate(16, 64);
+    ASSERT(!pool_allocator_owns(&pool, overaligned));
+
+    resource.deallocate(small, 24, 8);
+    resource.deallocate(large, 100, 8);
+    resource.deallocate(overaligned, 16, 64);
+    ASSERT_EQ(pool_allocator_used(&pool), 0);
+
+    // Exhaustion spills to upstream instead of failing
+    void *blocks[5];
+    for (int i = 0; i < 5; i++) {
+        blocks[i] = resource.allocate(32, 8);
+    }
+    ASSERT(!pool_allocator_owns(&pool, blocks[4]));
+    for (int i = 0; i < 5; i++) {
+        resource.deallocate(blocks[i], 32, 8);
+    }
+    ASSERT_EQ(pool_allocator_used(&pool), 0);
+
+    pool_allocator_destroy(&pool);
+    return 1;
+}
+
+// Test: a pool on weakly aligned caller memory never serves stricter alignments
+TEST(pool_resource_respects_base_alignment) {
+    alignas(64) static unsigned char memory[8 + 32 * 4];
+    PoolAllocator pool;
+    pool_allocator_init(&pool);
+    ASSERT_EQ(pool_allocator_create_from(&pool, memory + 8, 32, 4), 0);
+    PoolResource resource(&pool);
+
+    void *aligned8 = resource.allocate(16, 8);
+    ASSERT(pool_allocator_owns(&pool, aligned8));
+    void *aligned16 = resource.allocate(16, 16);
+    ASSERT(!pool_allocator_owns(&pool, aligned16));
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(aligned16) % 16, 0);
+
+    resource.deallocate(aligned8, 16, 8);
+    resource.deallocate(aligned16, 16, 16);
+    ASSERT_EQ(pool_allocator_used(&pool), 0);
+    return 1;
+}
+
+// Test: node-based pmr container recycles pool blocks
+TEST(pool_resource_backs_map) {
+    PoolAllocator pool;
+    pool_allocator_init(&pool);
+    pool_allocator_create(&pool, 64, 256);
+    PoolResource resource(&pool);
+
+    {
+        std::pmr::map<int, int> map(&resource);
+        for (int i = 0; i < 100; i++) {
+            map[i] = i;
+        }
+        ASSERT_EQ(pool_allocator_used(&pool), 100);
+    }
+    ASSERT_EQ(pool_allocator_used(&pool), 0);
+
+    pool_allocator_destroy(&pool);
+    return 1;
+}
+
+// Test: STL allocator works with standard containers and rebinding
+TEST(arena_allocator_std_containers) {
+    SimpleMemoryAllocator arena;
+    simple_memory_allocator_init(&arena);
+    simple_memory_allocator_create(&arena, 64 * 1024);
+
+    ArenaAllocator<int> ints(&arena);
+    {
+        std::vector<int, ArenaAllocator<int>> values(ints);
+        values.assign(50, 7);
+        ASSERT(in_arena(arena, values.data()));
+
+        using Pair = std::pair<const int, double>;
+        ArenaAllocator<Pair> pairs(ints);
+        std::map<int, double, std::less<int>, ArenaAllocator<Pair>> map(pairs);
+        map[3] = 1.5;
+        ASSERT_EQ(map.at(3), 1.5);
+    }
+
+    ArenaAllocator<double> doubles(ints);
+    ASSERT(doubles == ints);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(doubles.allocate(3)) % alignof(double), 0);
+
+    simple_memory_allocator_destroy(&arena);
+    return 1;
+}
+
+int main(void) {
+    printf("\n");
+    printf("╔════════════════════════════════════════════════════╗\n");
+    printf("║     C++ Memory Resource Test Suite                 ║\n");
+    printf("╚════════════════════════════════════════════════════╝\n\n");
+
+    printf("▸ Arena Resource Tests\n");
+    RUN_TEST(arena_backs_pmr_containers);
+    RUN_TEST(arena_alignment_and_exhaustion);
+
+    printf("\n▸ Pool Resource Tests\n");
+    RUN_TEST(pool_resource_routes_by_size);
+    RUN_TEST(pool_resource_respects_base_alignment);
+    RUN_TEST(pool_resource_backs_map);
+
+    printf("\n▸ STL Allocator Tests\n");
+    RUN_TEST(arena_allocator_std_containers);
+
+    return test_summary();
+}
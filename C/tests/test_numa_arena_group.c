@@ -0,0 +1,181 @@
+/*
+ * Test suite for numa_arena_group
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "../src/numa_arena_group.h"
+#include "test_framework.h"
+
+#define THREAD_COUNT      4
+#define ALLOCS_PER_THREAD 2000
+
+static int in_arena(const ConcurrentMemoryAllocator *arena, const void *ptr) {
+    const unsigned char *p = ptr;
+    return arena->base != NULL && p >= arena->base && p < arena->base + arena->capacity;
+}
+
+// Node whose arena owns ptr, -1 if none
+static int owner_node(const NumaArenaGroup *group, const void *ptr) {
+    for (int node = 0; node < NUMA_ARENA_GROUP_MAX_NODES; node++) {
+        if (group->online[node] && in_arena(&group->nodes[node], ptr)) {
+            return node;
+        }
+    }
+    return -1;
+}
+
+// Test: create builds an mmap arena for every online node
+TEST(create_one_arena_per_node) {
+    NumaArenaGroup group;
+    numa_arena_group_init(&group);
+
+    ASSERT_EQ(numa_arena_group_create(&group, 0, NULL), -1);
+    ASSERT_EQ(numa_arena_group_create(&group, 1024 * 1024, NULL), 0);
+    ASSERT(group.node_count >= 1);
+
+    int online = 0;
+    for (int node = 0; node < NUMA_ARENA_GROUP_MAX_NODES; node++) {
+        if (group.online[node]) {
+            online++;
+            ASSERT_NOT_NULL(group.nodes[node].base);
+            ASSERT_EQ(group.nodes[node].pool.options.backing, SIMPLE_MEMORY_BACKING_MMAP);
+        } else {
+            ASSERT_NULL(group.nodes[node].base);
+        }
+    }
+    ASSERT_EQ(online, group.node_count);
+
+    numa_arena_group_destroy(&group);
+    ASSERT_EQ(group.node_count, 0);
+    return 1;
+}
+
+// Test: allocations land on the calling thread's node
+TEST(alloc_routes_to_local_node) {
+    NumaArenaGroup group;
+    numa_arena_group_init(&group);
+    numa_arena_group_create(&group, 1024 * 1024, NULL);
+
+    int node = numa_arena_group_current_node();
+    void *ptr = numa_arena_group_alloc(&group, 64);
+    ASSERT_NOT_NULL(ptr);
+    ASSERT_EQ(owner_node(&group, ptr), node);
+
+    // Explicit and offline node ids
+    void *explicit_ptr = numa_arena_group_alloc_on(&group, group.first_node, 64);
+    ASSERT_EQ(owner_node(&group, explicit_ptr), group.first_node);
+    void *fallback = numa_arena_group_alloc_on(&group, NUMA_ARENA_GROUP_MAX_NODES + 5, 64);
+    ASSERT_EQ(owner_node(&group, fallback), group.first_node);
+
+    numa_arena_group_reset(&group);
+    ASSERT_EQ(concurrent_memory_allocator_used(numa_arena_group_node(&group, node)), 0);
+
+    numa_arena_group_destroy(&group);
+    return 1;
+}
+
+// Test: thread cache refills from the local node
+TEST(thread_cache_refills_locally) {
+    NumaArenaGroup group;
+    numa_arena_group_init(&group);
+    numa_arena_group_create(&group, 1024 * 1024, NULL);
+    NumaThreadCache cache;
+    numa_thread_cache_init(&cache, &group, 1024);
+
+    int node = numa_arena_group_current_node();
+    uint8_t *first = numa_thread_cache_alloc(&cache, 100);
+    uint8_t *second = numa_thread_cache_alloc(&cache, 8);
+    ASSERT_NOT_NULL(first);
+    ASSERT_EQ(cache.node, node);
+    ASSERT_EQ(owner_node(&group, first), node);
+    ASSERT_EQ(second, first + 104);
+    ASSERT_EQ(concurrent_memory_allocator_used(&group.nodes[node]), 1024);
+
+    numa_thread_cache_reset(&cache);
+    ASSERT_EQ(cache.node, -1);
+    ASSERT_NOT_NULL(numa_thread_cache_alloc(&cache, 8));
+    ASSERT_EQ(concurrent_memory_allocator_used(&group.nodes[node]), 2048);
+
+    numa_arena_group_destroy(&group);
+    return 1;
+}
+
+typedef struct {
+    NumaArenaGroup *group;
+    void *ptrs[ALLOCS_PER_THREAD];
+} WorkerArgs;
+
+static void *cache_worker(void *arg) {
+    WorkerArgs *args = arg;
+    NumaThreadCache cache;
+    numa_thread_cache_init(&cache, args->group, 4096);
+    for (int i = 0; i < ALLOCS_PER_THREAD; i++) {
+        args->ptrs[i] = numa_thread_cache_alloc(&cache, 32);
+        if (args->ptrs[i] != NULL) {
+            *(int *)args->ptrs[i] = i;
+        }
+    }
+    return NULL;
+}
+
+// Test: concurrent caches hand out distinct memory from online nodes
+TEST(concurrent_caches_do_not_overlap) {
+    NumaArenaGroup group;
+    numa_arena_group_init(&group);
+    numa_arena_group_create(&group, 4 * 1024 * 1024, NULL);
+
+    static WorkerArgs args[THREAD_COUNT];
+    pthread_t threads[THREAD_COUNT];
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        args[t].group = &group;
+        pthread_create(&threads[t], NULL, cache_worker, &args[t]);
+    }
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        for (int i = 0; i < ALLOCS_PER_THREAD; i++) {
+            ASSERT_NOT_NULL(args[t].ptrs[i]);
+            ASSERT(owner_node(&group, args[t].ptrs[i]) >= 0);
+            ASSERT_EQ(*(int *)args[t].ptrs[i], i);
+        }
+    }
+
+    numa_arena_group_destroy(&group);
+    return 1;
+}
+
+// Test: CPU lookup and NULL handling
+TEST(handles_null_and_unknown_nodes) {
+    ASSERT_EQ(numa_arena_group_node_cpu(NUMA_ARENA_GROUP_MAX_NODES * 100), -1);
+    ASSERT(numa_arena_group_current_node() >= 0);
+    ASSERT_NULL(numa_arena_group_node(NULL, 0));
+    ASSERT_NULL(numa_arena_group_alloc(NULL, 8));
+    ASSERT_EQ(numa_arena_group_create(NULL, 1024, NULL), -1);
+    numa_arena_group_reset(NULL);
+    numa_arena_group_destroy(NULL);
+    ASSERT_NULL(numa_thread_cache_alloc_slow(NULL, 8));
+    return 1;
+}
+
+int main(void) {
+    printf("\n");
+    printf("╔════════════════════════════════════════════════════╗\n");
+    printf("║     NUMA Arena Group Test Suite                    ║\n");
+    printf("╚════════════════════════════════════════════════════╝\n\n");
+
+    printf("▸ Creation Tests\n");
+    RUN_TEST(create_one_arena_per_node);
+
+    printf("\n▸ Routing Tests\n");
+    RUN_TEST(alloc_routes_to_local_node);
+    RUN_TEST(thread_cache_refills_locally);
+    RUN_TEST(concurrent_caches_do_not_overlap);
+    RUN_TEST(handles_null_and_unknown_nodes);
+
+    return test_summary();
+}
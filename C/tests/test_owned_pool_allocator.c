@@ -0,0 +1,205 @@
+/*
+ * Test suite for owned_pool_allocator
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include "../src/owned_pool_allocator.h"
+#include "test_framework.h"
+
+#define THREAD_COUNT 4
+#define PER_THREAD   5000
+
+// Test: the owner allocates and frees through the plain pool path
+TEST(local_alloc_free) {
+    OwnedPoolAllocator pool;
+    owned_pool_allocator_init(&pool);
+    ASSERT_EQ(owned_pool_allocator_create(&pool, 32, 4), 0);
+    ASSERT(pthread_equal(pool.owner, pthread_self()));
+
+    void *a = owned_pool_allocator_alloc(&pool);
+    void *b = owned_pool_allocator_alloc(&pool);
+    ASSERT_EQ(a, (void *)pool.pool.memory);
+    ASSERT_EQ(owned_pool_allocator_used(&pool), 2);
+
+    owned_pool_allocator_free(&pool, b);
+    ASSERT_EQ(owned_pool_allocator_alloc(&pool), b);
+    owned_pool_allocator_free(&pool, a);
+    owned_pool_allocator_free(&pool, b);
+    ASSERT_EQ(owned_pool_allocator_used(&pool), 0);
+
+    owned_pool_allocator_destroy(&pool);
+    ASSERT_NULL(pool.pool.memory);
+    return 1;
+}
+
+// Test: remote frees stay queued until the owner misses, then come back as a batch
+TEST(remote_free_drains_on_miss) {
+    OwnedPoolAllocator pool;
+    owned_pool_allocator_init(&pool);
+    owned_pool_allocator_create(&pool, 16, 3);
+
+    void *blocks[3];
+    for (int i = 0; i < 3; i++) {
+        blocks[i] = owned_pool_allocator_alloc(&pool);
+    }
+    owned_pool_allocator_free_remote(&pool, blocks[0]);
+    owned_pool_allocator_free_remote(&pool, blocks[2]);
+    owned_pool_allocator_free_remote(&pool, NULL);
+
+    // Queued blocks are not on the free list yet
+    ASSERT_NULL(pool.pool.free_list);
+    ASSERT_EQ(owned_pool_allocator_used(&pool), 3);
+
+    // The miss drains both; the queue is LIFO
+    ASSERT_EQ(owned_pool_allocator_alloc(&pool), blocks[2]);
+    ASSERT_NULL(pool.remote_frees);
+    ASSERT_EQ(owned_pool_allocator_used(&pool), 2);
+    ASSERT_EQ(owned_pool_allocator_alloc(&pool), blocks[0]);
+    ASSERT_NULL(owned_pool_allocator_alloc(&pool));
+
+    // Explicit drain reports how much it reclaimed
+    owned_pool_allocator_free_remote(&pool, blocks[1]);
+    ASSERT_EQ(owned_pool_allocator_drain(&pool), 1);
+    ASSERT_EQ(owned_pool_allocator_drain(&pool), 0);
+    ASSERT_EQ(owned_pool_allocator_used(&pool), 2);
+
+    owned_pool_allocator_destroy(&pool);
+    return 1;
+}
+
+// Test: remote frees are reused before never-used capacity
+TEST(remote_free_before_fresh) {
+    OwnedPoolAllocator pool;
+    owned_pool_allocator_init(&pool);
+    owned_pool_allocator_create(&pool, 16, 8);
+
+    void *a = owned_pool_allocator_alloc(&pool);
+    owned_pool_allocator_free_remote(&pool, a);
+    ASSERT_EQ(owned_pool_allocator_alloc(&pool), a);
+    ASSERT_NULL(pool.remote_frees);
+    ASSERT_EQ(pool.pool.next_unused, 1);
+    ASSERT_EQ(owned_pool_allocator_used(&pool), 1);
+
+    owned_pool_allocator_destroy(&pool);
+    return 1;
+}
+
+typedef struct {
+    OwnedPoolAllocator *pool;
+    void **blocks;
+    size_t count;
+} RemoteArgs;
+
+static void *free_any_worker(void *arg) {
+    RemoteArgs *args = arg;
+    for (size_t i = 0; i < args->count; i++) {
+        owned_pool_allocator_free_any(args->pool, args->blocks[i]);
+    }
+    return NULL;
+}
+
+// Test: free_any takes the local path on the owner and the queue elsewhere
+TEST(free_any_routes_by_thread) {
+    OwnedPoolAllocator pool;
+    owned_pool_allocator_init(&pool);
+    owned_pool_allocator_create(&pool, 16, 4);
+
+    void *a = owned_pool_allocator_alloc(&pool);
+    void *b = owned_pool_allocator_alloc(&pool);
+    owned_pool_allocator_free_any(&pool, a);
+    ASSERT_EQ((void *)pool.pool.free_list, a);
+    ASSERT_NULL(pool.remote_frees);
+
+    RemoteArgs args = {&pool, &b, 1};
+    pthread_t thread;
+    pthread_create(&thread, NULL, free_any_worker, &args);
+    pthread_join(thread, NULL);
+    ASSERT_EQ((void *)pool.remote_frees, b);
+
+    // After a handoff the same call from this thread goes remote
+    owned_pool_allocator_set_owner(&pool, thread);
+    void *c = pool_allocator_alloc(&pool.pool);
+    owned_pool_allocator_free_any(&pool, c);
+    ASSERT_EQ((void *)pool.remote_frees, c);
+
+    owned_pool_allocator_destroy(&pool);
+    return 1;
+}
+
+// Test: many threads freeing concurrently lose no block
+TEST(concurrent_remote_frees) {
+    OwnedPoolAllocator pool;
+    owned_pool_allocator_init(&pool);
+    owned_pool_allocator_create(&pool, 32, THREAD_COUNT * PER_THREAD);
+
+    void **blocks = malloc(sizeof(void *) * THREAD_COUNT * PER_THREAD);
+    for (size_t i = 0; i < THREAD_COUNT * PER_THREAD; i++) {
+        blocks[i] = owned_pool_allocator_alloc(&pool);
+        memset(blocks[i], 0xAB, 32);
+    }
+    ASSERT_NULL(owned_pool_allocator_alloc(&pool));
+
+    RemoteArgs args[THREAD_COUNT];
+    pthread_t threads[THREAD_COUNT];
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        args[t] = (RemoteArgs){&pool, blocks + (size_t)t * PER_THREAD, PER_THREAD};
+        pthread_create(&threads[t], NULL, free_any_worker, &args[t]);
+    }
+
+    // The owner keeps allocating while the frees land
+    size_t reused = 0;
+    for (int spins = 0; reused < THREAD_COUNT * PER_THREAD && spins < 100000000; spins++) {
+        if (owned_pool_allocator_alloc(&pool) != NULL) {
+            reused++;
+        }
+    }
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    while (owned_pool_allocator_alloc(&pool) != NULL) {
+        reused++;
+    }
+    ASSERT_EQ(reused, THREAD_COUNT * PER_THREAD);
+    ASSERT_EQ(owned_pool_allocator_used(&pool), THREAD_COUNT * PER_THREAD);
+
+    free(blocks);
+    owned_pool_allocator_destroy(&pool);
+    return 1;
+}
+
+// Test: NULL arguments are handled safely
+TEST(handles_null) {
+    int pool_dummy = 0;
+    ASSERT_EQ(owned_pool_allocator_create(NULL, 8, 8), -1);
+    ASSERT_NULL(owned_pool_allocator_alloc_slow(NULL));
+    owned_pool_allocator_free_remote(NULL, &pool_dummy);
+    owned_pool_allocator_free_any(NULL, NULL);
+    ASSERT_EQ(owned_pool_allocator_drain(NULL), 0);
+    ASSERT_EQ(owned_pool_allocator_used(NULL), 0);
+    owned_pool_allocator_set_owner(NULL, pthread_self());
+    owned_pool_allocator_destroy(NULL);
+    return 1;
+}
+
+int main(void) {
+    printf("\n");
+    printf("╔════════════════════════════════════════════════════╗\n");
+    printf("║     Owned Pool Allocator Test Suite                ║\n");
+    printf("╚════════════════════════════════════════════════════╝\n\n");
+
+    printf("▸ Owner Tests\n");
+    RUN_TEST(local_alloc_free);
+
+    printf("\n▸ Remote Free Tests\n");
+    RUN_TEST(remote_free_drains_on_miss);
+    RUN_TEST(remote_free_before_fresh);
+    RUN_TEST(free_any_routes_by_thread);
+    RUN_TEST(concurrent_remote_frees);
+    RUN_TEST(handles_null);
+
+    return test_summary();
+}
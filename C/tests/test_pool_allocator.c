@@ -0,0 +1,256 @@
+/*
+ * Test suite for pool_allocator
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "../src/pool_allocator.h"
+#include "test_framework.h"
+
+// Test: init sets all fields to zero
+TEST(init_zeros_struct) {
+    PoolAllocator pool;
+    pool.memory = (void *)0xDEADBEEF;
+    pool.block_count = 999;
+    pool.next_unused = 999;
+
+    pool_allocator_init(&pool);
+
+    ASSERT_NULL(pool.memory);
+    ASSERT_EQ(pool.block_count, 0);
+    ASSERT_EQ(pool.next_unused, 0);
+    ASSERT_NULL(pool.free_list);
+    return 1;
+}
+
+// Test: create rounds the block size and touches no blocks
+TEST(create_is_lazy) {
+    PoolAllocator pool;
+    pool_allocator_init(&pool);
+
+    ASSERT_EQ(pool_allocator_create(&pool, 13, 1000), 0);
+    ASSERT_EQ(pool.block_size, 16);
+    ASSERT_EQ(pool.next_unused, 0);
+    ASSERT_NULL(pool.free_list);
+    ASSERT_EQ(pool_allocator_available(&pool), 1000);
+
+    pool_allocator_destroy(&pool);
+    ASSERT_NULL(pool.memory);
+    return 1;
+}
+
+// Test: tiny blocks are widened to hold the free-list link
+TEST(create_minimum_block_size) {
+    PoolAllocator pool;
+    pool_allocator_create(&pool, 1, 4);
+
+    ASSERT_EQ(pool.block_size, sizeof(PoolFreeBlock));
+
+    pool_allocator_destroy(&pool);
+    return 1;
+}
+
+// Test: create rejects bad arguments
+TEST(create_fails_bad_args) {
+    PoolAllocator pool;
+    pool_allocator_init(&pool);
+
+    ASSERT_EQ(pool_allocator_create(NULL, 16, 4), -1);
+    ASSERT_EQ(pool_allocator_create(&pool, 0, 4), -1);
+    ASSERT_EQ(pool_allocator_create(&pool, 16, 0), -1);
+    ASSERT_EQ(pool_allocator_create(&pool, SIZE_MAX / 2, 4), -1);
+    ASSERT_EQ(pool_allocator_create_from(&pool, NULL, 16, 4), -1);
+    return 1;
+}
+
+// Test: fresh blocks come out in address order from the high-water mark
+TEST(alloc_bumps_high_water) {
+    PoolAllocator pool;
+    pool_allocator_create(&pool, 32, 4);
+
+    uint8_t *ptr1 = pool_allocator_alloc(&pool);
+    uint8_t *ptr2 = pool_allocator_alloc(&pool);
+
+    ASSERT_EQ(ptr1, pool.memory);
+    ASSERT_EQ(ptr2, ptr1 + 32);
+    ASSERT_EQ(pool.next_unused, 2);
+    ASSERT_EQ(pool_allocator_used(&pool), 2);
+
+    pool_allocator_destroy(&pool);
+    return 1;
+}
+
+// Test: freed blocks are reused before fresh ones
+TEST(free_recycles_lifo) {
+    PoolAllocator pool;
+    pool_allocator_create(&pool, 32, 4);
+
+    void *ptr1 = pool_allocator_alloc(&pool);
+    void *ptr2 = pool_allocator_alloc(&pool);
+    pool_allocator_free(&pool, ptr1);
+    pool_allocator_free(&pool, ptr2);
+
+    ASSERT_EQ(pool_allocator_alloc(&pool), ptr2);
+    ASSERT_EQ(pool_allocator_alloc(&pool), ptr1);
+    ASSERT_EQ(pool.next_unused, 2);
+
+    pool_allocator_destroy(&pool);
+    return 1;
+}
+
+// Test: alloc fails once every block is in use
+TEST(alloc_fails_when_exhausted) {
+    PoolAllocator pool;
+    pool_allocator_create(&pool, 16, 3);
+
+    void *ptrs[3];
+    for (int i = 0; i < 3; i++) {
+        ptrs[i] = pool_allocator_alloc(&pool);
+        ASSERT_NOT_NULL(ptrs[i]);
+    }
+    ASSERT_NULL(pool_allocator_alloc(&pool));
+    ASSERT_EQ(pool_allocator_available(&pool), 0);
+
+    pool_allocator_free(&pool, ptrs[1]);
+    ASSERT_EQ(pool_allocator_alloc(&pool), ptrs[1]);
+
+    pool_allocator_destroy(&pool);
+    return 1;
+}
+
+// Test: batch alloc drains recycled blocks first, then fresh ones
+TEST(alloc_batch_mixes_sources) {
+    PoolAllocator pool;
+    pool_allocator_create(&pool, 16, 6);
+
+    void *a = pool_allocator_alloc(&pool);
+    void *b = pool_allocator_alloc(&pool);
+    pool_allocator_free(&pool, a);
+    pool_allocator_free(&pool, b);
+
+    void *out[8];
+    ASSERT_EQ(pool_allocator_alloc_batch(&pool, 4, out), 4);
+    ASSERT_EQ(out[0], b);
+    ASSERT_EQ(out[1], a);
+    ASSERT_EQ((unsigned char *)out[3] - (unsigned char *)out[2], 16);
+    ASSERT_EQ(pool_allocator_used(&pool), 4);
+
+    // Only two blocks left: a short batch reports how many it got
+    ASSERT_EQ(pool_allocator_alloc_batch(&pool, 8, out), 2);
+    ASSERT_EQ(pool_allocator_available(&pool), 0);
+    ASSERT_EQ(pool_allocator_alloc_batch(&pool, 1, out), 0);
+    ASSERT_EQ(pool_allocator_alloc_batch(NULL, 1, out), 0);
+
+    pool_allocator_destroy(&pool);
+    return 1;
+}
+
+// Test: reset returns every block in O(1)
+TEST(reset_returns_all_blocks) {
+    PoolAllocator pool;
+    pool_allocator_create(&pool, 16, 3);
+
+    void *first = pool_allocator_alloc(&pool);
+    pool_allocator_alloc(&pool);
+    pool_allocator_free(&pool, first);
+
+    pool_allocator_reset(&pool);
+
+    ASSERT_EQ(pool_allocator_used(&pool), 0);
+    ASSERT_NULL(pool.free_list);
+    ASSERT_EQ(pool_allocator_alloc(&pool), first);
+
+    pool_allocator_destroy(&pool);
+    return 1;
+}
+
+// Test: pool on external memory is not freed on destroy
+TEST(create_from_external_memory) {
+    uint64_t storage[16];
+    PoolAllocator pool;
+
+    ASSERT_EQ(pool_allocator_create_from(&pool, storage, 16, 8), 0);
+    ASSERT_EQ(pool_allocator_alloc(&pool), (void *)storage);
+    ASSERT(pool_allocator_owns(&pool, &storage[15]));
+    ASSERT(!pool_allocator_owns(&pool, &storage[15] + 1));
+
+    pool_allocator_destroy(&pool);  // Must not free the stack buffer
+    return 1;
+}
+
+// Test: calloc clears recycled blocks and blocks a reset handed back
+TEST(calloc_zeroes_blocks) {
+    PoolAllocator pool;
+    pool_allocator_init(&pool);
+    pool_allocator_create(&pool, 64, 4);
+
+    unsigned char *a = pool_allocator_calloc(&pool);
+    ASSERT_NOT_NULL(a);
+    for (size_t i = 0; i < 64; i++) {
+        ASSERT_EQ(a[i], 0);
+    }
+    memset(a, 0xFF, 64);
+    pool_allocator_free(&pool, a);
+    ASSERT_EQ(pool_allocator_calloc(&pool), a);
+    for (size_t i = 0; i < 64; i++) {
+        ASSERT_EQ(a[i], 0);
+    }
+
+    memset(a, 0xFF, 64);
+    pool_allocator_reset(&pool);
+    ASSERT_EQ(pool.dirty_count, 1);
+    ASSERT_EQ(pool_allocator_calloc(&pool), a);
+    ASSERT_EQ(a[63], 0);
+    pool_allocator_destroy(&pool);
+
+    // Caller memory is never assumed clean
+    uint64_t storage[8];
+    memset(storage, 0xEE, sizeof(storage));
+    pool_allocator_create_from(&pool, storage, 16, 4);
+    uint64_t *block = pool_allocator_calloc(&pool);
+    ASSERT_EQ(block[0], 0);
+    ASSERT_EQ(block[1], 0);
+    ASSERT_EQ(storage[2], 0xEEEEEEEEEEEEEEEEull);
+    ASSERT_NULL(pool_allocator_calloc(NULL));
+    pool_allocator_destroy(&pool);
+    return 1;
+}
+
+// Test: NULL arguments are handled
+TEST(handles_null) {
+    ASSERT_NULL(pool_allocator_alloc(NULL));
+    pool_allocator_free(NULL, NULL);
+    pool_allocator_reset(NULL);
+    pool_allocator_destroy(NULL);
+    ASSERT_EQ(pool_allocator_used(NULL), 0);
+    return 1;
+}
+
+int main(void) {
+    printf("\n");
+    printf("╔════════════════════════════════════════════════════╗\n");
+    printf("║     Pool Allocator Test Suite                      ║\n");
+    printf("╚════════════════════════════════════════════════════╝\n\n");
+
+    printf("▸ Creation Tests\n");
+    RUN_TEST(init_zeros_struct);
+    RUN_TEST(create_is_lazy);
+    RUN_TEST(create_minimum_block_size);
+    RUN_TEST(create_fails_bad_args);
+    RUN_TEST(create_from_external_memory);
+
+    printf("\n▸ Allocation Tests\n");
+    RUN_TEST(alloc_bumps_high_water);
+    RUN_TEST(free_recycles_lifo);
+    RUN_TEST(alloc_fails_when_exhausted);
+    RUN_TEST(alloc_batch_mixes_sources);
+    RUN_TEST(calloc_zeroes_blocks);
+
+    printf("\n▸ Reset Tests\n");
+    RUN_TEST(reset_returns_all_blocks);
+    RUN_TEST(handles_null);
+
+    return test_summary();
+}
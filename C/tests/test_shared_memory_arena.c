@@ -0,0 +1,301 @@
+/*
+ * Test suite for shared_memory_arena
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "../src/shared_memory_arena.h"
+#include "test_framework.h"
+
+#define SEGMENT_SIZE  (1024 * 1024)
+#define RECORD_COUNT  1000
+#define CHILD_COUNT   3
+#define CHILD_ROUNDS  20000
+
+typedef struct {
+    SharedMemoryOffset next;
+    uint32_t sequence;
+    char payload[20];
+} Record;
+
+// Test: anonymous segment hands out offsets that round-trip
+TEST(memfd_alloc_and_offsets) {
+    SharedMemoryArena arena;
+    ASSERT_EQ(shared_memory_arena_create(&arena, NULL, SEGMENT_SIZE), 0);
+    ASSERT(arena.fd >= 0);
+    size_t start = shared_memory_arena_used(&arena);
+    ASSERT(start > 0);
+
+    void *a = shared_memory_arena_alloc(&arena, 5);
+    void *b = shared_memory_arena_alloc(&arena, 16);
+    SharedMemoryOffset offset = shared_memory_arena_offset(&arena, a);
+    ASSERT_EQ(offset, start);
+    ASSERT_EQ(shared_memory_arena_offset(&arena, b), start + 8);
+    ASSERT_EQ(shared_memory_arena_ptr(&arena, offset), a);
+    ASSERT_EQ(shared_memory_arena_offset(&arena, NULL), SHARED_MEMORY_NULL_OFFSET);
+    ASSERT_NULL(shared_memory_arena_ptr(&arena, SHARED_MEMORY_NULL_OFFSET));
+    ASSERT(shared_memory_arena_contains(&arena, offset));
+    ASSERT(!shared_memory_arena_contains(&arena, SHARED_MEMORY_NULL_OFFSET));
+    ASSERT(!shared_memory_arena_contains(&arena, start + 24));
+
+    void *aligned = shared_memory_arena_alloc_aligned(&arena, 32, 256);
+    ASSERT_EQ(shared_memory_arena_offset(&arena, aligned) % 256, 0);
+    ASSERT_NULL(shared_memory_arena_alloc_aligned(&arena, 32, 3));
+    ASSERT_NULL(shared_memory_arena_alloc(&arena, SEGMENT_SIZE));
+    ASSERT_NULL(shared_memory_arena_alloc(&arena, 0));
+
+    shared_memory_arena_set_root(&arena, offset);
+    shared_memory_arena_reset(&arena);
+    ASSERT_EQ(shared_memory_arena_used(&arena), start);
+    ASSERT_EQ(shared_memory_arena_root(&arena), SHARED_MEMORY_NULL_OFFSET);
+    ASSERT_EQ(shared_memory_arena_alloc(&arena, 8), a);
+
+    shared_memory_arena_close(&arena);
+    ASSERT_NULL(arena.base);
+    return 1;
+}
+
+// Test: a second mapping at another address sees the same state
+TEST(second_mapping_shares_state) {
+    SharedMemoryArena first, second;
+    shared_memory_arena_create(&first, NULL, SEGMENT_SIZE);
+    ASSERT_EQ(shared_memory_arena_open_fd(&second, first.fd), 0);
+    ASSERT_NE(first.base, second.base);
+    ASSERT_EQ(second.size, (size_t)SEGMENT_SIZE);
+
+    Record *record = shared_memory_arena_alloc(&first, sizeof(Record));
+    strcpy(record->payload, "in place");
+    shared_memory_arena_set_root(&first, shared_memory_arena_offset(&first, record));
+
+    const Record *seen = shared_memory_arena_ptr(&second, shared_memory_arena_root(&second));
+    ASSERT_NE((const void *)seen, (const void *)record);
+    ASSERT_EQ(strcmp(seen->payload, "in place"), 0);
+
+    // Allocations from either view come from one bump offset
+    void *next = shared_memory_arena_alloc(&second, 8);
+    ASSERT_EQ(shared_memory_arena_offset(&second, next), shared_memory_arena_offset(&first, record) + sizeof(Record));
+    ASSERT_EQ(shared_memory_arena_used(&first), shared_memory_arena_used(&second));
+
+    shared_memory_arena_close(&second);
+    shared_memory_arena_close(&first);
+    return 1;
+}
+
+// Test: named segments are found by name and refuse duplicates
+TEST(named_segment_open_and_unlink) {
+    char name[64];
+    snprintf(name, sizeof(name), "/test_shared_memory_arena_%ld", (long)getpid());
+    shared_memory_arena_unlink(name);
+
+    SharedMemoryArena creator, opener;
+    ASSERT_EQ(shared_memory_arena_create(&creator, name, SEGMENT_SIZE), 0);
+    ASSERT_EQ(shared_memory_arena_create(&opener, name, SEGMENT_SIZE), -1);
+
+    ASSERT_EQ(shared_memory_arena_open(&opener, name), 0);
+    uint32_t *value = shared_memory_arena_alloc(&creator, sizeof(uint32_t));
+    *value = 0xC0FFEE;
+    ASSERT_EQ(*(uint32_t *)shared_memory_arena_ptr(&opener, shared_memory_arena_offset(&creator, value)), 0xC0FFEE);
+
+    ASSERT_EQ(shared_memory_arena_unlink(name), 0);
+    ASSERT_EQ(shared_memory_arena_open(&opener, name), -1);
+    ASSERT_EQ(shared_memory_arena_unlink(name), -1);
+
+    // Mappings survive the unlink
+    ASSERT_EQ(*value, 0xC0FFEE);
+    shared_memory_arena_close(&creator);
+    return 1;
+}
+
+// Test: a forked producer builds records in place, the parent reads offsets
+TEST(fork_producer_consumer) {
+    SharedMemoryArena arena;
+    shared_memory_arena_create(&arena, NULL, SEGMENT_SIZE);
+
+    pid_t child = fork();
+    if (child == 0) {
+        SharedMemoryOffset head = SHARED_MEMORY_NULL_OFFSET;
+        for (uint32_t i = 0; i < RECORD_COUNT; i++) {
+            Record *record = shared_memory_arena_alloc(&arena, sizeof(Record));
+            if (record == NULL) {
+                _exit(1);
+            }
+            record->next = head;
+            record->sequence = i;
+            snprintf(record->payload, sizeof(record->payload), "record-%u", i);
+            head = shared_memory_arena_offset(&arena, record);
+        }
+        shared_memory_arena_set_root(&arena, head);
+        _exit(0);
+    }
+    ASSERT(child > 0);
+    int status = 0;
+    waitpid(child, &status, 0);
+    ASSERT(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+    uint32_t expected = RECORD_COUNT;
+    char payload[20];
+    for (SharedMemoryOffset at = shared_memory_arena_root(&arena); at != SHARED_MEMORY_NULL_OFFSET;) {
+        const Record *record = shared_memory_arena_ptr(&arena, at);
+        expected--;
+        ASSERT_EQ(record->sequence, expected);
+        snprintf(payload, sizeof(payload), "record-%u", expected);
+        ASSERT_EQ(strcmp(record->payload, payload), 0);
+        at = record->next;
+    }
+    ASSERT_EQ(expected, 0);
+
+    shared_memory_arena_close(&arena);
+    return 1;
+}
+
+// Test: pools live in the segment and are attached by handle
+TEST(pool_in_segment) {
+    SharedMemoryArena arena, view;
+    shared_memory_arena_create(&arena, NULL, SEGMENT_SIZE);
+    shared_memory_arena_open_fd(&view, arena.fd);
+
+    SharedMemoryPool pool, attached;
+    ASSERT_EQ(shared_memory_pool_create(&pool, &arena, 0, 4), -1);
+    ASSERT_EQ(shared_memory_pool_create(&pool, &arena, 20, 3), 0);
+    ASSERT_EQ(shared_memory_pool_block_size(&pool), 24);
+    ASSERT_EQ(shared_memory_pool_offset(&pool) % 64, 0);
+
+    ASSERT_EQ(shared_memory_pool_attach(&attached, &view, shared_memory_pool_offset(&pool)), 0);
+    ASSERT_EQ(shared_memory_pool_attach(&attached, &view, shared_memory_pool_offset(&pool) + 64), -1);
+    ASSERT_EQ(shared_memory_pool_attach(&attached, &view, SHARED_MEMORY_NULL_OFFSET), -1);
+    ASSERT_EQ(shared_memory_pool_attach(&attached, &view, shared_memory_pool_offset(&pool)), 0);
+
+    void *a = shared_memory_pool_alloc(&pool);
+    void *b = shared_memory_pool_alloc(&attached);
+    void *c = shared_memory_pool_alloc(&pool);
+    ASSERT_EQ(shared_memory_arena_offset(&view, b), shared_memory_arena_offset(&arena, a) + 24);
+    ASSERT_NOT_NULL(c);
+    ASSERT_NULL(shared_memory_pool_alloc(&attached));
+
+    // A block freed through one view is reused through the other
+    shared_memory_pool_free(&pool, shared_memory_arena_ptr(&arena, shared_memory_arena_offset(&view, b)));
+    ASSERT_EQ(shared_memory_pool_alloc(&attached), b);
+    shared_memory_pool_free(&attached, NULL);
+
+    shared_memory_arena_close(&view);
+    shared_memory_arena_close(&arena);
+    return 1;
+}
+
+// Stamp blocks with the child's id and check nobody else got them
+static int pool_child(SharedMemoryArena *arena, SharedMemoryOffset handle, unsigned char id) {
+    SharedMemoryPool pool;
+    if (shared_memory_pool_attach(&pool, arena, handle) != 0) {
+        return 1;
+    }
+    void *held[8];
+    for (int round = 0; round < CHILD_ROUNDS; round++) {
+        int n = 1 + round % 8;
+        for (int i = 0; i < n; i++) {
+            held[i] = shared_memory_pool_alloc(&pool);
+            if (held[i] == NULL) {
+                return 1;
+            }
+            memset(held[i], id, 32);
+        }
+        for (int i = 0; i < n; i++) {
+            unsigned char *bytes = held[i];
+            if (bytes[8] != id || bytes[31] != id) {
+                return 1;
+            }
+            shared_memory_pool_free(&pool, held[i]);
+        }
+    }
+    return 0;
+}
+
+// Test: concurrent processes never receive the same pool block
+TEST(concurrent_processes_share_pool) {
+    SharedMemoryArena arena;
+    shared_memory_arena_create(&arena, NULL, SEGMENT_SIZE);
+    SharedMemoryPool pool;
+    size_t blocks = CHILD_COUNT * 8 + 8;
+    shared_memory_pool_create(&pool, &arena, 32, blocks);
+
+    pid_t children[CHILD_COUNT];
+    for (int c = 0; c < CHILD_COUNT; c++) {
+        children[c] = fork();
+        if (children[c] == 0) {
+            _exit(pool_child(&arena, shared_memory_pool_offset(&pool), (unsigned char)(c + 1)));
+        }
+    }
+    int failures = 0;
+    for (int c = 0; c < CHILD_COUNT; c++) {
+        int status = 0;
+        waitpid(children[c], &status, 0);
+        failures += !(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+    ASSERT_EQ(failures, 0);
+
+    // Every block came back
+    size_t total = 0;
+    while (shared_memory_pool_alloc(&pool) != NULL) {
+        total++;
+    }
+    ASSERT_EQ(total, blocks);
+
+    shared_memory_arena_close(&arena);
+    return 1;
+}
+
+// Test: NULL arguments and bad fds are handled safely
+TEST(handles_null) {
+    SharedMemoryArena arena;
+    shared_memory_arena_init(&arena);
+    ASSERT_EQ(shared_memory_arena_create(NULL, NULL, SEGMENT_SIZE), -1);
+    ASSERT_EQ(shared_memory_arena_create(&arena, NULL, 16), -1);
+    ASSERT_EQ(shared_memory_arena_open(&arena, NULL), -1);
+    ASSERT_EQ(shared_memory_arena_open_fd(&arena, -1), -1);
+    ASSERT_EQ(shared_memory_arena_open_fd(NULL, 0), -1);
+    ASSERT_NULL(shared_memory_arena_alloc(NULL, 8));
+    ASSERT_NULL(shared_memory_arena_alloc(&arena, 8));
+    ASSERT_EQ(shared_memory_arena_used(NULL), 0);
+    ASSERT_EQ(shared_memory_arena_root(NULL), SHARED_MEMORY_NULL_OFFSET);
+    ASSERT(!shared_memory_arena_contains(NULL, 64));
+    shared_memory_arena_set_root(NULL, 64);
+    shared_memory_arena_reset(NULL);
+    shared_memory_arena_close(NULL);
+    shared_memory_arena_close(&arena);
+    ASSERT_EQ(shared_memory_arena_unlink(NULL), -1);
+
+    SharedMemoryPool pool;
+    ASSERT_EQ(shared_memory_pool_create(&pool, NULL, 8, 8), -1);
+    ASSERT_EQ(shared_memory_pool_attach(&pool, NULL, 64), -1);
+    ASSERT_NULL(shared_memory_pool_alloc(&pool));
+    ASSERT_NULL(shared_memory_pool_alloc(NULL));
+    shared_memory_pool_free(NULL, &pool);
+    ASSERT_EQ(shared_memory_pool_offset(NULL), SHARED_MEMORY_NULL_OFFSET);
+    ASSERT_EQ(shared_memory_pool_block_size(NULL), 0);
+    return 1;
+}
+
+int main(void) {
+    printf("\n");
+    printf("╔════════════════════════════════════════════════════╗\n");
+    printf("║     Shared Memory Arena Test Suite                 ║\n");
+    printf("╚════════════════════════════════════════════════════╝\n\n");
+
+    printf("▸ Segment Tests\n");
+    RUN_TEST(memfd_alloc_and_offsets);
+    RUN_TEST(second_mapping_shares_state);
+    RUN_TEST(named_segment_open_and_unlink);
+
+    printf("\n▸ Cross-Process Tests\n");
+    RUN_TEST(fork_producer_consumer);
+
+    printf("\n▸ Pool Tests\n");
+    RUN_TEST(pool_in_segment);
+    RUN_TEST(concurrent_processes_share_pool);
+    RUN_TEST(handles_null);
+
+    return test_summary();
+}
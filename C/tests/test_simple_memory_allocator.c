@@ -2,37 +2,16 @@
  * Test suite for simple_memory_allocator
  */
 
+#define _DEFAULT_SOURCE  // Required for mincore
+
 #include <stdio.h>
 #include <string.h>
 #include <stdint.h>
+#include <sys/mman.h>
+#include <unistd.h>
 #include "../src/simple_memory_allocator.h"
-
-static int tests_run = 0;
-static int tests_passed = 0;
-
-// ANSI color codes
-#define COLOR_RESET   "\033[0m"
-#define COLOR_YELLOW  "\033[33m"
-#define COLOR_GREEN   "\033[32m"
-#define COLOR_RED     "\033[31m"
-
-#define TEST(name) static int test_##name(void)
-#define RUN_TEST(name) do { \
-    tests_run++; \
-    printf("  " COLOR_YELLOW "[TEST]" COLOR_RESET " %-40s ", #name); \
-    if (test_##name()) { \
-        tests_passed++; \
-        printf(COLOR_GREEN "[PASS]" COLOR_RESET "\n"); \
-    } else { \
-        printf(COLOR_RED "[FAIL]" COLOR_RESET "\n"); \
-    } \
-} while(0)
-
-#define ASSERT(cond) do { if (!(cond)) return 0; } while(0)
-#define ASSERT_EQ(a, b) ASSERT((a) == (b))
-#define ASSERT_NE(a, b) ASSERT((a) != (b))
-#define ASSERT_NULL(p) ASSERT((p) == NULL)
-#define ASSERT_NOT_NULL(p) ASSERT((p) != NULL)
+#include "../src/pool_allocator.h"
+#include "test_framework.h"
 
 // Test: init sets all fields to zero
 TEST(init_zeros_struct) {
@@ -46,6 +25,8 @@ TEST(init_zeros_struct) {
     ASSERT_NULL(alloc.memory);
     ASSERT_EQ(alloc.size, 0);
     ASSERT_EQ(alloc.used, 0);
+    ASSERT_NULL(alloc.block);
+    ASSERT_EQ(alloc.options.growable, 0);
     return 1;
 }
 
@@ -324,6 +305,1022 @@ TEST(alloc_over_pool_size_fails) {
     return 1;
 }
 
+// Test: growable allocator chains a new block when full
+TEST(growable_chains_block) {
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    SimpleMemoryAllocatorOptions opts = {0};
+    opts.growable = 1;
+    simple_memory_allocator_create_with_options(&alloc, 64, &opts);
+
+    void *ptr1 = simple_memory_allocator_alloc(&alloc, 64);
+    void *ptr2 = simple_memory_allocator_alloc(&alloc, 8);
+
+    ASSERT_NOT_NULL(ptr1);
+    ASSERT_NOT_NULL(ptr2);
+    ASSERT_EQ(simple_memory_allocator_block_count(&alloc), 2);
+    ASSERT_EQ(alloc.size, 128);  // Doubled by default
+    ASSERT_EQ(alloc.used, 8);
+    ASSERT_EQ(ptr2, alloc.memory);
+
+    simple_memory_allocator_destroy(&alloc);
+    return 1;
+}
+
+// Test: growth factor and cap are honored
+TEST(growable_respects_cap) {
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    SimpleMemoryAllocatorOptions opts = {0};
+    opts.growable = 1;
+    opts.growth_factor = 4;
+    opts.max_block_size = 512;
+    simple_memory_allocator_create_with_options(&alloc, 64, &opts);
+
+    simple_memory_allocator_alloc(&alloc, 64);
+    simple_memory_allocator_alloc(&alloc, 8);
+    ASSERT_EQ(alloc.size, 256);
+
+    simple_memory_allocator_alloc(&alloc, 256);
+    ASSERT_EQ(alloc.size, 512);  // 1024 capped to 512
+
+    simple_memory_allocator_alloc(&alloc, 512);
+    ASSERT_EQ(alloc.size, 512);
+    ASSERT_EQ(simple_memory_allocator_block_count(&alloc), 4);
+    ASSERT_EQ(simple_memory_allocator_capacity(&alloc), 64 + 256 + 512 + 512);
+    ASSERT_EQ(simple_memory_allocator_bytes_used(&alloc), 64 + 8 + 256 + 512);
+
+    simple_memory_allocator_destroy(&alloc);
+    return 1;
+}
+
+// Test: request larger than the cap gets its own block
+TEST(growable_oversize_request) {
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    SimpleMemoryAllocatorOptions opts = {0};
+    opts.growable = 1;
+    opts.max_block_size = 128;
+    simple_memory_allocator_create_with_options(&alloc, 64, &opts);
+
+    void *ptr = simple_memory_allocator_alloc(&alloc, 1000);
+
+    ASSERT_NOT_NULL(ptr);
+    ASSERT_EQ(alloc.size, 1000);
+    ASSERT_EQ(alloc.used, 1000);
+
+    simple_memory_allocator_destroy(&alloc);
+    return 1;
+}
+
+// Test: reset keeps only the largest block
+TEST(growable_reset_keeps_largest) {
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    SimpleMemoryAllocatorOptions opts = {0};
+    opts.growable = 1;
+    simple_memory_allocator_create_with_options(&alloc, 64, &opts);
+
+    simple_memory_allocator_alloc(&alloc, 64);
+    simple_memory_allocator_alloc(&alloc, 128);
+    simple_memory_allocator_alloc(&alloc, 8);
+    ASSERT_EQ(simple_memory_allocator_block_count(&alloc), 3);
+
+    simple_memory_allocator_reset(&alloc);
+
+    ASSERT_EQ(simple_memory_allocator_block_count(&alloc), 1);
+    ASSERT_EQ(alloc.size, 256);
+    ASSERT_EQ(alloc.used, 0);
+
+    // Peak demand now fits without growing
+    ASSERT_NOT_NULL(simple_memory_allocator_alloc(&alloc, 192));
+    ASSERT_EQ(simple_memory_allocator_block_count(&alloc), 1);
+
+    simple_memory_allocator_destroy(&alloc);
+    return 1;
+}
+
+// Test: fixed allocator never chains blocks
+TEST(fixed_does_not_grow) {
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    simple_memory_allocator_create(&alloc, 64);
+
+    ASSERT_NOT_NULL(simple_memory_allocator_alloc(&alloc, 64));
+    ASSERT_NULL(simple_memory_allocator_alloc(&alloc, 8));
+    ASSERT_EQ(simple_memory_allocator_block_count(&alloc), 1);
+
+    simple_memory_allocator_destroy(&alloc);
+    return 1;
+}
+
+// Test: alloc_aligned honors large power-of-two alignments
+TEST(alloc_aligned_power_of_two) {
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    simple_memory_allocator_create(&alloc, 1024);
+
+    simple_memory_allocator_alloc(&alloc, 8);
+    void *ptr32 = simple_memory_allocator_alloc_aligned(&alloc, 32, 32);
+    void *ptr64 = simple_memory_allocator_alloc_aligned(&alloc, 8, 64);
+    void *ptr256 = simple_memory_allocator_alloc_aligned(&alloc, 100, 256);
+
+    ASSERT_NOT_NULL(ptr32);
+    ASSERT_NOT_NULL(ptr64);
+    ASSERT_NOT_NULL(ptr256);
+    ASSERT_EQ((uintptr_t)ptr32 % 32, 0);
+    ASSERT_EQ((uintptr_t)ptr64 % 64, 0);
+    ASSERT_EQ((uintptr_t)ptr256 % 256, 0);
+
+    // Used covers the padding plus the rounded size
+    ASSERT_EQ((uint8_t *)alloc.memory + alloc.used, (uint8_t *)ptr256 + 104);
+
+    simple_memory_allocator_destroy(&alloc);
+    return 1;
+}
+
+// Test: alloc_aligned rejects non-power-of-two alignment
+TEST(alloc_aligned_rejects_bad_alignment) {
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    simple_memory_allocator_create(&alloc, 1024);
+
+    ASSERT_NULL(simple_memory_allocator_alloc_aligned(&alloc, 16, 0));
+    ASSERT_NULL(simple_memory_allocator_alloc_aligned(&alloc, 16, 24));
+    ASSERT_EQ(alloc.used, 0);
+
+    simple_memory_allocator_destroy(&alloc);
+    return 1;
+}
+
+// Test: small alignments fall back to the 8-byte minimum
+TEST(alloc_aligned_small_alignment) {
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    simple_memory_allocator_create(&alloc, 1024);
+
+    void *ptr1 = simple_memory_allocator_alloc_aligned(&alloc, 3, 1);
+    void *ptr2 = simple_memory_allocator_alloc_aligned(&alloc, 3, 2);
+
+    ASSERT_EQ((uint8_t *)ptr2 - (uint8_t *)ptr1, 8);
+
+    simple_memory_allocator_destroy(&alloc);
+    return 1;
+}
+
+// Test: pool-level default alignment applies to alloc()
+TEST(default_alignment_option) {
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    SimpleMemoryAllocatorOptions opts = {0};
+    opts.alignment = 64;
+    ASSERT_EQ(simple_memory_allocator_create_with_options(&alloc, 1024, &opts), 0);
+
+    void *ptr1 = simple_memory_allocator_alloc(&alloc, 8);
+    void *ptr2 = simple_memory_allocator_alloc(&alloc, 8);
+
+    ASSERT_EQ((uintptr_t)ptr1 % 64, 0);
+    ASSERT_EQ((uintptr_t)ptr2 % 64, 0);
+    ASSERT_EQ((uint8_t *)ptr2 - (uint8_t *)ptr1, 64);
+
+    simple_memory_allocator_destroy(&alloc);
+    return 1;
+}
+
+// Test: create rejects a non-power-of-two default alignment
+TEST(create_fails_bad_alignment) {
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    SimpleMemoryAllocatorOptions opts = {0};
+    opts.alignment = 48;
+
+    ASSERT_EQ(simple_memory_allocator_create_with_options(&alloc, 1024, &opts), -1);
+    return 1;
+}
+
+// Test: aligned allocation that does not fit fails in fixed mode
+TEST(alloc_aligned_padding_exhausts) {
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    simple_memory_allocator_create(&alloc, 128);
+
+    simple_memory_allocator_alloc(&alloc, 8);
+    // Fits without padding, but any padding leaves no room
+    ASSERT_NULL(simple_memory_allocator_alloc_aligned(&alloc, 120, 128));
+    ASSERT_EQ(alloc.used, 8);
+
+    simple_memory_allocator_destroy(&alloc);
+    return 1;
+}
+
+// Test: growable allocator grows with room for alignment padding
+TEST(growable_aligned_alloc) {
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    SimpleMemoryAllocatorOptions opts = {0};
+    opts.growable = 1;
+    simple_memory_allocator_create_with_options(&alloc, 64, &opts);
+
+    simple_memory_allocator_alloc(&alloc, 64);
+    void *ptr = simple_memory_allocator_alloc_aligned(&alloc, 512, 256);
+
+    ASSERT_NOT_NULL(ptr);
+    ASSERT_EQ((uintptr_t)ptr % 256, 0);
+    ASSERT_EQ(simple_memory_allocator_block_count(&alloc), 2);
+
+    simple_memory_allocator_destroy(&alloc);
+    return 1;
+}
+
+// Fill a region and verify it reads back
+static int fill_and_check(uint8_t *buf, size_t size, uint8_t pattern) {
+    memset(buf, pattern, size);
+    for (size_t i = 0; i < size; i++) {
+        if (buf[i] != pattern) return 0;
+    }
+    return 1;
+}
+
+// Test: mmap backing creates a usable pool
+TEST(mmap_backing_creates_pool) {
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    SimpleMemoryAllocatorOptions opts = {0};
+    opts.backing = SIMPLE_MEMORY_BACKING_MMAP;
+
+    ASSERT_EQ(simple_memory_allocator_create_with_options(&alloc, 64 * 1024, &opts), 0);
+    ASSERT_EQ(alloc.size, 64 * 1024);
+
+    uint8_t *buf = simple_memory_allocator_alloc(&alloc, 64 * 1024);
+    ASSERT_NOT_NULL(buf);
+    ASSERT(fill_and_check(buf, 64 * 1024, 0x5A));
+
+    simple_memory_allocator_destroy(&alloc);
+    ASSERT_NULL(alloc.memory);
+    return 1;
+}
+
+// Test: huge page and populate flags still produce a usable pool
+TEST(mmap_backing_huge_pages_populate) {
+    unsigned flag_sets[] = {
+        SIMPLE_MEMORY_MAP_POPULATE,
+        SIMPLE_MEMORY_MAP_HUGETLB,
+        SIMPLE_MEMORY_MAP_TRANSPARENT_HUGE_PAGES | SIMPLE_MEMORY_MAP_POPULATE,
+    };
+
+    for (size_t i = 0; i < sizeof(flag_sets) / sizeof(flag_sets[0]); i++) {
+        SimpleMemoryAllocator alloc;
+        simple_memory_allocator_init(&alloc);
+        SimpleMemoryAllocatorOptions opts = {0};
+        opts.backing = SIMPLE_MEMORY_BACKING_MMAP;
+        opts.map_flags = flag_sets[i];
+
+        ASSERT_EQ(simple_memory_allocator_create_with_options(&alloc, 4 * 1024 * 1024, &opts), 0);
+
+        uint8_t *buf = simple_memory_allocator_alloc(&alloc, 4096);
+        ASSERT_NOT_NULL(buf);
+        ASSERT(fill_and_check(buf, 4096, 0xA5));
+
+        simple_memory_allocator_destroy(&alloc);
+    }
+    return 1;
+}
+
+// Test: NUMA binding to node 0 succeeds or reports failure cleanly
+TEST(mmap_backing_numa_bind) {
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    SimpleMemoryAllocatorOptions opts = {0};
+    opts.backing = SIMPLE_MEMORY_BACKING_MMAP;
+    opts.map_flags = SIMPLE_MEMORY_MAP_NUMA_BIND | SIMPLE_MEMORY_MAP_POPULATE;
+    opts.numa_node = 0;
+
+    if (simple_memory_allocator_create_with_options(&alloc, 64 * 1024, &opts) == 0) {
+        ASSERT_NOT_NULL(simple_memory_allocator_alloc(&alloc, 1024));
+        simple_memory_allocator_destroy(&alloc);
+    } else {
+        ASSERT_NULL(alloc.memory);  // Kernel without NUMA support
+    }
+
+    // Invalid node is always rejected
+    opts.numa_node = -1;
+    ASSERT_EQ(simple_memory_allocator_create_with_options(&alloc, 64 * 1024, &opts), -1);
+    return 1;
+}
+
+// Test: growable mmap pool maps chained blocks the same way
+TEST(mmap_backing_growable) {
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    SimpleMemoryAllocatorOptions opts = {0};
+    opts.growable = 1;
+    opts.backing = SIMPLE_MEMORY_BACKING_MMAP;
+    simple_memory_allocator_create_with_options(&alloc, 4096, &opts);
+
+    ASSERT_NOT_NULL(simple_memory_allocator_alloc(&alloc, 4096));
+    uint8_t *buf = simple_memory_allocator_alloc(&alloc, 6000);
+    ASSERT_NOT_NULL(buf);
+    ASSERT(fill_and_check(buf, 6000, 0x3C));
+    ASSERT_EQ(simple_memory_allocator_block_count(&alloc), 2);
+
+    simple_memory_allocator_reset(&alloc);
+    ASSERT_EQ(simple_memory_allocator_block_count(&alloc), 1);
+
+    simple_memory_allocator_destroy(&alloc);
+    return 1;
+}
+
+// Resident pages in the allocator's current block
+static size_t resident_pages(const SimpleMemoryAllocator *alloc) {
+    size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+    uintptr_t start = (uintptr_t)alloc->memory & ~((uintptr_t)page_size - 1);
+    size_t length = ((uintptr_t)alloc->memory + alloc->size - start + page_size - 1) & ~(page_size - 1);
+    unsigned char vec[1024];
+    size_t pages = length / page_size;
+    if (pages > sizeof(vec) || mincore((void *)start, length, vec) != 0) {
+        return 0;
+    }
+    size_t resident = 0;
+    for (size_t i = 0; i < pages; i++) {
+        resident += vec[i] & 1;
+    }
+    return resident;
+}
+
+// Test: a spike is decommitted and RSS converges back to the steady peak
+TEST(reset_decommit_releases_cold_tail) {
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    SimpleMemoryAllocatorOptions opts = {0};
+    opts.backing = SIMPLE_MEMORY_BACKING_MMAP;
+    simple_memory_allocator_create_with_options(&alloc, 1024 * 1024, &opts);
+    SimpleMemoryDecommitPolicy policy = {0};
+    policy.window = 2;
+
+    size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+    size_t steady = 16 * 1024;
+    for (int i = 0; i < 4; i++) {
+        memset(simple_memory_allocator_alloc(&alloc, steady), 1, steady);
+        ASSERT_EQ(simple_memory_allocator_reset_decommit(&alloc, &policy), 0);
+    }
+
+    // One outsized cycle touches the whole pool
+    memset(simple_memory_allocator_alloc(&alloc, alloc.size), 2, alloc.size);
+    ASSERT(simple_memory_allocator_reset_decommit(&alloc, &policy) > 0);
+    ASSERT(resident_pages(&alloc) < alloc.size / page_size);
+
+    for (int i = 0; i < 20; i++) {
+        memset(simple_memory_allocator_alloc(&alloc, steady), 3, steady);
+        simple_memory_allocator_reset_decommit(&alloc, &policy);
+    }
+    ASSERT(resident_pages(&alloc) <= 2 * steady / page_size + 2);
+    ASSERT_EQ(alloc.used, 0);
+
+    // Decommitted memory reads back and is usable again
+    uint8_t *buf = simple_memory_allocator_alloc(&alloc, alloc.size);
+    ASSERT_NOT_NULL(buf);
+    ASSERT(fill_and_check(buf, alloc.size, 0x77));
+
+    simple_memory_allocator_destroy(&alloc);
+    return 1;
+}
+
+// Test: min_resident, lazy advice and malloc backing
+TEST(reset_decommit_policy_options) {
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    SimpleMemoryAllocatorOptions opts = {0};
+    opts.backing = SIMPLE_MEMORY_BACKING_MMAP;
+    simple_memory_allocator_create_with_options(&alloc, 256 * 1024, &opts);
+    SimpleMemoryDecommitPolicy policy = {1, 256 * 1024, 0};
+
+    // A hot prefix covering the block keeps everything
+    memset(simple_memory_allocator_alloc(&alloc, alloc.size), 1, alloc.size);
+    simple_memory_allocator_reset(&alloc);
+    ASSERT_EQ(simple_memory_allocator_reset_decommit(&alloc, &policy), 0);
+
+    // Plain reset() still remembers the pages it left resident
+    memset(simple_memory_allocator_alloc(&alloc, alloc.size), 1, alloc.size);
+    simple_memory_allocator_reset(&alloc);
+    policy.min_resident = 0;
+    policy.lazy = 1;
+    ASSERT(simple_memory_allocator_reset_decommit(&alloc, &policy) > 0);
+    ASSERT_EQ(simple_memory_allocator_reset_decommit(&alloc, &policy), 0);
+
+    simple_memory_allocator_destroy(&alloc);
+
+    ASSERT_EQ(simple_memory_allocator_create(&alloc, 64 * 1024), 0);
+    memset(simple_memory_allocator_alloc(&alloc, alloc.size), 1, alloc.size);
+    ASSERT_EQ(simple_memory_allocator_reset_decommit(&alloc, NULL), 0);
+    ASSERT_EQ(alloc.used, 0);
+    simple_memory_allocator_destroy(&alloc);
+
+    ASSERT_EQ(simple_memory_allocator_reset_decommit(NULL, NULL), 0);
+    return 1;
+}
+
+// Test: unknown backing is rejected
+TEST(create_fails_bad_backing) {
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    SimpleMemoryAllocatorOptions opts = {0};
+    opts.backing = (SimpleMemoryBacking)42;
+
+    ASSERT_EQ(simple_memory_allocator_create_with_options(&alloc, 1024, &opts), -1);
+    return 1;
+}
+
+// Test: a child arena carves its blocks from a parent arena and hands them back
+TEST(child_arena_borrows_from_parent) {
+    SimpleMemoryAllocator parent, child;
+    simple_memory_allocator_init(&parent);
+    simple_memory_allocator_init(&child);
+    simple_memory_allocator_create(&parent, 64 * 1024);
+
+    SimpleMemoryAllocatorOptions opts = {0};
+    opts.backing = SIMPLE_MEMORY_BACKING_PARENT_ARENA;
+    opts.parent = &parent;
+    opts.growable = 1;
+    ASSERT_EQ(simple_memory_allocator_create_with_options(&child, 4096, &opts), 0);
+    ASSERT(parent.used > 4096);
+    uint8_t *ptr = simple_memory_allocator_alloc(&child, 1000);
+    ASSERT(ptr > (uint8_t *)parent.memory && ptr < (uint8_t *)parent.memory + parent.used);
+
+    // Growth chains another block from the parent
+    ASSERT_NOT_NULL(simple_memory_allocator_alloc(&child, 6000));
+    ASSERT_EQ(simple_memory_allocator_block_count(&child), 2);
+    ASSERT(parent.used > 4096 + 8192);
+
+    // Still the parent's latest allocations, so destroy gives everything back
+    simple_memory_allocator_destroy(&child);
+    ASSERT_EQ(parent.used, 0);
+
+    // Buried behind other parent allocations, the block waits for the parent's reset
+    ASSERT_EQ(simple_memory_allocator_create_with_options(&child, 4096, &opts), 0);
+    ASSERT_NOT_NULL(simple_memory_allocator_alloc(&parent, 64));
+    size_t parent_used = parent.used;
+    simple_memory_allocator_destroy(&child);
+    ASSERT_EQ(parent.used, parent_used);
+
+    simple_memory_allocator_destroy(&parent);
+    return 1;
+}
+
+// Test: child arenas on a pool take one pool block each and return them
+TEST(child_arena_in_pool) {
+    PoolAllocator pool;
+    pool_allocator_init(&pool);
+    pool_allocator_create(&pool, 4096, 4);
+    SimpleMemoryAllocator child;
+    simple_memory_allocator_init(&child);
+
+    SimpleMemoryAllocatorOptions opts = {0};
+    opts.backing = SIMPLE_MEMORY_BACKING_PARENT_POOL;
+    opts.parent = &pool;
+    opts.growable = 1;
+    ASSERT_EQ(simple_memory_allocator_create_with_options(&child, 1, &opts), 0);
+    ASSERT(child.size > 4000 && child.size < 4096);  // The whole block minus its header
+    ASSERT_EQ(pool_allocator_used(&pool), 1);
+
+    ASSERT_NOT_NULL(simple_memory_allocator_alloc(&child, 3000));
+    ASSERT_NOT_NULL(simple_memory_allocator_alloc(&child, 3000));
+    ASSERT_EQ(pool_allocator_used(&pool), 2);
+    ASSERT_NULL(simple_memory_allocator_alloc(&child, 5000));  // Larger than any pool block
+
+    simple_memory_allocator_reset(&child);
+    ASSERT_EQ(pool_allocator_used(&pool), 1);
+    simple_memory_allocator_destroy(&child);
+    ASSERT_EQ(pool_allocator_used(&pool), 0);
+
+    // Connection churn recycles the same block
+    void *first = NULL;
+    for (int i = 0; i < 100; i++) {
+        ASSERT_EQ(simple_memory_allocator_create_with_options(&child, 4096 - 64, &opts), 0);
+        void *ptr = simple_memory_allocator_alloc(&child, 256);
+        first = first != NULL ? first : ptr;
+        ASSERT_EQ(ptr, first);
+        simple_memory_allocator_destroy(&child);
+    }
+    ASSERT_EQ(simple_memory_allocator_create_with_options(&child, 4096, &opts), -1);
+    ASSERT_EQ(pool_allocator_used(&pool), 0);
+
+    pool_allocator_destroy(&pool);
+    return 1;
+}
+
+// Test: unusable parents are rejected
+TEST(child_arena_bad_parent) {
+    SimpleMemoryAllocator child;
+    simple_memory_allocator_init(&child);
+    SimpleMemoryAllocatorOptions opts = {0};
+
+    opts.backing = SIMPLE_MEMORY_BACKING_PARENT_ARENA;
+    ASSERT_EQ(simple_memory_allocator_create_with_options(&child, 64, &opts), -1);
+    opts.parent = &child;
+    ASSERT_EQ(simple_memory_allocator_create_with_options(&child, 64, &opts), -1);
+
+    PoolAllocator pool;
+    pool_allocator_init(&pool);
+    opts.backing = SIMPLE_MEMORY_BACKING_PARENT_POOL;
+    opts.parent = &pool;
+    ASSERT_EQ(simple_memory_allocator_create_with_options(&child, 64, &opts), -1);  // Not created
+    pool_allocator_create(&pool, 40, 4);
+    ASSERT_EQ(simple_memory_allocator_create_with_options(&child, 8, &opts), -1);  // Too small
+    pool_allocator_destroy(&pool);
+    pool_allocator_create(&pool, 200, 4);
+    ASSERT_EQ(simple_memory_allocator_create_with_options(&child, 8, &opts), -1);  // Breaks 16-byte alignment
+    pool_allocator_destroy(&pool);
+    return 1;
+}
+
+// Test: rewinding to a marker rolls back only the later allocations
+TEST(marker_rewinds_current_block) {
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    simple_memory_allocator_create(&alloc, 256);
+
+    simple_memory_allocator_alloc(&alloc, 40);
+    SimpleMemoryMarker marker = simple_memory_allocator_get_marker(&alloc);
+    void *scratch = simple_memory_allocator_alloc(&alloc, 100);
+    ASSERT_NOT_NULL(scratch);
+    ASSERT_EQ(alloc.used, 144);
+
+    ASSERT_EQ(simple_memory_allocator_free_to_marker(&alloc, marker), 0);
+    ASSERT_EQ(alloc.used, 40);
+    ASSERT_EQ(simple_memory_allocator_alloc(&alloc, 100), scratch);
+
+    simple_memory_allocator_destroy(&alloc);
+    return 1;
+}
+
+// Test: inner markers rewind first, the outer one discards everything after it
+TEST(markers_nest) {
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    simple_memory_allocator_create(&alloc, 256);
+
+    SimpleMemoryMarker outer = simple_memory_allocator_get_marker(&alloc);
+    simple_memory_allocator_alloc(&alloc, 16);
+    SimpleMemoryMarker inner = simple_memory_allocator_get_marker(&alloc);
+    simple_memory_allocator_alloc(&alloc, 32);
+
+    ASSERT_EQ(simple_memory_allocator_free_to_marker(&alloc, inner), 0);
+    ASSERT_EQ(alloc.used, 16);
+    ASSERT_EQ(simple_memory_allocator_free_to_marker(&alloc, outer), 0);
+    ASSERT_EQ(alloc.used, 0);
+
+    // The inner marker now lies ahead of the bump position
+    ASSERT_EQ(simple_memory_allocator_free_to_marker(&alloc, inner), -1);
+    ASSERT_EQ(alloc.used, 0);
+
+    simple_memory_allocator_destroy(&alloc);
+    return 1;
+}
+
+// Test: rewinding across chained blocks keeps the largest one for reuse
+TEST(marker_across_chained_blocks) {
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    SimpleMemoryAllocatorOptions opts = {0};
+    opts.growable = 1;
+    simple_memory_allocator_create_with_options(&alloc, 64, &opts);
+
+    simple_memory_allocator_alloc(&alloc, 48);
+    SimpleMemoryMarker marker = simple_memory_allocator_get_marker(&alloc);
+    void *first = simple_memory_allocator_alloc(&alloc, 64);   // Chains a 128-byte block
+    simple_memory_allocator_alloc(&alloc, 200);                // Chains a 256-byte block
+    ASSERT_NOT_NULL(first);
+    ASSERT_EQ(simple_memory_allocator_block_count(&alloc), 3);
+
+    ASSERT_EQ(simple_memory_allocator_free_to_marker(&alloc, marker), 0);
+    ASSERT_EQ(alloc.used, 48);
+    ASSERT_EQ(alloc.size, 64);
+    ASSERT_EQ(simple_memory_allocator_block_count(&alloc), 2);   // Current + warm spare
+    ASSERT_EQ(simple_memory_allocator_capacity(&alloc), 64 + 256);
+
+    // Next growth takes the spare instead of allocating
+    ASSERT_NOT_NULL(simple_memory_allocator_alloc(&alloc, 64));
+    ASSERT_EQ(alloc.size, 256);
+    ASSERT_EQ(simple_memory_allocator_block_count(&alloc), 2);
+
+    simple_memory_allocator_reset(&alloc);
+    ASSERT_EQ(simple_memory_allocator_block_count(&alloc), 1);
+    ASSERT_EQ(alloc.size, 256);
+
+    simple_memory_allocator_destroy(&alloc);
+    return 1;
+}
+
+// Test: marker edge cases
+TEST(marker_handles_null) {
+    SimpleMemoryMarker empty = simple_memory_allocator_get_marker(NULL);
+    ASSERT_NULL(empty.block);
+    ASSERT_EQ(simple_memory_allocator_free_to_marker(NULL, empty), -1);
+
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    ASSERT_EQ(simple_memory_allocator_free_to_marker(&alloc, simple_memory_allocator_get_marker(&alloc)), -1);
+    return 1;
+}
+
+// Test: inline fast path matches alloc() and falls back for growth
+TEST(alloc_fast_matches_alloc) {
+    SimpleMemoryAllocator fast, slow;
+    SimpleMemoryAllocatorOptions opts = {0};
+    opts.growable = 1;
+    opts.alignment = 32;
+    opts.backing = SIMPLE_MEMORY_BACKING_MMAP;  // Same base alignment for both arenas
+    simple_memory_allocator_init(&fast);
+    simple_memory_allocator_init(&slow);
+    simple_memory_allocator_create_with_options(&fast, 128, &opts);
+    simple_memory_allocator_create_with_options(&slow, 128, &opts);
+
+    size_t sizes[] = {1, 30, 7, 64, 200, 16};
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        uint8_t *a = simple_memory_allocator_alloc_fast(&fast, sizes[i]);
+        uint8_t *b = simple_memory_allocator_alloc(&slow, sizes[i]);
+        ASSERT_NOT_NULL(a);
+        ASSERT_EQ((uintptr_t)a % 32, 0);
+        ASSERT_EQ(a - (uint8_t *)fast.memory, b - (uint8_t *)slow.memory);
+        ASSERT_EQ(fast.used, slow.used);
+    }
+    ASSERT_EQ(simple_memory_allocator_block_count(&fast), simple_memory_allocator_block_count(&slow));
+
+    simple_memory_allocator_destroy(&fast);
+    simple_memory_allocator_destroy(&slow);
+    return 1;
+}
+
+// Test: fast path rejects what alloc() rejects
+TEST(alloc_fast_edge_cases) {
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    ASSERT_NULL(simple_memory_allocator_alloc_fast(&alloc, 8));   // Not created
+
+    simple_memory_allocator_create(&alloc, 64);
+    ASSERT_NULL(simple_memory_allocator_alloc_fast(&alloc, 0));
+    ASSERT_NULL(simple_memory_allocator_alloc_fast(&alloc, SIZE_MAX));
+    ASSERT_NULL(simple_memory_allocator_alloc_fast(&alloc, SIZE_MAX - 3));
+    ASSERT_NOT_NULL(simple_memory_allocator_alloc_fast(&alloc, 64));
+    ASSERT_NULL(simple_memory_allocator_alloc_fast(&alloc, 1));
+    ASSERT_EQ(alloc.used, 64);
+
+    simple_memory_allocator_destroy(&alloc);
+    return 1;
+}
+
+// Test: batch alloc lays objects out exactly like repeated alloc()
+TEST(alloc_batch_same_size) {
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    simple_memory_allocator_create(&alloc, 128);
+
+    void *out[4];
+    ASSERT_EQ(simple_memory_allocator_alloc_batch(&alloc, 12, 4, out), 4);
+    for (int i = 1; i < 4; i++) {
+        ASSERT_EQ((uint8_t *)out[i] - (uint8_t *)out[i - 1], 16);
+    }
+    ASSERT_EQ(alloc.used, 64);
+
+    // All or nothing: 5 more do not fit, nothing is taken
+    void *more[5];
+    ASSERT_EQ(simple_memory_allocator_alloc_batch(&alloc, 16, 5, more), 0);
+    ASSERT_EQ(alloc.used, 64);
+    ASSERT_EQ(simple_memory_allocator_alloc_batch(&alloc, 16, 4, more), 4);
+    ASSERT_EQ(alloc.used, 128);
+
+    simple_memory_allocator_destroy(&alloc);
+    return 1;
+}
+
+// Test: batch with per-object sizes keeps each start aligned
+TEST(alloc_batch_sizes) {
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    SimpleMemoryAllocatorOptions opts = {0};
+    opts.alignment = 32;
+    opts.growable = 1;
+    simple_memory_allocator_create_with_options(&alloc, 64, &opts);
+
+    size_t sizes[3] = {8, 40, 100};
+    void *out[3];
+    ASSERT_EQ(simple_memory_allocator_alloc_batch_sizes(&alloc, sizes, 3, out), 3);
+    for (int i = 0; i < 3; i++) {
+        ASSERT_EQ((uintptr_t)out[i] % 32, 0);
+    }
+    ASSERT_EQ((uint8_t *)out[2] - (uint8_t *)out[0], 96);
+    ASSERT_EQ(simple_memory_allocator_block_count(&alloc), 2);   // Grew once for the whole batch
+
+    size_t bad[2] = {8, 0};
+    ASSERT_EQ(simple_memory_allocator_alloc_batch_sizes(&alloc, bad, 2, out), 0);
+    ASSERT_EQ(simple_memory_allocator_alloc_batch(NULL, 8, 1, out), 0);
+    ASSERT_EQ(simple_memory_allocator_alloc_batch(&alloc, SIZE_MAX / 2, 4, out), 0);
+
+    simple_memory_allocator_destroy(&alloc);
+    return 1;
+}
+
+// Test: a batch ends where alloc() would, so its last object resizes in place
+TEST(alloc_batch_last_resizes_in_place) {
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    SimpleMemoryAllocatorOptions opts = {0};
+    opts.alignment = 16;
+    simple_memory_allocator_create_with_options(&alloc, 256, &opts);
+
+    void *out[3];
+    ASSERT_EQ(simple_memory_allocator_alloc_batch(&alloc, 24, 3, out), 3);
+    ASSERT_EQ((uint8_t *)out[2] - (uint8_t *)out[0], 64);
+    ASSERT_EQ(alloc.used, 88);
+
+    ASSERT_EQ(simple_memory_allocator_shrink_last(&alloc, out[2], 24, 8), 0);
+    ASSERT_EQ(alloc.used, 72);
+    ASSERT_EQ(simple_memory_allocator_realloc(&alloc, out[2], 8, 40), out[2]);
+    ASSERT_EQ(alloc.used, 104);
+
+    size_t sizes[2] = {24, 24};
+    void *more[2];
+    ASSERT_EQ(simple_memory_allocator_alloc_batch_sizes(&alloc, sizes, 2, more), 2);
+    ASSERT_EQ(alloc.used, 112 + 32 + 24);
+    ASSERT_EQ(simple_memory_allocator_realloc(&alloc, more[1], 24, 48), more[1]);
+    ASSERT_EQ(alloc.used, 112 + 32 + 48);
+
+    simple_memory_allocator_destroy(&alloc);
+    return 1;
+}
+
+// Test: the last allocation grows and shrinks in place
+TEST(realloc_last_in_place) {
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    simple_memory_allocator_create(&alloc, 256);
+
+    simple_memory_allocator_alloc(&alloc, 16);
+    char *buf = simple_memory_allocator_alloc(&alloc, 10);
+    memcpy(buf, "abcdefghij", 10);
+
+    ASSERT_EQ(simple_memory_allocator_realloc(&alloc, buf, 10, 100), buf);
+    ASSERT_EQ(alloc.used, 16 + 104);
+    ASSERT_EQ(memcmp(buf, "abcdefghij", 10), 0);
+
+    ASSERT_EQ(simple_memory_allocator_realloc(&alloc, buf, 100, 20), buf);
+    ASSERT_EQ(alloc.used, 16 + 24);
+
+    ASSERT_EQ(simple_memory_allocator_shrink_last(&alloc, buf, 20, 8), 0);
+    ASSERT_EQ(alloc.used, 16 + 8);
+
+    simple_memory_allocator_destroy(&alloc);
+    return 1;
+}
+
+// Test: buried allocations are copied on growth and left alone on shrink
+TEST(realloc_buried_copies) {
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    simple_memory_allocator_create(&alloc, 256);
+
+    char *first = simple_memory_allocator_alloc(&alloc, 8);
+    memcpy(first, "12345678", 8);
+    simple_memory_allocator_alloc(&alloc, 8);
+
+    char *moved = simple_memory_allocator_realloc(&alloc, first, 8, 32);
+    ASSERT_NOT_NULL(moved);
+    ASSERT_NE(moved, first);
+    ASSERT_EQ(memcmp(moved, "12345678", 8), 0);
+    ASSERT_EQ(alloc.used, 48);
+
+    ASSERT_EQ(simple_memory_allocator_realloc(&alloc, first, 8, 4), first);
+    ASSERT_EQ(alloc.used, 48);
+    ASSERT_EQ(simple_memory_allocator_shrink_last(&alloc, first, 8, 4), -1);
+
+    simple_memory_allocator_destroy(&alloc);
+    return 1;
+}
+
+// Test: growth past the block moves to a chained block, failure keeps ptr
+TEST(realloc_past_block) {
+    SimpleMemoryAllocator fixed;
+    simple_memory_allocator_init(&fixed);
+    simple_memory_allocator_create(&fixed, 64);
+    void *ptr = simple_memory_allocator_alloc(&fixed, 32);
+    ASSERT_NULL(simple_memory_allocator_realloc(&fixed, ptr, 32, 128));
+    ASSERT_EQ(fixed.used, 32);
+    simple_memory_allocator_destroy(&fixed);
+
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    SimpleMemoryAllocatorOptions opts = {0};
+    opts.growable = 1;
+    simple_memory_allocator_create_with_options(&alloc, 64, &opts);
+    char *buf = simple_memory_allocator_alloc(&alloc, 32);
+    memset(buf, 'x', 32);
+
+    char *moved = simple_memory_allocator_realloc(&alloc, buf, 32, 128);
+    ASSERT_NOT_NULL(moved);
+    ASSERT_EQ(moved[31], 'x');
+    ASSERT_EQ(simple_memory_allocator_block_count(&alloc), 2);
+
+    simple_memory_allocator_destroy(&alloc);
+    return 1;
+}
+
+// Test: realloc/shrink edge cases
+TEST(realloc_handles_edge_cases) {
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    simple_memory_allocator_create(&alloc, 64);
+
+    void *ptr = simple_memory_allocator_realloc(&alloc, NULL, 0, 16);
+    ASSERT_NOT_NULL(ptr);
+    ASSERT_EQ(alloc.used, 16);
+    ASSERT_NULL(simple_memory_allocator_realloc(&alloc, ptr, 16, 0));
+    ASSERT_NULL(simple_memory_allocator_realloc(NULL, ptr, 16, 32));
+    ASSERT_EQ(simple_memory_allocator_shrink_last(&alloc, ptr, 16, 32), -1);
+    ASSERT_EQ(simple_memory_allocator_shrink_last(NULL, ptr, 16, 8), -1);
+
+    simple_memory_allocator_destroy(&alloc);
+    return 1;
+}
+
+// Check that every byte of buf is zero
+static int all_zero(const uint8_t *buf, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        if (buf[i] != 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Test: calloc clears memory a reset, rewind or shrink handed back
+TEST(calloc_zeroes_recycled_memory) {
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    simple_memory_allocator_create(&alloc, 4 * 1024 * 1024);
+
+    // malloc backing holds garbage from the start
+    memset(alloc.memory, 0xAB, alloc.size);
+    uint8_t *buf = simple_memory_allocator_calloc(&alloc, 10, 13);
+    ASSERT_NOT_NULL(buf);
+    ASSERT(all_zero(buf, 130));
+
+    // Shrinking leaves written bytes past the bump pointer
+    uint8_t *last = simple_memory_allocator_alloc(&alloc, 256);
+    memset(last, 0xCD, 256);
+    ASSERT_EQ(simple_memory_allocator_shrink_last(&alloc, last, 256, 8), 0);
+    buf = simple_memory_allocator_calloc(&alloc, 1, 200);
+    ASSERT(all_zero(buf, 200));
+
+    // So does a rewind
+    SimpleMemoryMarker marker = simple_memory_allocator_get_marker(&alloc);
+    memset(simple_memory_allocator_alloc(&alloc, 512), 0xEF, 512);
+    simple_memory_allocator_free_to_marker(&alloc, marker);
+    ASSERT(all_zero(simple_memory_allocator_calloc(&alloc, 64, 8), 512));
+
+    // Large recycled regions take the streaming path
+    simple_memory_allocator_reset(&alloc);
+    memset(simple_memory_allocator_alloc(&alloc, alloc.size), 0x5A, alloc.size);
+    simple_memory_allocator_reset(&alloc);
+    ASSERT_NOT_NULL(simple_memory_allocator_alloc(&alloc, 8));  // Misalign the start
+    size_t big = 2 * 1024 * 1024 + 13;
+    buf = simple_memory_allocator_calloc(&alloc, 1, big);
+    ASSERT(all_zero(buf, big));
+
+    simple_memory_allocator_destroy(&alloc);
+    return 1;
+}
+
+// Test: fresh mmap pages are handed out without being touched
+TEST(calloc_skips_fresh_pages) {
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    SimpleMemoryAllocatorOptions opts = {0};
+    opts.backing = SIMPLE_MEMORY_BACKING_MMAP;
+    opts.growable = 1;
+    simple_memory_allocator_create_with_options(&alloc, 1024 * 1024, &opts);
+
+    uint8_t *buf = simple_memory_allocator_calloc(&alloc, 1, 512 * 1024);
+    ASSERT_NOT_NULL(buf);
+    ASSERT(resident_pages(&alloc) <= 1);  // Only the page holding the block header
+    ASSERT(all_zero(buf, 512 * 1024));
+
+    // After a reset only the recycled prefix is cleared again
+    memset(buf, 0x11, 512 * 1024);
+    simple_memory_allocator_reset(&alloc);
+    buf = simple_memory_allocator_calloc(&alloc, 1, alloc.size);
+    ASSERT(all_zero(buf, alloc.size));
+
+    // A chained block starts clean too
+    buf = simple_memory_allocator_calloc(&alloc, 4, 64 * 1024);
+    ASSERT_NOT_NULL(buf);
+    ASSERT_EQ(simple_memory_allocator_block_count(&alloc), 2);
+    ASSERT(all_zero(buf, 256 * 1024));
+
+    simple_memory_allocator_destroy(&alloc);
+    return 1;
+}
+
+// Test: calloc rejects overflow and bad arguments
+TEST(calloc_handles_edge_cases) {
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    ASSERT_NULL(simple_memory_allocator_calloc(&alloc, 1, 8));
+    simple_memory_allocator_create(&alloc, 64);
+
+    ASSERT_NULL(simple_memory_allocator_calloc(&alloc, SIZE_MAX / 2, 3));
+    ASSERT_NULL(simple_memory_allocator_calloc(&alloc, 0, 8));
+    ASSERT_NULL(simple_memory_allocator_calloc(&alloc, 8, 0));
+    ASSERT_NULL(simple_memory_allocator_calloc(&alloc, 9, 8));
+    ASSERT_NULL(simple_memory_allocator_calloc(NULL, 1, 8));
+    ASSERT_EQ(alloc.used, 0);
+
+    simple_memory_allocator_destroy(&alloc);
+    return 1;
+}
+
+#ifdef SIMPLE_MEMORY_ALLOCATOR_STATS
+// Test: counters track calls, padding, buckets and the high-water mark
+TEST(stats_track_allocations) {
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    simple_memory_allocator_create(&alloc, 256);
+
+    simple_memory_allocator_alloc(&alloc, 10);               // 16 consumed, 6 padding
+    simple_memory_allocator_alloc_aligned(&alloc, 64, 64);   // Gap up to the 64 boundary
+    ASSERT_NULL(simple_memory_allocator_alloc(&alloc, 512));
+
+    SimpleMemoryAllocatorStats stats;
+    ASSERT_EQ(simple_memory_allocator_get_stats(&alloc, &stats), 0);
+    ASSERT_EQ(stats.alloc_calls, 3);
+    ASSERT_EQ(stats.failed_allocs, 1);
+    ASSERT_EQ(stats.bytes_requested, 74);
+    ASSERT_EQ(stats.current_bytes, alloc.used);
+    ASSERT_EQ(stats.padding_bytes, alloc.used - 74);
+    ASSERT_EQ(stats.bucket_allocs[0], 1);
+    ASSERT_EQ(stats.bucket_allocs[1], 1);
+    ASSERT_EQ(stats.bucket_bytes[1], 64);
+
+    size_t peak = alloc.used;
+    simple_memory_allocator_reset(&alloc);
+    simple_memory_allocator_alloc(&alloc, 8);
+    simple_memory_allocator_get_stats(&alloc, &stats);
+    ASSERT_EQ(stats.resets, 1);
+    ASSERT_EQ(stats.current_bytes, 8);
+    ASSERT_EQ(stats.high_water, peak);
+
+    simple_memory_allocator_destroy(&alloc);
+    return 1;
+}
+
+// Test: growth is counted and reset_stats keeps the live footprint
+TEST(stats_grow_and_clear) {
+    SimpleMemoryAllocator alloc;
+    simple_memory_allocator_init(&alloc);
+    SimpleMemoryAllocatorOptions opts = {0};
+    opts.growable = 1;
+    simple_memory_allocator_create_with_options(&alloc, 64, &opts);
+
+    for (int i = 0; i < 4; i++) {
+        ASSERT_NOT_NULL(simple_memory_allocator_alloc(&alloc, 32));
+    }
+
+    SimpleMemoryAllocatorStats stats;
+    simple_memory_allocator_get_stats(&alloc, &stats);
+    ASSERT_EQ(stats.blocks_chained, 1);
+    ASSERT_EQ(stats.current_bytes, 128);
+
+    simple_memory_allocator_reset_stats(&alloc);
+    simple_memory_allocator_get_stats(&alloc, &stats);
+    ASSERT_EQ(stats.alloc_calls, 0);
+    ASSERT_EQ(stats.current_bytes, 128);
+    ASSERT_EQ(stats.high_water, 128);
+
+    simple_memory_allocator_destroy(&alloc);
+    return 1;
+}
+#endif
+
+// Test: JSON snapshot is well-formed and reports truncation like snprintf
+TEST(stats_json_snapshot) {
+    SimpleMemoryAllocatorStats stats;
+    memset(&stats, 0, sizeof(stats));
+    stats.alloc_calls = 7;
+    stats.bucket_allocs[2] = 3;
+
+    char buf[512];
+    int length = simple_memory_allocator_stats_json(&stats, buf, sizeof(buf));
+    ASSERT(length > 0 && (size_t)length < sizeof(buf));
+    ASSERT_EQ(buf[0], '{');
+    ASSERT_EQ(buf[length - 1], '}');
+    ASSERT_NOT_NULL(strstr(buf, "\"alloc_calls\":7"));
+    ASSERT_NOT_NULL(strstr(buf, "\"bucket_allocs\":[0,0,3,0,0,0,0,0]"));
+
+    char small[8];
+    ASSERT_EQ(simple_memory_allocator_stats_json(&stats, small, sizeof(small)), length);
+    ASSERT_EQ(simple_memory_allocator_stats_json(NULL, buf, sizeof(buf)), -1);
+    return 1;
+}
+
 int main(void) {
     printf("\n");
     printf("╔════════════════════════════════════════════════════╗\n");
@@ -362,14 +1359,70 @@ int main(void) {
     RUN_TEST(exact_pool_size_alloc);
     RUN_TEST(alloc_over_pool_size_fails);
 
-    printf("\n────────────────────────────────────────────────────\n");
-    printf("Results: %d/%d tests passed", tests_passed, tests_run);
-    if (tests_passed == tests_run) {
-        printf(" - ALL TESTS PASSED!\n");
-    } else {
-        printf(" - %d FAILED\n", tests_run - tests_passed);
-    }
-    printf("────────────────────────────────────────────────────\n\n");
-
-    return tests_passed == tests_run ? 0 : 1;
+    printf("\n▸ Alignment Tests\n");
+    RUN_TEST(alloc_aligned_power_of_two);
+    RUN_TEST(alloc_aligned_rejects_bad_alignment);
+    RUN_TEST(alloc_aligned_small_alignment);
+    RUN_TEST(default_alignment_option);
+    RUN_TEST(create_fails_bad_alignment);
+    RUN_TEST(alloc_aligned_padding_exhausts);
+
+    printf("\n▸ Growable Tests\n");
+    RUN_TEST(growable_chains_block);
+    RUN_TEST(growable_respects_cap);
+    RUN_TEST(growable_oversize_request);
+    RUN_TEST(growable_reset_keeps_largest);
+    RUN_TEST(fixed_does_not_grow);
+    RUN_TEST(growable_aligned_alloc);
+
+    printf("\n▸ Backing Tests\n");
+    RUN_TEST(mmap_backing_creates_pool);
+    RUN_TEST(mmap_backing_huge_pages_populate);
+    RUN_TEST(mmap_backing_numa_bind);
+    RUN_TEST(mmap_backing_growable);
+    RUN_TEST(create_fails_bad_backing);
+
+    printf("\n▸ Child Arena Tests\n");
+    RUN_TEST(child_arena_borrows_from_parent);
+    RUN_TEST(child_arena_in_pool);
+    RUN_TEST(child_arena_bad_parent);
+
+    printf("\n▸ Decommit Tests\n");
+    RUN_TEST(reset_decommit_releases_cold_tail);
+    RUN_TEST(reset_decommit_policy_options);
+
+    printf("\n▸ Marker Tests\n");
+    RUN_TEST(marker_rewinds_current_block);
+    RUN_TEST(markers_nest);
+    RUN_TEST(marker_across_chained_blocks);
+    RUN_TEST(marker_handles_null);
+
+    printf("\n▸ Fast Path Tests\n");
+    RUN_TEST(alloc_fast_matches_alloc);
+    RUN_TEST(alloc_fast_edge_cases);
+
+    printf("\n▸ Batch Tests\n");
+    RUN_TEST(alloc_batch_same_size);
+    RUN_TEST(alloc_batch_sizes);
+    RUN_TEST(alloc_batch_last_resizes_in_place);
+
+    printf("\n▸ Realloc Tests\n");
+    RUN_TEST(realloc_last_in_place);
+    RUN_TEST(realloc_buried_copies);
+    RUN_TEST(realloc_past_block);
+    RUN_TEST(realloc_handles_edge_cases);
+
+    printf("\n▸ Calloc Tests\n");
+    RUN_TEST(calloc_zeroes_recycled_memory);
+    RUN_TEST(calloc_skips_fresh_pages);
+    RUN_TEST(calloc_handles_edge_cases);
+
+    printf("\n▸ Statistics Tests\n");
+#ifdef SIMPLE_MEMORY_ALLOCATOR_STATS
+    RUN_TEST(stats_track_allocations);
+    RUN_TEST(stats_grow_and_clear);
+#endif
+    RUN_TEST(stats_json_snapshot);
+
+    return test_summary();
 }
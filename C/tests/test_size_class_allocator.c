@@ -0,0 +1,144 @@
+/*
+ * Test suite for size_class_allocator
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include "../src/size_class_allocator.h"
+#include "test_framework.h"
+
+// Test: create sets up one pool per class
+TEST(create_sets_up_classes) {
+    SizeClassAllocator a;
+    size_class_allocator_init(&a);
+
+    ASSERT_EQ(size_class_allocator_create(&a, 3000, 64 * 1024), 0);
+    ASSERT_EQ(a.class_shift, 12);  // 3000 rounded up to 4096
+    for (size_t i = 0; i < SIZE_CLASS_COUNT; i++) {
+        ASSERT_EQ(a.classes[i].block_size, (size_t)SIZE_CLASS_MIN_SIZE << i);
+        ASSERT_EQ(a.classes[i].block_count, 4096 / a.classes[i].block_size);
+    }
+
+    size_class_allocator_destroy(&a);
+    ASSERT_NULL(a.small_memory);
+    return 1;
+}
+
+// Test: create rejects regions too small for the largest class
+TEST(create_fails_bad_args) {
+    SizeClassAllocator a;
+
+    ASSERT_EQ(size_class_allocator_create(NULL, 4096, 4096), -1);
+    ASSERT_EQ(size_class_allocator_create(&a, 1024, 4096), -1);
+    ASSERT_EQ(size_class_allocator_create(&a, 4096, 0), -1);
+    return 1;
+}
+
+// Test: small sizes land in the matching class pool
+TEST(small_alloc_uses_class) {
+    SizeClassAllocator a;
+    size_class_allocator_create(&a, 4096, 64 * 1024);
+
+    size_t sizes[] = {1, 8, 9, 16, 100, 128, 129, 2048};
+    size_t classes[] = {0, 0, 1, 1, 4, 4, 5, 8};
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        void *ptr = size_class_allocator_alloc(&a, sizes[i]);
+        ASSERT(pool_allocator_owns(&a.classes[classes[i]], ptr));
+    }
+
+    size_class_allocator_destroy(&a);
+    return 1;
+}
+
+// Test: large sizes go to the free-list backend
+TEST(large_alloc_uses_backend) {
+    SizeClassAllocator a;
+    size_class_allocator_create(&a, 4096, 64 * 1024);
+
+    void *ptr = size_class_allocator_alloc(&a, 5000);
+    ASSERT_NOT_NULL(ptr);
+    ASSERT(freelist_owns(&a.large, ptr));
+
+    size_class_allocator_free(&a, ptr);
+    ASSERT_EQ(freelist_used(&a.large), 0);
+
+    size_class_allocator_destroy(&a);
+    return 1;
+}
+
+// Test: an exhausted class overflows into the backend
+TEST(exhausted_class_falls_back) {
+    SizeClassAllocator a;
+    size_class_allocator_create(&a, 4096, 64 * 1024);
+
+    // The 2048 class holds two blocks
+    void *ptr1 = size_class_allocator_alloc(&a, 2048);
+    void *ptr2 = size_class_allocator_alloc(&a, 2048);
+    void *ptr3 = size_class_allocator_alloc(&a, 2048);
+
+    ASSERT(pool_allocator_owns(&a.classes[8], ptr1));
+    ASSERT(pool_allocator_owns(&a.classes[8], ptr2));
+    ASSERT(freelist_owns(&a.large, ptr3));
+
+    size_class_allocator_destroy(&a);
+    return 1;
+}
+
+// Test: free routes pointers back to the right owner
+TEST(free_routes_to_owner) {
+    SizeClassAllocator a;
+    size_class_allocator_create(&a, 4096, 64 * 1024);
+
+    void *small = size_class_allocator_alloc(&a, 24);
+    void *large = size_class_allocator_alloc(&a, 3000);
+    memset(small, 0xAA, 24);
+    memset(large, 0xBB, 3000);
+
+    size_class_allocator_free(&a, small);
+    size_class_allocator_free(&a, large);
+
+    ASSERT_EQ(pool_allocator_used(&a.classes[2]), 0);
+    ASSERT_EQ(freelist_used(&a.large), 0);
+    ASSERT_EQ(size_class_allocator_alloc(&a, 30), small);  // LIFO reuse
+
+    size_class_allocator_destroy(&a);
+    return 1;
+}
+
+// Test: zero-size and NULL arguments are handled
+TEST(handles_edge_cases) {
+    SizeClassAllocator a;
+    size_class_allocator_init(&a);
+
+    ASSERT_NULL(size_class_allocator_alloc(&a, 16));  // Not created
+    size_class_allocator_create(&a, 4096, 4096);
+    ASSERT_NULL(size_class_allocator_alloc(&a, 0));
+    size_class_allocator_free(&a, NULL);
+    size_class_allocator_free(NULL, NULL);
+
+    size_class_allocator_destroy(&a);
+    return 1;
+}
+
+int main(void) {
+    printf("\n");
+    printf("╔════════════════════════════════════════════════════╗\n");
+    printf("║     Size Class Allocator Test Suite                ║\n");
+    printf("╚════════════════════════════════════════════════════╝\n\n");
+
+    printf("▸ Creation Tests\n");
+    RUN_TEST(create_sets_up_classes);
+    RUN_TEST(create_fails_bad_args);
+
+    printf("\n▸ Allocation Tests\n");
+    RUN_TEST(small_alloc_uses_class);
+    RUN_TEST(large_alloc_uses_backend);
+    RUN_TEST(exhausted_class_falls_back);
+
+    printf("\n▸ Free Tests\n");
+    RUN_TEST(free_routes_to_owner);
+    RUN_TEST(handles_edge_cases);
+
+    return test_summary();
+}
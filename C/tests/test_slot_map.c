@@ -0,0 +1,213 @@
+/*
+ * Test suite for slot_map
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "../src/slot_map.h"
+#include "test_framework.h"
+
+typedef struct {
+    float x;
+    float y;
+    int id;
+} Entity;
+
+static int destroyed;
+
+static void count_destroy(void *object) {
+    (void)object;
+    destroyed++;
+}
+
+static Entity make_entity(int id) {
+    Entity e = {(float)id, (float)-id, id};
+    return e;
+}
+
+// Test: create rejects bad arguments and touches no storage
+TEST(create_validates_args) {
+    SlotMap map;
+    slot_map_init(&map);
+
+    ASSERT_EQ(slot_map_create(&map, 0, 16, NULL), -1);
+    ASSERT_EQ(slot_map_create(&map, sizeof(Entity), 0, NULL), -1);
+    ASSERT_EQ(slot_map_create(&map, sizeof(Entity), SLOT_MAP_MAX_CAPACITY + 1, NULL), -1);
+
+    ASSERT_EQ(slot_map_create(&map, sizeof(Entity), 100, NULL), 0);
+    ASSERT_EQ(slot_map_count(&map), 0);
+    ASSERT_EQ(map.next_unused, 0);
+    ASSERT_NULL(slot_map_data(&map));
+    ASSERT_EQ(slot_map_stride(&map), 16);
+
+    slot_map_destroy(&map);
+    ASSERT_NULL(map.slots);
+    return 1;
+}
+
+// Test: handles resolve to the inserted objects and are never null
+TEST(insert_and_get) {
+    SlotMap map;
+    slot_map_init(&map);
+    slot_map_create(&map, sizeof(Entity), 8, NULL);
+
+    SlotMapHandle handles[8];
+    for (int i = 0; i < 8; i++) {
+        Entity e = make_entity(i);
+        handles[i] = slot_map_insert(&map, &e);
+        ASSERT_NE(handles[i], SLOT_MAP_NULL_HANDLE);
+    }
+    Entity extra = make_entity(99);
+    ASSERT_EQ(slot_map_insert(&map, &extra), SLOT_MAP_NULL_HANDLE);
+
+    for (int i = 0; i < 8; i++) {
+        Entity *e = slot_map_get(&map, handles[i]);
+        ASSERT_NOT_NULL(e);
+        ASSERT_EQ(e->id, i);
+    }
+    ASSERT_NULL(slot_map_get(&map, SLOT_MAP_NULL_HANDLE));
+    ASSERT_EQ(sizeof(SlotMapHandle), 4);
+
+    slot_map_destroy(&map);
+    return 1;
+}
+
+// Test: removed handles go stale even after their slot is reused
+TEST(stale_handles_detected) {
+    SlotMap map;
+    slot_map_init(&map);
+    slot_map_create(&map, sizeof(Entity), 4, count_destroy);
+    destroyed = 0;
+
+    Entity e = make_entity(1);
+    SlotMapHandle old = slot_map_insert(&map, &e);
+    ASSERT_EQ(slot_map_remove(&map, old), 0);
+    ASSERT_EQ(destroyed, 1);
+    ASSERT(!slot_map_contains(&map, old));
+    ASSERT_EQ(slot_map_remove(&map, old), -1);
+
+    e = make_entity(2);
+    SlotMapHandle reused = slot_map_insert(&map, &e);
+    ASSERT_EQ(reused & (SLOT_MAP_MAX_CAPACITY - 1), old & (SLOT_MAP_MAX_CAPACITY - 1));
+    ASSERT_NE(reused, old);
+    ASSERT_NULL(slot_map_get(&map, old));
+    ASSERT_EQ(((Entity *)slot_map_get(&map, reused))->id, 2);
+
+    // Out-of-range index is rejected too
+    ASSERT_NULL(slot_map_get(&map, (SlotMapHandle)(1u << SLOT_MAP_INDEX_BITS) | 3u));
+
+    slot_map_destroy(&map);
+    ASSERT_EQ(destroyed, 2);
+    return 1;
+}
+
+// Test: removal keeps live objects packed and handles stay valid
+TEST(remove_keeps_storage_packed) {
+    SlotMap map;
+    slot_map_init(&map);
+    slot_map_create(&map, sizeof(Entity), 16, NULL);
+
+    SlotMapHandle handles[10];
+    for (int i = 0; i < 10; i++) {
+        Entity e = make_entity(i);
+        handles[i] = slot_map_insert(&map, &e);
+    }
+    for (int i = 0; i < 10; i += 3) {
+        ASSERT_EQ(slot_map_remove(&map, handles[i]), 0);
+    }
+    ASSERT_EQ(slot_map_count(&map), 6);
+
+    // Dense scan sees exactly the live ids
+    int seen = 0;
+    unsigned char *data = slot_map_data(&map);
+    for (size_t i = 0; i < slot_map_count(&map); i++) {
+        Entity *e = (Entity *)(data + i * slot_map_stride(&map));
+        ASSERT(e->id % 3 != 0);
+        ASSERT_EQ(slot_map_get(&map, slot_map_handle_at(&map, i)), e);
+        seen |= 1 << e->id;
+    }
+    ASSERT_EQ(seen, 0x1B6);
+
+    for (int i = 0; i < 10; i++) {
+        Entity *e = slot_map_get(&map, handles[i]);
+        if (i % 3 == 0) {
+            ASSERT_NULL(e);
+        } else {
+            ASSERT_NOT_NULL(e);
+            ASSERT_EQ(e->id, i);
+        }
+    }
+
+    // New objects land right after the packed range
+    SlotMapHandle handle;
+    void *slot = slot_map_emplace(&map, &handle);
+    ASSERT_EQ(slot, data + 6 * slot_map_stride(&map));
+    ASSERT_EQ(slot_map_handle_at(&map, 6), handle);
+
+    slot_map_destroy(&map);
+    return 1;
+}
+
+// Test: clear destroys everything and invalidates all handles
+TEST(clear_invalidates_all) {
+    SlotMap map;
+    slot_map_init(&map);
+    slot_map_create(&map, sizeof(Entity), 8, count_destroy);
+    destroyed = 0;
+
+    SlotMapHandle handles[5];
+    for (int i = 0; i < 5; i++) {
+        Entity e = make_entity(i);
+        handles[i] = slot_map_insert(&map, &e);
+    }
+    slot_map_clear(&map);
+    ASSERT_EQ(destroyed, 5);
+    ASSERT_EQ(slot_map_count(&map), 0);
+    for (int i = 0; i < 5; i++) {
+        ASSERT(!slot_map_contains(&map, handles[i]));
+    }
+
+    // Full capacity is available again
+    for (int i = 0; i < 8; i++) {
+        Entity e = make_entity(i);
+        ASSERT_NE(slot_map_insert(&map, &e), SLOT_MAP_NULL_HANDLE);
+    }
+
+    slot_map_destroy(&map);
+    ASSERT_EQ(destroyed, 13);
+    return 1;
+}
+
+// Test: NULL map is handled safely
+TEST(handles_null) {
+    SlotMapHandle handle;
+    ASSERT_NULL(slot_map_emplace(NULL, &handle));
+    ASSERT_NULL(slot_map_get(NULL, 1));
+    ASSERT_EQ(slot_map_remove(NULL, 1), -1);
+    ASSERT_EQ(slot_map_count(NULL), 0);
+    slot_map_clear(NULL);
+    slot_map_destroy(NULL);
+    return 1;
+}
+
+int main(void) {
+    printf("\n");
+    printf("╔════════════════════════════════════════════════════╗\n");
+    printf("║     Slot Map Test Suite                            ║\n");
+    printf("╚════════════════════════════════════════════════════╝\n\n");
+
+    printf("▸ Creation Tests\n");
+    RUN_TEST(create_validates_args);
+
+    printf("\n▸ Handle Tests\n");
+    RUN_TEST(insert_and_get);
+    RUN_TEST(stale_handles_detected);
+
+    printf("\n▸ Storage Tests\n");
+    RUN_TEST(remove_keeps_storage_packed);
+    RUN_TEST(clear_invalidates_all);
+    RUN_TEST(handles_null);
+
+    return test_summary();
+}
@@ -0,0 +1,179 @@
+/*
+ * Test suite for thread_cache_allocator
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "../src/thread_cache_allocator.h"
+#include "test_framework.h"
+
+#define THREAD_COUNT      8
+#define ALLOCS_PER_THREAD 4000
+
+// Test: first alloc grabs a chunk, later ones bump inside it
+TEST(alloc_bumps_inside_chunk) {
+    ConcurrentMemoryAllocator shared;
+    concurrent_memory_allocator_create(&shared, 64 * 1024);
+    ThreadCacheAllocator cache;
+    thread_cache_allocator_init(&cache, &shared, 1024);
+
+    uint8_t *ptr1 = thread_cache_allocator_alloc(&cache, 100);
+    uint8_t *ptr2 = thread_cache_allocator_alloc(&cache, 8);
+
+    ASSERT_NOT_NULL(ptr1);
+    ASSERT_EQ(ptr2, ptr1 + 104);
+    ASSERT_EQ(concurrent_memory_allocator_used(&shared), 1024);
+    ASSERT_EQ(thread_cache_allocator_remaining(&cache), 1024 - 112);
+
+    concurrent_memory_allocator_destroy(&shared);
+    return 1;
+}
+
+// Test: exhausting a chunk refills from the shared arena
+TEST(alloc_refills_chunk) {
+    ConcurrentMemoryAllocator shared;
+    concurrent_memory_allocator_create(&shared, 64 * 1024);
+    ThreadCacheAllocator cache;
+    thread_cache_allocator_init(&cache, &shared, 256);
+
+    for (int i = 0; i < 4; i++) {
+        ASSERT_NOT_NULL(thread_cache_allocator_alloc(&cache, 64));
+    }
+    ASSERT_EQ(concurrent_memory_allocator_used(&shared), 256);
+
+    ASSERT_NOT_NULL(thread_cache_allocator_alloc(&cache, 64));
+    ASSERT_EQ(concurrent_memory_allocator_used(&shared), 512);
+
+    concurrent_memory_allocator_destroy(&shared);
+    return 1;
+}
+
+// Test: large requests bypass the chunk
+TEST(large_alloc_bypasses_cache) {
+    ConcurrentMemoryAllocator shared;
+    concurrent_memory_allocator_create(&shared, 64 * 1024);
+    ThreadCacheAllocator cache;
+    thread_cache_allocator_init(&cache, &shared, 1024);
+
+    ASSERT_NOT_NULL(thread_cache_allocator_alloc(&cache, 8));
+    size_t remaining = thread_cache_allocator_remaining(&cache);
+
+    ASSERT_NOT_NULL(thread_cache_allocator_alloc(&cache, 4096));
+    ASSERT_EQ(thread_cache_allocator_remaining(&cache), remaining);
+    ASSERT_EQ(concurrent_memory_allocator_used(&shared), 1024 + 4096);
+
+    concurrent_memory_allocator_destroy(&shared);
+    return 1;
+}
+
+// Test: tail of the shared arena is still usable once a full chunk no longer fits
+TEST(alloc_uses_arena_tail) {
+    ConcurrentMemoryAllocator shared;
+    concurrent_memory_allocator_create(&shared, 1536);
+    ThreadCacheAllocator cache;
+    thread_cache_allocator_init(&cache, &shared, 1024);
+
+    ASSERT_NOT_NULL(thread_cache_allocator_alloc(&cache, 512));
+    ASSERT_NOT_NULL(thread_cache_allocator_alloc(&cache, 512));
+    ASSERT_NOT_NULL(thread_cache_allocator_alloc(&cache, 256));
+    ASSERT_NULL(thread_cache_allocator_alloc(&cache, 0));
+
+    concurrent_memory_allocator_destroy(&shared);
+    return 1;
+}
+
+// Test: reset drops the chunk so a reset arena is not reused stale
+TEST(reset_drops_chunk) {
+    ConcurrentMemoryAllocator shared;
+    concurrent_memory_allocator_create(&shared, 64 * 1024);
+    ThreadCacheAllocator cache;
+    thread_cache_allocator_init(&cache, &shared, 1024);
+
+    uint8_t *ptr1 = thread_cache_allocator_alloc(&cache, 8);
+    concurrent_memory_allocator_reset(&shared);
+    thread_cache_allocator_reset(&cache);
+    ASSERT_EQ(thread_cache_allocator_remaining(&cache), 0);
+
+    uint8_t *ptr2 = thread_cache_allocator_alloc(&cache, 8);
+    ASSERT_EQ(ptr1, ptr2);
+    ASSERT_EQ(concurrent_memory_allocator_used(&shared), 1024);
+
+    concurrent_memory_allocator_destroy(&shared);
+    return 1;
+}
+
+typedef struct {
+    ConcurrentMemoryAllocator *shared;
+    uintptr_t *ptrs;
+} ThreadArgs;
+
+static void *cache_thread(void *arg) {
+    ThreadArgs *args = arg;
+    ThreadCacheAllocator cache;
+    thread_cache_allocator_init(&cache, args->shared, 0);
+    for (size_t i = 0; i < ALLOCS_PER_THREAD; i++) {
+        args->ptrs[i] = (uintptr_t)thread_cache_allocator_alloc(&cache, 40);
+    }
+    return NULL;
+}
+
+static int compare_uintptr(const void *a, const void *b) {
+    uintptr_t x = *(const uintptr_t *)a;
+    uintptr_t y = *(const uintptr_t *)b;
+    return (x > y) - (x < y);
+}
+
+// Test: caches on different threads never hand out overlapping memory
+TEST(threads_never_overlap) {
+    ConcurrentMemoryAllocator shared;
+    ASSERT_EQ(concurrent_memory_allocator_create(&shared, 4 * 1024 * 1024), 0);
+
+    size_t total = (size_t)THREAD_COUNT * ALLOCS_PER_THREAD;
+    uintptr_t *ptrs = calloc(total, sizeof(uintptr_t));
+    pthread_t threads[THREAD_COUNT];
+    ThreadArgs args[THREAD_COUNT];
+
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        args[t].shared = &shared;
+        args[t].ptrs = ptrs + (size_t)t * ALLOCS_PER_THREAD;
+        pthread_create(&threads[t], NULL, cache_thread, &args[t]);
+    }
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    qsort(ptrs, total, sizeof(uintptr_t), compare_uintptr);
+
+    int ok = 1;
+    for (size_t i = 0; i < total && ok; i++) {
+        ok = ptrs[i] != 0 && (i == 0 || ptrs[i] >= ptrs[i - 1] + 40);
+    }
+
+    free(ptrs);
+    concurrent_memory_allocator_destroy(&shared);
+    ASSERT(ok);
+    return 1;
+}
+
+int main(void) {
+    printf("\n");
+    printf("╔════════════════════════════════════════════════════╗\n");
+    printf("║     Thread Cache Allocator Test Suite              ║\n");
+    printf("╚════════════════════════════════════════════════════╝\n\n");
+
+    printf("▸ Allocation Tests\n");
+    RUN_TEST(alloc_bumps_inside_chunk);
+    RUN_TEST(alloc_refills_chunk);
+    RUN_TEST(large_alloc_bypasses_cache);
+    RUN_TEST(alloc_uses_arena_tail);
+
+    printf("\n▸ Reset Tests\n");
+    RUN_TEST(reset_drops_chunk);
+
+    printf("\n▸ Threading Tests\n");
+    RUN_TEST(threads_never_overlap);
+
+    return test_summary();
+}